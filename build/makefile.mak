@@ -188,7 +188,8 @@ SOURCEFILES += \
   NeQuickG_JRC_exception \
   NeQuickG_JRC_input_data_std_stream \
   NeQuickG_JRC_input_data_stream \
-  NeQuickG_JRC_main
+  NeQuickG_JRC_main \
+  NeQuickG_JRC_thread_stress
 
 # create objects list by adding OBJ_FOLDER and the suffix TYPE.OBJ
 # to each source in the list SOURCEFILES
@@ -200,8 +201,8 @@ OBJS = $(addprefix $(OBJ_FOLDER),$(addsuffix .$(.TYPE.OBJ),$(SOURCEFILES)))
 # result DEPENDENCIES = <object_path>/source_1.d, <object_path>/source_2.d, ..., <object_path>/source_n.d
 DEPENDENCIES = $(addprefix $(OBJ_FOLDER),$(addsuffix .$(.TYPE.DEPENDENCIES),$(SOURCEFILES)))
 
-#libraries: the math lib
-LIBS = -lm
+#libraries: the math lib and POSIX threads (thread stress test)
+LIBS = -lm -lpthread
 
 # tells makefile where to find sources, headers and objects
 vpath %.$(.TYPE.C) $(C_SEARCH_PATH)
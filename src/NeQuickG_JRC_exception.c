@@ -13,10 +13,10 @@
 
 #include <stdlib.h>
 
-int16_t g_NeQuick_exception_type;
-int16_t g_NeQuick_exception_reason;
-bool g_NeQuick_exception_last_exception_caught;
-NeQuick_exception_jumpBuffer_t *g_NeQuick_exception_pJumpBuffer;
+NEQUICK_G_THREAD_LOCAL int16_t g_NeQuick_exception_type;
+NEQUICK_G_THREAD_LOCAL int16_t g_NeQuick_exception_reason;
+NEQUICK_G_THREAD_LOCAL bool g_NeQuick_exception_last_exception_caught;
+NEQUICK_G_THREAD_LOCAL NeQuick_exception_jumpBuffer_t *g_NeQuick_exception_pJumpBuffer;
 
 void NeQuick_exception_throw(
   int16_t exceptionType, int16_t exceptionReason) {
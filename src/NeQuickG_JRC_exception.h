@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_macros.h"
 #define NEQUICK_USAGE_EXCEPTION (-7)
 #define NEQUICK_FATAL_EXCEPTION (-8)
 
@@ -33,17 +34,20 @@ typedef struct exceptionJumpBuffer_s {
   struct exceptionJumpBuffer_s *pPrev;
 } NeQuick_exception_jumpBuffer_t;
 
+// the exception state is thread-local:
+// a thread can only catch the exceptions it throws
+
 /** Exception type for last exception, set in #NeQuick_exception_throw. */
-extern int16_t g_NeQuick_exception_type;
+extern NEQUICK_G_THREAD_LOCAL int16_t g_NeQuick_exception_type;
 
 /** Exception reason for last exception, set in #NeQuick_exception_throw. */
-extern int16_t g_NeQuick_exception_reason;
+extern NEQUICK_G_THREAD_LOCAL int16_t g_NeQuick_exception_reason;
 
 /** true if the last exception was caught, false otherwise */
-extern bool g_NeQuick_exception_last_exception_caught;
+extern NEQUICK_G_THREAD_LOCAL bool g_NeQuick_exception_last_exception_caught;
 
 /** Set to NULL if no exception handler is active. */
-extern NeQuick_exception_jumpBuffer_t *g_NeQuick_exception_pJumpBuffer;
+extern NEQUICK_G_THREAD_LOCAL NeQuick_exception_jumpBuffer_t *g_NeQuick_exception_pJumpBuffer;
 
 //lint -emacro(789, NEQUICK_TRY) Assign address of auto to static. This is safe as the exception handling will unwind all.
 #define NEQUICK_TRY \
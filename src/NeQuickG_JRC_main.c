@@ -19,12 +19,17 @@
 #include "NeQuickG_JRC_input_data_std_stream.h"
 #include "NeQuickG_JRC_input_data_stream.h"
 #include "NeQuickG_JRC_macros.h"
+#if !defined(_MSC_VER)
+#include "NeQuickG_JRC_thread_stress.h"
+#endif
 
 #define NEQUICK_TEC_EXCEPTION -8
 #ifdef FTR_UNIT_TEST
 #define NEQUICK_UNIT_TEST_EXCEPTION -10
 #endif
 #define NEQUICK_G_JRC_TEC_EPSILON (5e-6)
+/** Number of integration methods compared by option -i */
+#define NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT (3)
 
 static void to_std_output
   (NeQuickG_chandle nequick,
@@ -80,6 +85,21 @@ void usage(bool is_error) {
     "<satellite.longitude> <satellite.latitude> <satellite.height> "
     "<STEC expected>\n\n");
 
+  printf(" -i "
+    "<input_file>\n"
+    "\tCalculates the STEC of the -j input file with the recursive,\n"
+    "\tthe global adaptive and the Patterson integration methods and prints\n"
+    "\tthe number of electron density evaluations of each method and\n"
+    "\tthe STEC difference with the recursive method\n\n");
+
+#if !defined(_MSC_VER)
+  printf(" -t "
+    "<thread count> <input_file>\n"
+    "\tCalculates the STEC of the -j input file in <thread count> threads\n"
+    "\tsharing the model and checks that every thread gets\n"
+    "\tthe single-threaded results bit-for-bit\n\n");
+#endif
+
 
   printf("\nParameter\tDescription                  \tunit: \n\n");
   printf("STEC       \tSlant Total Electron Content\tTECU (10^16 electrons/m2) \n");
@@ -293,6 +313,97 @@ static int on_jrc_file(
   return (ret) ? NEQUICK_OK : NEQUICK_TEC_EXCEPTION;
 }
 
+static int on_integration_comparison_file(
+  const NeQuickG_handle handle,
+  const char* const pInput_data_file) {
+
+  // the first method is the reference
+  static const uint8_t method[NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT] = {
+    NEQUICKG_INTEGRATION_RECURSIVE,
+    NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE,
+    NEQUICKG_INTEGRATION_PATTERSON
+  };
+  static const char* const pMethod_name[NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT] = {
+    "recursive",
+    "global adaptive",
+    "Patterson"
+  };
+
+  volatile int32_t ret = NEQUICK_OK;
+
+  volatile size_t total_evaluation_count[NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT] =
+    {0};
+  volatile double_t max_TEC_difference[NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT] =
+    {0.0};
+
+  NeQuickG_input_data_stream_t stream;
+  NeQuickG_input_data_stream_init(&stream);
+
+  NEQUICK_TRY {
+
+    NeQuickG_input_data_stream_open(
+      &stream,
+      pInput_data_file,
+      handle);
+
+    while (NeQuickG_input_data_stream_get_next(&stream)) {
+
+      double_t total_electron_content[NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT];
+      size_t evaluation_count[NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT];
+
+      size_t i;
+      for (i = 0; i < NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT; i++) {
+        if ((NeQuickG.set_integration_method(handle, method[i]) !=
+             NEQUICK_OK) ||
+            (NeQuickG.get_total_electron_content(
+               handle, &total_electron_content[i]) != NEQUICK_OK) ||
+            (NeQuickG.get_evaluation_count(
+               handle, &evaluation_count[i]) != NEQUICK_OK)) {
+          ret = NEQUICK_TEC_EXCEPTION;
+          break;
+        }
+        total_evaluation_count[i] += evaluation_count[i];
+      }
+      if (ret != NEQUICK_OK) {
+        break;
+      }
+
+      printf("TEC = %12.5f, evaluations", total_electron_content[0]);
+      for (i = 0; i < NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT; i++) {
+        printf(" %s = %6zu", pMethod_name[i], evaluation_count[i]);
+      }
+      printf(", TEC difference");
+      for (i = 1; i < NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT; i++) {
+        double_t TEC_difference =
+          fabs(total_electron_content[i] - total_electron_content[0]);
+        max_TEC_difference[i] = max(max_TEC_difference[i], TEC_difference);
+        printf(" %s = %e", pMethod_name[i], TEC_difference);
+      }
+      printf("\n");
+    }
+  } NEQUICK_CATCH_ALL_EXCEPTIONS {
+    NeQuickG_input_data_stream_close(&stream);
+    NEQUICK_RETHROW();
+  } NEQUICK_END;
+
+  NeQuickG_input_data_stream_close(&stream);
+
+  (void)NeQuickG.set_integration_method(
+    handle, NEQUICKG_INTEGRATION_RECURSIVE);
+
+  printf("Total evaluations");
+  for (size_t i = 0; i < NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT; i++) {
+    printf(" %s = %zu", pMethod_name[i], total_evaluation_count[i]);
+  }
+  printf(", max TEC difference");
+  for (size_t i = 1; i < NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT; i++) {
+    printf(" %s = %e", pMethod_name[i], max_TEC_difference[i]);
+  }
+  printf("\n");
+
+  return ret;
+}
+
 int main(int argc, char* argv[]) {
 
   volatile int ret = NEQUICK_OK;
@@ -368,6 +479,42 @@ int main(int argc, char* argv[]) {
       ret = on_jrc_file(nequick, pInput_data_file);
       break;
     }
+    // integration methods comparison on a JRC format file
+    case 'i':
+    {
+      if (argc != (arg_index + 1)) {
+        NeQuick_exception_throw(
+          NEQUICK_USAGE_EXCEPTION, NEQUICK_USAGE_BAD_COUNT);
+      }
+      char* pInput_data_file = argv[arg_index++];
+      ret = on_integration_comparison_file(nequick, pInput_data_file);
+      break;
+    }
+#if !defined(_MSC_VER)
+    // thread stress test on a JRC format file
+    case 't':
+    {
+      if (argc != (arg_index + 2)) {
+        NeQuick_exception_throw(
+          NEQUICK_USAGE_EXCEPTION, NEQUICK_USAGE_BAD_COUNT);
+      }
+      char* pEnd;
+      unsigned long thread_count = strtoul(argv[arg_index], &pEnd, 10);
+      if ((*pEnd != '\0') || (thread_count == 0)) {
+        NeQuick_exception_throw(
+          NEQUICK_USAGE_EXCEPTION, NEQUICK_USAGE_BAD_FORMAT);
+      }
+      arg_index++;
+      char* pInput_data_file = argv[arg_index++];
+      //lint -e{746} not made in the presence of a prototype
+      //due to FTR_MODIP_CCIR_AS_CONSTANTS trick
+      ret = NeQuickG_thread_stress_test(
+        pModip_file, pCCIR_directory,
+        (size_t)thread_count, pInput_data_file) ?
+        NEQUICK_OK : NEQUICK_TEC_EXCEPTION;
+      break;
+    }
+#endif // _MSC_VER
 #ifdef FTR_UNIT_TEST
     // Unit test option
     case 'u':
@@ -422,3 +569,4 @@ int main(int argc, char* argv[]) {
 #undef NEQUICK_UNIT_TEST_EXCEPTION
 #undef NEQUICK_TEC_EXCEPTION
 #undef NEQUICK_G_JRC_TEC_EPSILON
+#undef NEQUICK_G_JRC_INTEGRATION_METHOD_COUNT
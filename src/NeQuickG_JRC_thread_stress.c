@@ -0,0 +1,291 @@
+/**
+ * NeQuickG test program thread stress test
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC_main
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_thread_stress.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_exception.h"
+
+#define NEQUICK_G_THREAD_STRESS_RECORD_FORMAT \
+"%hhu %lf %lf %lf %lf %lf %lf %lf %lf"
+
+#define NEQUICK_G_THREAD_STRESS_FIELD_COUNT (\
+  NEQUICKG_TIME_PARAMETERS_COUNT + \
+  NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT*2 + 1)
+
+/** Number of times each thread evaluates the whole file */
+#define NEQUICK_G_THREAD_STRESS_ITERATIONS (4)
+
+typedef struct NeQuickG_thread_stress_link_st {
+  uint8_t month;
+  double_t UTC;
+  double_t receiver[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT];
+  double_t satellite[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT];
+} NeQuickG_thread_stress_link_t;
+
+typedef struct NeQuickG_thread_stress_file_st {
+  double_t az[NEQUICKG_AZ_COEFFICIENTS_COUNT];
+  NeQuickG_thread_stress_link_t* pLinks;
+  size_t count;
+} NeQuickG_thread_stress_file_t;
+
+typedef struct NeQuickG_thread_stress_worker_st {
+  pthread_t thread;
+  NeQuickG_model_handle model;
+  const NeQuickG_thread_stress_file_t* pFile;
+  /** single-threaded results */
+  const double_t* pTEC_reference;
+  /** the worker starts at this link and wraps around */
+  size_t first_link;
+  bool success;
+} NeQuickG_thread_stress_worker_t;
+
+static void read_file(
+  NeQuickG_thread_stress_file_t* const pFile,
+  const char* const pInput_data_file) {
+
+  FILE* pInput_file = fopen(pInput_data_file, "r");
+  if (!pInput_file) {
+    NEQUICK_EXCEPTION_THROW(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_INPUT_DATA_FILE_REASON,
+      "Cannot open input file %s", pInput_data_file);
+  }
+
+  if (fscanf(pInput_file, "%lf %lf %lf",
+        &pFile->az[0x00], &pFile->az[0x01], &pFile->az[0x02]) !=
+      NEQUICKG_AZ_COEFFICIENTS_COUNT) {
+    fclose(pInput_file);
+    NEQUICK_EXCEPTION_THROW(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_INPUT_DATA_BAD_COEFF,
+      "Az coefficients error, cannot be scanned with fscanf. Expected 3 coefficients");
+  }
+
+  size_t capacity = 0;
+  NeQuickG_thread_stress_link_t link;
+  double_t TEC_expected;
+
+  while (fscanf(pInput_file,
+           NEQUICK_G_THREAD_STRESS_RECORD_FORMAT,
+           &link.month,
+           &link.UTC,
+           &link.receiver[0x00],
+           &link.receiver[0x01],
+           &link.receiver[0x02],
+           &link.satellite[0x00],
+           &link.satellite[0x01],
+           &link.satellite[0x02],
+           &TEC_expected) == NEQUICK_G_THREAD_STRESS_FIELD_COUNT) {
+    if (pFile->count == capacity) {
+      capacity = (capacity == 0) ? 64 : (capacity * 2);
+      NeQuickG_thread_stress_link_t* pLinks =
+        realloc(pFile->pLinks, capacity*sizeof(NeQuickG_thread_stress_link_t));
+      if (!pLinks) {
+        fclose(pInput_file);
+        free(pFile->pLinks);
+        pFile->pLinks = NULL;
+        NEQUICK_EXCEPTION_THROW(
+          NEQUICK_ERROR_SRC_MEMORY,
+          NEQUICK_ERROR_CODE_NO_RESOURCES,
+          "Not enough resources to read the input file");
+      }
+      pFile->pLinks = pLinks;
+    }
+    pFile->pLinks[pFile->count++] = link;
+  }
+  fclose(pInput_file);
+}
+
+/** Evaluates every link of the file once, starting at first_link */
+static bool get_STEC(
+  const NeQuickG_handle nequick,
+  const NeQuickG_thread_stress_file_t* const pFile,
+  size_t first_link,
+  double_t* const pTEC) {
+
+  for (size_t k = 0; k < pFile->count; k++) {
+    size_t i = (first_link + k) % pFile->count;
+    const NeQuickG_thread_stress_link_t* const pLink = &pFile->pLinks[i];
+    if ((NeQuickG.set_time(nequick, pLink->month, pLink->UTC) != NEQUICK_OK) ||
+        (NeQuickG.set_receiver_position(
+           nequick,
+           pLink->receiver[0x00],
+           pLink->receiver[0x01],
+           pLink->receiver[0x02]) != NEQUICK_OK) ||
+        (NeQuickG.set_satellite_position(
+           nequick,
+           pLink->satellite[0x00],
+           pLink->satellite[0x01],
+           pLink->satellite[0x02]) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(nequick, &pTEC[i]) != NEQUICK_OK)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool open_session(
+  NeQuickG_model_chandle model,
+  const NeQuickG_thread_stress_file_t* const pFile,
+  NeQuickG_handle* const pHandle) {
+
+  if (NeQuickG.session_init(model, pHandle) != NEQUICK_OK) {
+    return false;
+  }
+  if (NeQuickG.set_solar_activity_coefficients(
+        *pHandle, pFile->az, (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT) !=
+      NEQUICK_OK) {
+    NeQuickG.close(*pHandle);
+    return false;
+  }
+  return true;
+}
+
+static void* worker_run(void* pArg) {
+
+  NeQuickG_thread_stress_worker_t* const pWorker =
+    (NeQuickG_thread_stress_worker_t*)pArg;
+
+  pWorker->success = false;
+
+  double_t* pTEC = malloc(pWorker->pFile->count*sizeof(double_t));
+  if (!pTEC) {
+    return NULL;
+  }
+
+  NeQuickG_handle nequick;
+  if (!open_session(pWorker->model, pWorker->pFile, &nequick)) {
+    free(pTEC);
+    return NULL;
+  }
+
+  bool success = true;
+  for (size_t j = 0; j < NEQUICK_G_THREAD_STRESS_ITERATIONS; j++) {
+    if (!get_STEC(nequick, pWorker->pFile, pWorker->first_link, pTEC) ||
+        (memcmp(
+          pTEC,
+          pWorker->pTEC_reference,
+          pWorker->pFile->count*sizeof(double_t)) != 0)) {
+      success = false;
+      break;
+    }
+  }
+
+  // no error was raised in this thread
+  if (NeQuickG.get_last_error(NULL) != NEQUICK_OK) {
+    success = false;
+  }
+
+  NeQuickG.close(nequick);
+  free(pTEC);
+
+  pWorker->success = success;
+  return NULL;
+}
+
+static bool run_workers(
+  NeQuickG_model_handle model,
+  const NeQuickG_thread_stress_file_t* const pFile,
+  const double_t* const pTEC_reference,
+  size_t thread_count) {
+
+  NeQuickG_thread_stress_worker_t* pWorkers =
+    calloc(thread_count, sizeof(NeQuickG_thread_stress_worker_t));
+  if (!pWorkers) {
+    return false;
+  }
+
+  bool success = true;
+  size_t started = 0;
+  for (; started < thread_count; started++) {
+    NeQuickG_thread_stress_worker_t* pWorker = &pWorkers[started];
+    pWorker->model = model;
+    pWorker->pFile = pFile;
+    pWorker->pTEC_reference = pTEC_reference;
+    // spread the threads over the file,
+    // so that they do not evaluate the same link at the same time
+    pWorker->first_link = (started*pFile->count) / thread_count;
+    if (pthread_create(&pWorker->thread, NULL, worker_run, pWorker) != 0) {
+      success = false;
+      break;
+    }
+  }
+
+  for (size_t i = 0; i < started; i++) {
+    if ((pthread_join(pWorkers[i].thread, NULL) != 0) ||
+        !pWorkers[i].success) {
+      printf("Thread %zu results are not the single-threaded results\n", i);
+      success = false;
+    }
+  }
+
+  free(pWorkers);
+  return success;
+}
+
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmissing-prototypes"
+#endif
+bool NeQuickG_thread_stress_test(
+  const char* const pModip_file,
+  const char* const pCCIR_folder,
+  size_t thread_count,
+  const char* const pInput_data_file) {
+
+  NeQuickG_thread_stress_file_t file;
+  file.pLinks = NULL;
+  file.count = 0;
+
+  // on error the links are released before the exception is thrown
+  read_file(&file, pInput_data_file);
+
+  bool success = false;
+
+  NeQuickG_model_handle model;
+  double_t* pTEC_reference = malloc((file.count + 1)*sizeof(double_t));
+
+  if (pTEC_reference &&
+      (NeQuickG.model_init(pModip_file, pCCIR_folder, &model) == NEQUICK_OK)) {
+
+    // single-threaded reference
+    NeQuickG_handle nequick;
+    if (open_session(model, &file, &nequick)) {
+      success = get_STEC(nequick, &file, 0, pTEC_reference);
+      NeQuickG.close(nequick);
+    }
+
+    if (success) {
+      success = run_workers(model, &file, pTEC_reference, thread_count);
+    }
+
+    NeQuickG.model_close(model);
+  }
+
+  printf("Thread stress test, threads = %zu, links = %zu: %s\n",
+    thread_count, file.count, success ? "success" : "error");
+
+  free(pTEC_reference);
+  free(file.pLinks);
+  return success;
+}
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic pop
+#endif
+
+#undef NEQUICK_G_THREAD_STRESS_ITERATIONS
+#undef NEQUICK_G_THREAD_STRESS_FIELD_COUNT
+#undef NEQUICK_G_THREAD_STRESS_RECORD_FORMAT
@@ -0,0 +1,44 @@
+/**
+ * NeQuickG test program thread stress test
+ *
+ * Evaluates the links of a JRC benchmark file concurrently in several threads,
+ * each thread owns a session opened on the same shared model.
+ * The results of every thread must be bit-for-bit identical to the results
+ * of a single-threaded run.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC_main
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_THREAD_STRESS_H
+#define NEQUICK_G_JRC_THREAD_STRESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define NeQuickG_thread_stress_test( \
+  pModip_file, pCCIR_folder, thread_count, pInput_data_file) \
+  NeQuickG_thread_stress_test(thread_count, pInput_data_file)
+#endif // FTR_MODIP_CCIR_AS_CONSTANTS
+
+/** Runs the thread stress test on a JRC benchmark file
+ *
+ * @param[in] pModip_file modip grid file
+ * @param[in] pCCIR_folder CCIR folder
+ * @param[in] thread_count number of threads
+ * @param[in] pInput_data_file JRC file: az coefficients in the first line,
+ *  one link (input data + STEC expected) per line
+ * @return true if every thread got the single-threaded results
+ */
+extern bool NeQuickG_thread_stress_test(
+  const char* const pModip_file,
+  const char* const pCCIR_folder,
+  size_t thread_count,
+  const char* const pInput_data_file);
+
+#endif // NEQUICK_G_JRC_THREAD_STRESS_H
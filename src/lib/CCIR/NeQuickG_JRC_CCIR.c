@@ -136,7 +136,7 @@ int32_t CCIR_get_ionosonde_Fm3(
     *ppFm3 = NULL;
     NEQUICK_ERROR_RETURN(
       NEQUICK_ERROR_SRC_INPUT_DATA,
-      NEQUICK_INPUT_DATA_BAD_MONTH,
+      NEQUICK_ERROR_CODE_BAD_MONTH,
       "Invalid month %u", month);
   }
 
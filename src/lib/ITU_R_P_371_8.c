@@ -18,3 +18,10 @@ double_t get_solar_mean_spot_number
       ITU_R_P_371_8_LOWER_SOLAR_FLUX_IN_SFU)*1123.6
     ) - 408.99);
 }
+
+double_t get_solar_mean_spot_number_derivative
+  (double_t solar_12_month_running_mean_of_2800_MHZ_noise_flux) {
+  return (0.5 * 1123.6 / sqrt(167273.0 +
+      (solar_12_month_running_mean_of_2800_MHZ_noise_flux -
+      ITU_R_P_371_8_LOWER_SOLAR_FLUX_IN_SFU)*1123.6));
+}
@@ -14,50 +14,33 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "NeQuickG_JRC_batch.h"
 #include "NeQuickG_JRC_context.h"
 #include "NeQuickG_JRC_error.h"
+#if !defined(_MSC_VER)
+#include "NeQuickG_JRC_executor.h"
+#include "NeQuickG_JRC_pool.h"
+#endif
+#include "NeQuickG_JRC_TEC_gradient.h"
 #include "NeQuickG_JRC_TEC_integration.h"
-#include "NeQuickG_JRC_ray.h"
+#include "NeQuickG_JRC_TEC_partial.h"
 #ifdef FTR_UNIT_TEST
 #include "NeQuickG_JRC_UT.h"
 #endif
 
-/** Sets the modip in the context using the station position
- *
- * input data is converted to km if necessary
- *
- * @param[in, out] pContext NeQuick context
- */
-static void get_modip_impl(
-  NeQuickG_context_t* const pContext) {
-  input_data_to_km(&pContext->input_data);
-  modip_get(&pContext->modip, &pContext->input_data.station_position);
-}
-
 /** Returns the modip in degrees
- * @see {@link get_modip_impl}
+ * @see {@link NeQuickG_context_get_modip}
  * @param[in] handle NeQuick handle
  * @return modip in degrees
  */
 static double_t get_modip_interface(NeQuickG_handle handle) {
   NeQuickG_context_t* pContext = (NeQuickG_context_t*)(handle);
-  get_modip_impl(pContext);
+  NeQuickG_context_get_modip(pContext);
   return pContext->modip.modip_degree;
 }
 
-/** Sets the solar activity in the context using the modip
- * @see {@link get_modip_impl}
- * @see {@link solar_activity_get}
- *
- * @param[in, out] pContext NeQuick context
- */
-static void get_solar_activity(
-  NeQuickG_context_t* const pContext) {
-  get_modip_impl(pContext);
-  solar_activity_get(&pContext->solar_activity, pContext->modip.modip_degree);
-}
-
 /** Checks if the handle is valid
  * @param[in] handle NeQuick handle
  * @return on success NEQUICK_OK
@@ -72,29 +55,81 @@ static int32_t check_handle(NeQuickG_chandle handle) {
   return NEQUICK_OK;
 }
 
-/** {@ref NeQuickG_library.init} */
-static int32_t init(
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define model_create(pModip_file, pCCIR_folder, is_preloaded, pModel) \
+  model_create(pModel)
+#endif // FTR_MODIP_CCIR_AS_CONSTANTS
+
+/** Allocates and loads a model
+ * @param[in] pModip_file see #NeQuickG_library.init
+ * @param[in] pCCIR_folder see #NeQuickG_library.init
+ * @param[in] is_preloaded true to load the CCIR maps of the 12 months in
+ *  the model, false to let its session load the month it needs
+ * @param[out] pModel on success a valid model handle
+ * @return on success NEQUICK_OK
+ */
+static int32_t model_create(
   const char* const pModip_file,
   const char* const pCCIR_folder,
-  NeQuickG_handle* const pHandle) {
+  bool is_preloaded,
+  NeQuickG_model_handle* const pModel) {
 
-  *pHandle = NEQUICKG_INVALID_HANDLE;
+  *pModel = NEQUICKG_INVALID_HANDLE;
 
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-  if (!pModip_file) {
+  NeQuickG_model_t* pNew_model = malloc(sizeof(NeQuickG_model_t));
+  if (!pNew_model) {
     NEQUICK_ERROR_RETURN(
-      NEQUICK_ERROR_SRC_MODIP,
-      NEQUICK_ERROR_CODE_BAD_MODIP_GRID_FILE,
-      "Modip file. null pointer exception.");
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to allocate NeQuick model on the heap");
   }
 
-  if (!pCCIR_folder) {
-    NEQUICK_ERROR_RETURN(
-      NEQUICK_ERROR_SRC_F2_LAYER,
-      NEQUICK_ERROR_CODE_BAD_CCIR_FILE,
-      "CCIR folder. null pointer exception.");
+  int32_t ret = NeQuickG_model_init(pNew_model, pModip_file, pCCIR_folder);
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  if ((ret == NEQUICK_OK) && is_preloaded) {
+    ret = NeQuickG_model_load_CCIR_months(pNew_model);
   }
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+  if (ret != NEQUICK_OK) {
+    NeQuickG_model_close(pNew_model);
+    free(pNew_model);
+    return ret;
+  }
+
+  *pModel = pNew_model;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.model_init} */
+static int32_t model_init(
+  const char* const pModip_file,
+  const char* const pCCIR_folder,
+  NeQuickG_model_handle* const pModel) {
+  // the sessions share the CCIR maps instead of loading a copy each
+  return model_create(pModip_file, pCCIR_folder, true, pModel);
+}
+
+/** {@ref NeQuickG_library.model_close} */
+static void model_close(NeQuickG_model_handle model) {
+  if (model != NEQUICKG_INVALID_HANDLE) {
+    NeQuickG_model_close((NeQuickG_model_t*)model);
+    free(model);
+  }
+}
+
+/** {@ref NeQuickG_library.session_init} */
+static int32_t session_init(
+  NeQuickG_model_chandle model,
+  NeQuickG_handle* const pHandle) {
+
+  *pHandle = NEQUICKG_INVALID_HANDLE;
+
+  if (model == NEQUICKG_INVALID_HANDLE) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_HANDLE_NULL,
+      "NULL model handle");
+  }
 
   *pHandle = malloc(sizeof(NeQuickG_context_t));
   if (*pHandle == NEQUICKG_INVALID_HANDLE) {
@@ -107,40 +142,566 @@ static int32_t init(
   NeQuickG_context_t* pContext = (NeQuickG_context_t*)(*pHandle);
   assert(pContext);
 
-  int32_t ret;
+  NeQuickG_context_init(pContext, (const NeQuickG_model_t*)model);
 
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-  ret = modip_init(&pContext->modip, pModip_file);
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.reset} */
+static int32_t reset(const NeQuickG_handle handle) {
+
+  int32_t ret = check_handle(handle);
   if (ret != NEQUICK_OK) {
-    free(*pHandle);
-    *pHandle = NEQUICKG_INVALID_HANDLE;
     return ret;
   }
-#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
-  ret = iono_profile_init(&pContext->profile, pCCIR_folder);
+  NeQuickG_context_reset((NeQuickG_context_t*)(handle));
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.init} */
+static int32_t init(
+  const char* const pModip_file,
+  const char* const pCCIR_folder,
+  NeQuickG_handle* const pHandle) {
+
+  *pHandle = NEQUICKG_INVALID_HANDLE;
+
+  // a single session loads the month it needs, not the 12 of them
+  NeQuickG_model_handle model;
+  int32_t ret = model_create(pModip_file, pCCIR_folder, false, &model);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  ret = session_init(model, pHandle);
   if (ret != NEQUICK_OK) {
-    free(*pHandle);
-    *pHandle = NEQUICKG_INVALID_HANDLE;
+    model_close(model);
     return ret;
   }
 
+  // the session owns the model: it is released on close
+  ((NeQuickG_context_t*)(*pHandle))->pOwned_model =
+    (NeQuickG_model_t*)model;
+
   return NEQUICK_OK;
 }
 
 /** {@ref NeQuickG_library.close} */
 static void close(NeQuickG_handle handle) {
   if (handle != NEQUICKG_INVALID_HANDLE) {
+    if (((const NeQuickG_context_t*)(handle))->is_pooled) {
+      // the session memory belongs to the pool
+      NEQUICK_ERROR_LOG(
+        NEQUICK_ERROR_SRC_INPUT_DATA,
+        NEQUICK_ERROR_CODE_BAD_SESSION,
+        "Close. the session belongs to a pool, release it instead");
+      return;
+    }
+
+    NeQuickG_model_t* pOwned_model =
+      ((NeQuickG_context_t*)(handle))->pOwned_model;
+
+    NeQuickG_context_close((NeQuickG_context_t*)(handle));
+    free(handle);
 
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-    NeQuickG_context_t* pContext = (NeQuickG_context_t*)(handle);
-    iono_profile_close(&pContext->profile);
-#endif
+    model_close(pOwned_model);
+  }
+}
 
-    free(handle);
+/** {@ref NeQuickG_library.get_vertical_total_electron_content} */
+static int32_t get_vertical_total_electron_content(
+  const NeQuickG_handle handle,
+  const double_t longitude_degree,
+  const double_t latitude_degree,
+  const double_t bottom_height_meters,
+  const double_t top_height_meters,
+  double_t* const pTEC) {
+
+  *pTEC = 0.0;
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_context_get_vertical_total_electron_content(
+    (NeQuickG_context_t*)(handle),
+    longitude_degree,
+    latitude_degree,
+    bottom_height_meters,
+    top_height_meters,
+    pTEC);
+}
+
+/** {@ref NeQuickG_library.get_vertical_total_electron_content_batch} */
+static int32_t get_vertical_total_electron_content_batch(
+  const NeQuickG_handle handle,
+  const NeQuickG_locations_t* const pLocations,
+  const double_t bottom_height_meters,
+  const double_t top_height_meters,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_batch_get_vertical_total_electron_content(
+    (NeQuickG_context_t*)(handle),
+    pLocations,
+    bottom_height_meters,
+    top_height_meters,
+    pTEC,
+    pStatus);
+}
+
+/** {@ref NeQuickG_library.get_electron_density_profile} */
+static int32_t get_electron_density_profile(
+  const NeQuickG_handle handle,
+  const double_t longitude_degree,
+  const double_t latitude_degree,
+  const double_t* const pHeight_meters,
+  const size_t height_count,
+  double_t* const pElectron_density) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_context_get_electron_density_profile(
+    (NeQuickG_context_t*)(handle),
+    longitude_degree,
+    latitude_degree,
+    pHeight_meters,
+    height_count,
+    pElectron_density);
+}
+
+/** {@ref NeQuickG_library.set_integration_method} */
+static int32_t set_integration_method(
+  const NeQuickG_handle handle,
+  const uint8_t method) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_context_set_integration_method(
+    (NeQuickG_context_t*)handle, method);
+}
+
+/** {@ref NeQuickG_library.get_evaluation_count} */
+static int32_t get_evaluation_count(
+  const NeQuickG_handle handle,
+  size_t* const pEvaluation_count) {
+
+  *pEvaluation_count = 0;
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  *pEvaluation_count =
+    ((const NeQuickG_context_t*)handle)->integration.evaluation_count;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.get_integration_status} */
+static int32_t get_integration_status(
+  const NeQuickG_handle handle,
+  NeQuickG_integration_status_t* const pStatus) {
+
+  memset(pStatus, 0, sizeof(*pStatus));
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  const NeQuickG_integration_t* const pIntegration =
+    &((const NeQuickG_context_t*)handle)->integration;
+
+  pStatus->evaluation_count = pIntegration->evaluation_count;
+  pStatus->is_budget_exhausted = pIntegration->is_budget_exhausted;
+  // same scale as the Total Electron Content, see Eq. 151
+  pStatus->error_estimate_TECU = pIntegration->error_estimate / 1.0E13;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.get_integration_statistics} */
+static int32_t get_integration_statistics(
+  const NeQuickG_handle handle,
+  NeQuickG_integration_statistics_t* const pStatistics) {
+
+  memset(pStatistics, 0, sizeof(*pStatistics));
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  *pStatistics =
+    ((const NeQuickG_context_t*)handle)->integration.statistics;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.set_integration_settings} */
+static int32_t set_integration_settings(
+  const NeQuickG_handle handle,
+  const NeQuickG_integration_settings_t* const pSettings) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_context_set_integration_settings(
+    (NeQuickG_context_t*)handle, pSettings);
+}
+
+/** {@ref NeQuickG_library.set_profile_cache} */
+static int32_t set_profile_cache(
+  const NeQuickG_handle handle,
+  const bool is_enabled,
+  const double_t quantum_degree,
+  const size_t set_count) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return profile_cache_set(
+    &((NeQuickG_context_t*)handle)->profile_cache,
+    is_enabled,
+    quantum_degree,
+    set_count);
+}
+
+/** {@ref NeQuickG_library.get_profile_cache_statistics} */
+static int32_t get_profile_cache_statistics(
+  const NeQuickG_handle handle,
+  NeQuickG_profile_cache_statistics_t* const pStatistics) {
+
+  memset(pStatistics, 0, sizeof(*pStatistics));
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  *pStatistics =
+    ((const NeQuickG_context_t*)handle)->profile_cache.statistics;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.set_fourier_cache} */
+static int32_t set_fourier_cache(
+  const NeQuickG_handle handle,
+  const size_t entry_count) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return F2_layer_fourier_coefficients_set_cache(
+    &((NeQuickG_context_t*)handle)->profile.F2.coef,
+    entry_count);
+}
+
+/** {@ref NeQuickG_library.get_fourier_cache_statistics} */
+static int32_t get_fourier_cache_statistics(
+  const NeQuickG_handle handle,
+  NeQuickG_fourier_cache_statistics_t* const pStatistics) {
+
+  memset(pStatistics, 0, sizeof(*pStatistics));
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  *pStatistics =
+    ((const NeQuickG_context_t*)handle)->profile.F2.coef.cache.statistics;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.get_integration_settings} */
+static int32_t get_integration_settings(
+  const NeQuickG_handle handle,
+  NeQuickG_integration_settings_t* const pSettings) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  if (!pSettings) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Integration settings. null pointer exception.");
+  }
+
+  *pSettings = ((const NeQuickG_context_t*)handle)->integration.settings;
+  return NEQUICK_OK;
+}
+
+#if !defined(_MSC_VER)
+/** {@ref NeQuickG_library.executor_init} */
+static int32_t executor_init(
+  NeQuickG_model_chandle model,
+  size_t thread_count,
+  NeQuickG_executor_handle* const pExecutor) {
+
+  *pExecutor = NEQUICKG_INVALID_HANDLE;
+
+  if (model == NEQUICKG_INVALID_HANDLE) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_HANDLE_NULL,
+      "NULL model handle");
+  }
+
+  NeQuickG_executor_t* pNew_executor = malloc(sizeof(NeQuickG_executor_t));
+  if (!pNew_executor) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to allocate NeQuick executor on the heap");
+  }
+
+  int32_t ret = NeQuickG_executor_init(
+    pNew_executor, (const NeQuickG_model_t*)model, thread_count);
+  if (ret != NEQUICK_OK) {
+    free(pNew_executor);
+    return ret;
+  }
+
+  *pExecutor = pNew_executor;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.executor_close} */
+static void executor_close(NeQuickG_executor_handle executor) {
+  if (executor != NEQUICKG_INVALID_HANDLE) {
+    NeQuickG_executor_close((NeQuickG_executor_t*)executor);
+    free(executor);
+  }
+}
+
+/** {@ref NeQuickG_library.executor_get_total_electron_content_batch} */
+static int32_t executor_get_total_electron_content_batch(
+  const NeQuickG_executor_handle executor,
+  const double_t* const pAz,
+  size_t az_size,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  if (executor == NEQUICKG_INVALID_HANDLE) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_HANDLE_NULL,
+      "NULL executor handle");
+  }
+
+  return NeQuickG_executor_get_total_electron_content(
+    (NeQuickG_executor_t*)executor, pAz, az_size, pLinks, pTEC, pStatus);
+}
+
+#else // _MSC_VER
+/** {@ref NeQuickG_library.executor_init}
+ * The executor is based on POSIX threads, it is not available with MSVC
+ */
+static int32_t executor_init(
+  NeQuickG_model_chandle model,
+  size_t thread_count,
+  NeQuickG_executor_handle* const pExecutor) {
+
+  (void)model;
+  (void)thread_count;
+  *pExecutor = NEQUICKG_INVALID_HANDLE;
+
+  NEQUICK_ERROR_RETURN(
+    NEQUICK_ERROR_SRC_INPUT_DATA,
+    NEQUICK_ERROR_CODE_NOT_SUPPORTED,
+    "Executor. not supported on this platform");
+}
+
+/** {@ref NeQuickG_library.executor_close} */
+static void executor_close(NeQuickG_executor_handle executor) {
+  (void)executor;
+}
+
+/** {@ref NeQuickG_library.executor_get_total_electron_content_batch} */
+static int32_t executor_get_total_electron_content_batch(
+  const NeQuickG_executor_handle executor,
+  const double_t* const pAz,
+  size_t az_size,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  (void)executor;
+  (void)pAz;
+  (void)az_size;
+  (void)pLinks;
+  (void)pTEC;
+  (void)pStatus;
+
+  NEQUICK_ERROR_RETURN(
+    NEQUICK_ERROR_SRC_INPUT_DATA,
+    NEQUICK_ERROR_CODE_NOT_SUPPORTED,
+    "Executor. not supported on this platform");
+}
+#endif // _MSC_VER
+
+#if !defined(_MSC_VER)
+/** {@ref NeQuickG_library.pool_init} */
+static int32_t pool_init(
+  NeQuickG_model_chandle model,
+  size_t session_count,
+  NeQuickG_pool_handle* const pPool) {
+
+  *pPool = NEQUICKG_INVALID_HANDLE;
+
+  if (model == NEQUICKG_INVALID_HANDLE) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_HANDLE_NULL,
+      "NULL model handle");
+  }
+
+  NeQuickG_pool_t* pNew_pool = malloc(sizeof(NeQuickG_pool_t));
+  if (!pNew_pool) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to allocate NeQuick pool on the heap");
+  }
+
+  int32_t ret = NeQuickG_pool_init(
+    pNew_pool, (const NeQuickG_model_t*)model, session_count);
+  if (ret != NEQUICK_OK) {
+    free(pNew_pool);
+    return ret;
+  }
+
+  *pPool = pNew_pool;
+  return NEQUICK_OK;
+}
+
+/** {@ref NeQuickG_library.pool_close} */
+static void pool_close(NeQuickG_pool_handle pool) {
+  if (pool != NEQUICKG_INVALID_HANDLE) {
+    NeQuickG_pool_close((NeQuickG_pool_t*)pool);
+    free(pool);
+  }
+}
+
+/** {@ref NeQuickG_library.pool_acquire} */
+static int32_t pool_acquire(
+  const NeQuickG_pool_handle pool,
+  NeQuickG_handle* const pHandle) {
+
+  *pHandle = NEQUICKG_INVALID_HANDLE;
+
+  if (pool == NEQUICKG_INVALID_HANDLE) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_HANDLE_NULL,
+      "NULL pool handle");
+  }
+
+  NeQuickG_context_t* pContext;
+  int32_t ret = NeQuickG_pool_acquire((NeQuickG_pool_t*)pool, &pContext);
+  if (ret == NEQUICK_OK) {
+    *pHandle = pContext;
+  }
+  return ret;
+}
+
+/** {@ref NeQuickG_library.pool_release} */
+static int32_t pool_release(
+  const NeQuickG_pool_handle pool,
+  const NeQuickG_handle handle) {
+
+  if (pool == NEQUICKG_INVALID_HANDLE) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_HANDLE_NULL,
+      "NULL pool handle");
   }
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_pool_release(
+    (NeQuickG_pool_t*)pool, (NeQuickG_context_t*)handle);
 }
 
+#else // _MSC_VER
+/** {@ref NeQuickG_library.pool_init}
+ * The pool is based on POSIX threads, it is not available with MSVC
+ */
+static int32_t pool_init(
+  NeQuickG_model_chandle model,
+  size_t session_count,
+  NeQuickG_pool_handle* const pPool) {
+
+  (void)model;
+  (void)session_count;
+  *pPool = NEQUICKG_INVALID_HANDLE;
+
+  NEQUICK_ERROR_RETURN(
+    NEQUICK_ERROR_SRC_INPUT_DATA,
+    NEQUICK_ERROR_CODE_NOT_SUPPORTED,
+    "Pool. not supported on this platform");
+}
+
+/** {@ref NeQuickG_library.pool_close} */
+static void pool_close(NeQuickG_pool_handle pool) {
+  (void)pool;
+}
+
+/** {@ref NeQuickG_library.pool_acquire} */
+static int32_t pool_acquire(
+  const NeQuickG_pool_handle pool,
+  NeQuickG_handle* const pHandle) {
+
+  (void)pool;
+  *pHandle = NEQUICKG_INVALID_HANDLE;
+
+  NEQUICK_ERROR_RETURN(
+    NEQUICK_ERROR_SRC_INPUT_DATA,
+    NEQUICK_ERROR_CODE_NOT_SUPPORTED,
+    "Pool. not supported on this platform");
+}
+
+/** {@ref NeQuickG_library.pool_release} */
+static int32_t pool_release(
+  const NeQuickG_pool_handle pool,
+  const NeQuickG_handle handle) {
+
+  (void)pool;
+  (void)handle;
+
+  NEQUICK_ERROR_RETURN(
+    NEQUICK_ERROR_SRC_INPUT_DATA,
+    NEQUICK_ERROR_CODE_NOT_SUPPORTED,
+    "Pool. not supported on this platform");
+}
+#endif // _MSC_VER
+
 /** {@ref NeQuickG_library.set_solar_activity_coefficients} */
 static int32_t set_solar_activity_coefficients(
   const NeQuickG_handle handle,
@@ -170,22 +731,131 @@ static int32_t get_total_electron_content(
 
   NeQuickG_context_t* pContext = (NeQuickG_context_t*)(handle);
 
-  get_solar_activity(pContext);
+  NeQuickG_context_get_solar_activity(pContext);
 
-  ret = ray_get(
-    &pContext->ray,
-    &pContext->input_data.station_position,
-    &pContext->input_data.satellite_position);
+  return NeQuickG_context_get_slant_total_electron_content(
+    pContext, pTotal_electron_content);
+}
+
+/** {@ref NeQuickG_library.get_total_electron_content_link} */
+static int32_t get_total_electron_content_link(
+  const NeQuickG_handle handle,
+  const uint32_t link_id,
+  double_t* const pTotal_electron_content) {
+
+  *pTotal_electron_content = 0.0;
+
+  int32_t ret = check_handle(handle);
   if (ret != NEQUICK_OK) {
     return ret;
   }
 
-  ret = NeQuickG_integrate(pContext, pTotal_electron_content);
-  if (ret == NEQUICK_OK) {
-    // Eq. 151, Eq. 202 for the correction factor
-    *pTotal_electron_content = (*pTotal_electron_content / 1.0E13);
+  NeQuickG_context_t* pContext = (NeQuickG_context_t*)(handle);
+
+  NeQuickG_context_get_solar_activity(pContext);
+
+  return NeQuickG_context_get_slant_total_electron_content_link(
+    pContext, link_id, pTotal_electron_content);
+}
+
+/** {@ref NeQuickG_library.get_total_electron_content_gradient} */
+static int32_t get_total_electron_content_gradient(
+  const NeQuickG_handle handle,
+  double_t* const pTotal_electron_content,
+  NeQuickG_TEC_gradient_t* const pGradient) {
+
+  *pTotal_electron_content = 0.0;
+  memset(pGradient, 0, sizeof(*pGradient));
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
   }
-  return ret;
+
+  return NeQuickG_TEC_gradient_get(
+    (NeQuickG_context_t*)(handle), pTotal_electron_content, pGradient);
+}
+
+/** {@ref NeQuickG_library.get_total_electron_content_partial} */
+static int32_t get_total_electron_content_partial(
+  const NeQuickG_handle handle,
+  const NeQuickG_TEC_partial_t* const pPartial,
+  double_t* const pTotal_electron_content) {
+
+  *pTotal_electron_content = 0.0;
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_TEC_partial_get(
+    (NeQuickG_context_t*)(handle), pPartial, pTotal_electron_content);
+}
+
+/** {@ref NeQuickG_library.get_total_electron_content_batch} */
+static int32_t get_total_electron_content_batch(
+  const NeQuickG_handle handle,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_batch_get_total_electron_content(
+    (NeQuickG_context_t*)(handle), pLinks, pTEC, pStatus);
+}
+
+/** {@ref NeQuickG_library.get_total_electron_content_batch_ECEF} */
+static int32_t get_total_electron_content_batch_ECEF(
+  const NeQuickG_handle handle,
+  const NeQuickG_links_ECEF_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_batch_get_total_electron_content_ECEF(
+    (NeQuickG_context_t*)(handle), pLinks, pTEC, pStatus);
+}
+
+/** {@ref NeQuickG_library.get_group_delay_batch} */
+static int32_t get_group_delay_batch(
+  const NeQuickG_handle handle,
+  const NeQuickG_links_t* const pLinks,
+  const NeQuickG_frequencies_t* const pFrequencies,
+  double_t* const pDelay,
+  int32_t* const pStatus) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_batch_get_group_delay(
+    (NeQuickG_context_t*)(handle), pLinks, pFrequencies, pDelay, pStatus);
+}
+
+/** {@ref NeQuickG_library.get_total_electron_content_epoch} */
+static int32_t get_total_electron_content_epoch(
+  const NeQuickG_handle handle,
+  const NeQuickG_satellites_t* const pSatellites,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  int32_t ret = check_handle(handle);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_batch_get_total_electron_content_epoch(
+    (NeQuickG_context_t*)(handle), pSatellites, pTEC, pStatus);
 }
 
 /** {@ref NeQuickG_library.set_time} */
@@ -199,12 +869,8 @@ static int32_t set_time(
     return ret;
   }
 
-  NeQuickG_context_t* pContext = (NeQuickG_context_t*)(handle);
-  ret = NeQuickG_time_set(&pContext->input_data.time, month, UTC);
-
-  pContext->profile.E.is_solar_declination_valid = false;
-
-  return ret;
+  return NeQuickG_context_set_time(
+    (NeQuickG_context_t*)(handle), month, UTC);
 }
 
 /** {@ref NeQuickG_library.set_station_position} */
@@ -298,12 +964,49 @@ const struct NeQuickG_library NeQuickG = {
   //lint -e{123} macro with arguments is intended
   .init = init,
   .close = close,
+  //lint -e{123} macro with arguments is intended
+  .model_init = model_init,
+  .model_close = model_close,
+  .session_init = session_init,
+  .reset = reset,
   .set_solar_activity_coefficients = set_solar_activity_coefficients,
   .set_time = set_time,
   .set_receiver_position = set_station_position,
   .set_satellite_position = set_satellite_position,
   .get_modip = get_modip_interface,
   .get_total_electron_content = get_total_electron_content,
+  .get_total_electron_content_link = get_total_electron_content_link,
+  .get_total_electron_content_gradient = get_total_electron_content_gradient,
+  .get_total_electron_content_partial = get_total_electron_content_partial,
+  .get_total_electron_content_batch = get_total_electron_content_batch,
+  .get_total_electron_content_batch_ECEF =
+    get_total_electron_content_batch_ECEF,
+  .get_group_delay_batch = get_group_delay_batch,
+  .get_total_electron_content_epoch = get_total_electron_content_epoch,
+  .get_vertical_total_electron_content = get_vertical_total_electron_content,
+  .get_vertical_total_electron_content_batch =
+    get_vertical_total_electron_content_batch,
+  .get_electron_density_profile = get_electron_density_profile,
+  .set_integration_method = set_integration_method,
+  .get_evaluation_count = get_evaluation_count,
+  .get_integration_status = get_integration_status,
+  .get_integration_statistics = get_integration_statistics,
+  .get_integration_preset = NeQuickG_integration_get_preset,
+  .set_integration_settings = set_integration_settings,
+  .get_integration_settings = get_integration_settings,
+  .set_profile_cache = set_profile_cache,
+  .get_profile_cache_statistics = get_profile_cache_statistics,
+  .set_fourier_cache = set_fourier_cache,
+  .get_fourier_cache_statistics = get_fourier_cache_statistics,
+  .executor_init = executor_init,
+  .executor_close = executor_close,
+  .executor_get_total_electron_content_batch =
+    executor_get_total_electron_content_batch,
+  .pool_init = pool_init,
+  .pool_close = pool_close,
+  .pool_acquire = pool_acquire,
+  .pool_release = pool_release,
+  .get_last_error = NeQuickG_error_get_last,
   .input_data_to_std_output = input_data_to_std_output_impl,
   .input_data_to_output = input_data_to_output_impl,
 #ifdef FTR_UNIT_TEST
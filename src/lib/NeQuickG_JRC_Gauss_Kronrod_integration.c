@@ -20,6 +20,16 @@
 #define NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT (15)
 /** Num of G7 pts for Kronrod integration */
 #define NEQUICK_G_JRC_KRONROD_G7_POINT_COUNT (7)
+/** Num of pts added to the K15 pts by the 31 pts Patterson rule */
+#define NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT (16)
+/** Num of pts added to the 31 pts by the 63 pts Patterson rule */
+#define NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT (32)
+
+/** Two sibling sub-intervals of a link mesh are merged when both errors
+ * were below this fraction of the tolerance, the G7 error grows
+ * much faster than the length of the sub-interval
+ */
+#define NEQUICK_G_JRC_KRONROD_MESH_COARSEN_RATIO (0.01)
 
 /** Constants for where samples are taken in the Kronrod integration
  * (i.e. how far from the midpoint).
@@ -97,6 +107,183 @@ static const double_t wig[NEQUICK_G_JRC_KRONROD_G7_POINT_COUNT] = {
   NEQUICK_G_JRC_KRONROD_G7_WEIGHT_1
 };
 
+/* Patterson extensions of the K15 rule (T.N.L. Patterson, The optimum addition
+ * of points to quadrature formulae, Math. Comp. 22, 1968).
+ * Each rule keeps all the points of the previous one and adds as many again
+ * plus one, so that a refinement reuses every density already evaluated.
+ * The 31 pts rule is exact up to degree 47, the 63 pts rule up to degree 95.
+ */
+
+/** Nodes added by the 31 point Patterson rule */
+static const double_t patterson_31_xi[NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT] = {
+  -0.998687109678466729790660660569,
+  -0.975383588208893369675287074952,
+  -0.912204882783262878350584611172,
+  -0.807688939172437509088075575912,
+  -0.667348098104300175431382116612,
+  -0.498636786552832004293429260085,
+  -0.308579247910587778899587521987,
+  -0.104528273810780713400625068280,
+  0.104528273810780713400625068280,
+  0.308579247910587778899587521987,
+  0.498636786552832004293429260085,
+  0.667348098104300175431382116612,
+  0.807688939172437509088075575912,
+  0.912204882783262878350584611172,
+  0.975383588208893369675287074952,
+  0.998687109678466729790660660569
+};
+
+/** Weights of the 31 point Patterson rule at the K15 nodes */
+static const double_t patterson_31_wi_K15[NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT] = {
+  0.011319468444683435107484337678,
+  0.031577706217045857273769765166,
+  0.052384370820982692472468037762,
+  0.070332046410400650935000423631,
+  0.084498765301243021195121987355,
+  0.095178029931830680121115000867,
+  0.102214180005702743915914938970,
+  0.104743213564805844727591962771,
+  0.102214180005702743915914938970,
+  0.095178029931830680121115000867,
+  0.084498765301243021195121987355,
+  0.070332046410400650935000423631,
+  0.052384370820982692472468037762,
+  0.031577706217045857273769765166,
+  0.011319468444683435107484337678
+};
+
+/** Weights of the 31 point Patterson rule at its new nodes */
+static const double_t patterson_31_wi[NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT] = {
+  0.003634931195049883856073927323,
+  0.021039446258726795607092616934,
+  0.042193500584546594484849918471,
+  0.061821985645449856431459019946,
+  0.077875347115245996421179504125,
+  0.090261802146558602310121354156,
+  0.099196857667432912489848978389,
+  0.104099955472697355014704207842,
+  0.104099955472697355014704207842,
+  0.099196857667432912489848978389,
+  0.090261802146558602310121354156,
+  0.077875347115245996421179504125,
+  0.061821985645449856431459019946,
+  0.042193500584546594484849918471,
+  0.021039446258726795607092616934,
+  0.003634931195049883856073927323
+};
+
+/** Nodes added by the 63 point Patterson rule */
+static const double_t patterson_63_xi[NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT] = {
+  -0.999809214198043517683853183802,
+  -0.996040238625968543068929416814,
+  -0.984637143875644179797308158697,
+  -0.963564953613396169948875982748,
+  -0.931984657380665140627131096210,
+  -0.889809364874942640040706031975,
+  -0.837456832560144586521412458847,
+  -0.775673908358334814097856547303,
+  -0.705382409374850309141845887609,
+  -0.627545421382293261363880410875,
+  -0.543082350986701131146601933623,
+  -0.452855632849607231381999359736,
+  -0.357714831586033270409031511091,
+  -0.258559618754472473546151272261,
+  -0.156392640336081401531118588925,
+  -0.052344665459830506663082263918,
+  0.052344665459830506663082263918,
+  0.156392640336081401531118588925,
+  0.258559618754472473546151272261,
+  0.357714831586033270409031511091,
+  0.452855632849607231381999359736,
+  0.543082350986701131146601933623,
+  0.627545421382293261363880410875,
+  0.705382409374850309141845887609,
+  0.775673908358334814097856547303,
+  0.837456832560144586521412458847,
+  0.889809364874942640040706031975,
+  0.931984657380665140627131096210,
+  0.963564953613396169948875982748,
+  0.984637143875644179797308158697,
+  0.996040238625968543068929416814,
+  0.999809214198043517683853183802
+};
+
+/** Weights of the 63 point Patterson rule at the K15 nodes */
+static const double_t patterson_63_wi_K15[NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT] = {
+  0.005660867725095312756491752589,
+  0.015788872779215423952826797363,
+  0.026192186880710567449383235551,
+  0.035166023524553984272055668515,
+  0.042249382781031758513685093961,
+  0.047589015038602680558435386206,
+  0.051107090052427067321974073405,
+  0.052371606825453741755380443761,
+  0.051107090052427067321974073405,
+  0.047589015038602680558435386206,
+  0.042249382781031758513685093961,
+  0.035166023524553984272055668515,
+  0.026192186880710567449383235551,
+  0.015788872779215423952826797363,
+  0.005660867725095312756491752589
+};
+
+/** Weights of the 63 point Patterson rule at the nodes added by the 31 point rule */
+static const double_t patterson_63_wi_31[NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT] = {
+  0.001803939389445907328564786148,
+  0.010519600488254708542550823156,
+  0.021096745715199243564092531115,
+  0.030910992205938984343763578652,
+  0.038937673364353656897663986246,
+  0.045130900978520531207843398041,
+  0.049598428775219425281144054260,
+  0.052049977691713990512535540116,
+  0.052049977691713990512535540116,
+  0.049598428775219425281144054260,
+  0.045130900978520531207843398041,
+  0.038937673364353656897663986246,
+  0.030910992205938984343763578652,
+  0.021096745715199243564092531115,
+  0.010519600488254708542550823156,
+  0.001803939389445907328564786148
+};
+
+/** Weights of the 63 point Patterson rule at its new nodes */
+static const double_t patterson_63_wi[NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT] = {
+  0.000539407286658021770227282651,
+  0.003557740557132036398470433187,
+  0.008008877528118372921808738833,
+  0.013129713474427210902904437075,
+  0.018455916099884639803929444220,
+  0.023683152580752000205659558914,
+  0.028605857490498295943818272429,
+  0.033099092907400232260095420549,
+  0.037111404910397191759135754167,
+  0.040648875788571024107184933446,
+  0.043742748418925043826302908633,
+  0.046413730813032435147882814992,
+  0.048652555041851185680857155266,
+  0.050419337829027882637267417252,
+  0.051653256012700288788277931665,
+  0.052290832457614024465476569517,
+  0.052290832457614024465476569517,
+  0.051653256012700288788277931665,
+  0.050419337829027882637267417252,
+  0.048652555041851185680857155266,
+  0.046413730813032435147882814992,
+  0.043742748418925043826302908633,
+  0.040648875788571024107184933446,
+  0.037111404910397191759135754167,
+  0.033099092907400232260095420549,
+  0.028605857490498295943818272429,
+  0.023683152580752000205659558914,
+  0.018455916099884639803929444220,
+  0.013129713474427210902904437075,
+  0.008008877528118372921808738833,
+  0.003557740557132036398470433187,
+  0.000539407286658021770227282651
+};
+
 static bool is_error_within_tolerance(
   const gauss_kronrod_context_t* const pContext,
   double_t K15_integration,
@@ -109,71 +296,173 @@ static bool is_error_within_tolerance(
       pContext->tolerance));
 }
 
-static int32_t get_total_electron_content(
+/** Can the integration afford count more evaluations on top of those
+ * already done and reserved? If not, the budget is exhausted.
+ */
+static bool is_within_budget(
+  NeQuickG_integration_t* const pIntegration,
+  const size_t count) {
+
+  if ((pIntegration->settings.evaluation_max == 0) ||
+      ((pIntegration->evaluation_count +
+        pIntegration->evaluation_reserved + count) <=
+       pIntegration->settings.evaluation_max)) {
+    return true;
+  }
+  pIntegration->is_budget_exhausted = true;
+  return false;
+}
+
+/** Records an accepted sub-interval: error estimate and mesh (if any) */
+static void add_accepted_interval(
+  const gauss_kronrod_context_t* const pContext,
   NeQuickG_context_t* const pNequick_Context,
-  double_t height_km,
-  double_t* const pTotal_electron_content) {
+  double_t K15_integration,
+  double_t G7_integration) {
+
+  double_t error = fabs(K15_integration - G7_integration);
+  pNequick_Context->integration.error_estimate += error;
+
+  if (pContext->pMesh) {
+    integration_mesh_add_interval(
+      pContext->pMesh,
+      pContext->recursion_level,
+      fmin(error / fabs(K15_integration), error) / pContext->tolerance);
+  }
+}
+
+/** Evaluates the electron density at the nodes pXi of a segment.
+ * The nodes are placed first, then their electron densities are
+ * evaluated together (see #ray_slant_get_electron_densities).
+ */
+static int32_t get_electron_densities(
+  NeQuickG_context_t* const pNequick_Context,
+  const double_t mid_point,
+  const double_t half_diff,
+  const double_t* const pXi,
+  const size_t count,
+  double_t* const pElectron_density) {
+
+  double_t height_km[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+
+  size_t i;
+  for (i = 0; i < count; i++) {
+    height_km[i] = mid_point + (half_diff * pXi[i]);
+  }
+
+  pNequick_Context->integration.evaluation_count += count;
 
   if (pNequick_Context->ray.is_vertical) {
-    *pTotal_electron_content = ray_vertical_get_electron_density(
-      pNequick_Context, height_km);
+    for (i = 0; i < count; i++) {
+      pElectron_density[i] = ray_vertical_get_electron_density(
+        pNequick_Context, height_km[i]);
+    }
     return NEQUICK_OK;
   } else {
-    return ray_slant_get_electron_density(
-      pNequick_Context, height_km, pTotal_electron_content);
+    return ray_slant_get_electron_densities(
+      pNequick_Context,
+      height_km,
+      count,
+      pElectron_density);
   }
 }
 
-int32_t Gauss_Kronrod_integrate(
-  gauss_kronrod_context_t* const pContext,
+static double_t get_weighted_sum(
+  const double_t* const pElectron_density,
+  const double_t* const pWeight,
+  const size_t count) {
+
+  double_t sum = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    sum += (pElectron_density[i] * pWeight[i]);
+  }
+  return sum;
+}
+
+/** Evaluates the K15 and G7 rules between two points,
+ * both rules are reduced from the 15 densities.
+ */
+static int32_t get_K15_G7_integration(
   NeQuickG_context_t* const pNequick_Context,
   const double_t point_1_height_km,
   const double_t point_2_height_km,
-  double_t* const pResult) {
-
-  *pResult = 0.0;
+  double_t* const pElectron_density,
+  double_t* const pK15_integration,
+  double_t* const pG7_integration) {
 
   double_t mid_point = (point_1_height_km + point_2_height_km) / 2.0;
   double_t half_diff = (point_2_height_km - point_1_height_km) / 2.0;
 
-  double_t K15_integration = 0.0;
+  int32_t ret = get_electron_densities(
+    pNequick_Context,
+    mid_point,
+    half_diff,
+    xi,
+    (size_t)NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT,
+    pElectron_density);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  double_t K15_integration = get_weighted_sum(
+    pElectron_density, wi, (size_t)NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT);
+
+  // the G7 nodes are the odd K15 nodes
   double_t G7_integration = 0.0;
-  size_t G7_index = 0;
+  for (size_t i = 0; i < NEQUICK_G_JRC_KRONROD_G7_POINT_COUNT; i++) {
+    G7_integration += (pElectron_density[(2 * i) + 1] * wig[i]);
+  }
 
-  size_t i;
-  for (i = 0; i < NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT; i++) {
+  *pK15_integration = K15_integration * half_diff;
+  *pG7_integration = G7_integration * half_diff;
+  return NEQUICK_OK;
+}
 
-    double_t height_km = mid_point + (half_diff * xi[i]);
+int32_t Gauss_Kronrod_integrate(
+  gauss_kronrod_context_t* const pContext,
+  NeQuickG_context_t* const pNequick_Context,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pResult) {
 
-    double_t total_electron_content;
-    int32_t ret =
-      get_total_electron_content(
-        pNequick_Context, height_km, &total_electron_content);
-    if (ret != NEQUICK_OK) {
-      return ret;
-    }
+  *pResult = 0.0;
 
-    K15_integration += (total_electron_content * wi[i]);
+  double_t half_diff = (point_2_height_km - point_1_height_km) / 2.0;
 
-    if (IS_ODD(i)) {
-      G7_integration += (total_electron_content * wig[G7_index]);
-      G7_index++;
-    }
+  double_t electron_density[NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT];
+  double_t K15_integration;
+  double_t G7_integration;
+
+  int32_t ret = get_K15_G7_integration(
+    pNequick_Context,
+    point_1_height_km,
+    point_2_height_km,
+    electron_density,
+    &K15_integration,
+    &G7_integration);
+  if (ret != NEQUICK_OK) {
+    return ret;
   }
 
-  K15_integration *= half_diff;
-  G7_integration *= half_diff;
+  NeQuickG_integration_t* const pIntegration = &pNequick_Context->integration;
 
   if (is_error_within_tolerance(
     pContext,
     K15_integration,
     G7_integration)) {
 
+    add_accepted_interval(
+      pContext, pNequick_Context, K15_integration, G7_integration);
     *pResult = K15_integration;
     return NEQUICK_OK;
 
-  } else if (pContext->recursion_level == pContext->recursion_max) {
+  } else if ((pContext->recursion_level == pContext->recursion_max) ||
+             !is_within_budget(
+               pIntegration,
+               2 * NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT)) {
 
+    add_accepted_interval(
+      pContext, pNequick_Context, K15_integration, G7_integration);
     *pResult = K15_integration;
     return NEQUICK_OK;
 
@@ -186,14 +475,16 @@ int32_t Gauss_Kronrod_integrate(
 
     double_t result;
 
-    int32_t ret;
-
+    // the first rule of the second part is set aside
+    // while the first part is refined
+    pIntegration->evaluation_reserved += NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT;
     ret = Gauss_Kronrod_integrate(
       pContext,
       pNequick_Context,
       point_1_height_km,
       point_1_height_km + half_diff,
       pResult);
+    pIntegration->evaluation_reserved -= NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT;
     if (ret != NEQUICK_OK) {
       return ret;
     }
@@ -213,8 +504,466 @@ int32_t Gauss_Kronrod_integrate(
   }
 }
 
+/** The sub-interval at position (fraction of the segment) and depth
+ * and the next one are the two halves of the same parent,
+ * both with an error far below the tolerance
+ */
+static bool is_mesh_coarsening(
+  const integration_mesh_interval_t* const pInterval,
+  const size_t remaining_count,
+  const double_t position) {
+
+  if ((remaining_count < 2) ||
+      (pInterval[0].depth == 0) ||
+      (pInterval[1].depth != pInterval[0].depth)) {
+    return false;
+  }
+
+  // a left child starts at an even multiple of its length,
+  // the positions are exact binary fractions
+  uint64_t index = (uint64_t)ldexp(position, (int)pInterval[0].depth);
+  if ((index % 2) != 0) {
+    return false;
+  }
+
+  return (
+    (pInterval[0].error_ratio < NEQUICK_G_JRC_KRONROD_MESH_COARSEN_RATIO) &&
+    (pInterval[1].error_ratio < NEQUICK_G_JRC_KRONROD_MESH_COARSEN_RATIO));
+}
+
+int32_t Gauss_Kronrod_integrate_mesh(
+  gauss_kronrod_context_t* const pContext,
+  NeQuickG_context_t* const pNequick_Context,
+  const integration_mesh_interval_t* const pInterval,
+  const size_t interval_count,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pResult) {
+
+  *pResult = 0.0;
+
+  NeQuickG_integration_t* const pIntegration = &pNequick_Context->integration;
+
+  // the previous mesh may come from a deeper recursion limit
+  bool is_cold_start = (interval_count == 0);
+  for (size_t i = 0; i < interval_count; i++) {
+    if (pInterval[i].depth > pContext->recursion_max) {
+      is_cold_start = true;
+    }
+  }
+
+  // or need more than the evaluations left
+  if ((pIntegration->settings.evaluation_max != 0) &&
+      ((pIntegration->evaluation_count + pIntegration->evaluation_reserved +
+        (interval_count * NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT)) >
+       pIntegration->settings.evaluation_max)) {
+    is_cold_start = true;
+  }
+
+  if (is_cold_start) {
+    pContext->recursion_level = 0;
+    return Gauss_Kronrod_integrate(
+      pContext,
+      pNequick_Context,
+      point_1_height_km,
+      point_2_height_km,
+      pResult);
+  }
+
+  double_t length_km = point_2_height_km - point_1_height_km;
+  // start of the current sub-interval as a fraction of the segment
+  double_t position = 0.0;
+
+  size_t i = 0;
+  while (i < interval_count) {
+    size_t depth = pInterval[i].depth;
+    if (is_mesh_coarsening(&pInterval[i], interval_count - i, position)) {
+      depth--;
+      i += 2;
+    } else {
+      i++;
+    }
+
+    double_t start_height_km = point_1_height_km + (position * length_km);
+    position += ldexp(1.0, -(int)depth);
+    double_t end_height_km =
+      (i == interval_count) ?
+        point_2_height_km :
+        point_1_height_km + (position * length_km);
+
+    pContext->recursion_level = depth;
+
+    // the first rule of each remaining sub-interval is set aside
+    size_t reserved =
+      (interval_count - i) * NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT;
+
+    double_t result;
+    pIntegration->evaluation_reserved += reserved;
+    int32_t ret = Gauss_Kronrod_integrate(
+      pContext,
+      pNequick_Context,
+      start_height_km,
+      end_height_km,
+      &result);
+    pIntegration->evaluation_reserved -= reserved;
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+    *pResult += result;
+  }
+
+  pContext->recursion_level = 0;
+  return NEQUICK_OK;
+}
+
+size_t Gauss_Kronrod_get_fixed_nodes(
+  const integration_mesh_interval_t* const pInterval,
+  const size_t interval_count,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pHeight_km,
+  double_t* const pWeight) {
+
+  double_t length_km = point_2_height_km - point_1_height_km;
+  // start of the current sub-interval as a fraction of the segment
+  double_t position = 0.0;
+  size_t count = 0;
+
+  size_t i = 0;
+  do {
+    double_t start_height_km = point_1_height_km + (position * length_km);
+    double_t end_height_km = point_2_height_km;
+    if (i < interval_count) {
+      position += ldexp(1.0, -(int)pInterval[i].depth);
+      if ((i + 1) < interval_count) {
+        end_height_km = point_1_height_km + (position * length_km);
+      }
+    }
+
+    double_t mid_point = (start_height_km + end_height_km) / 2.0;
+    double_t half_diff = (end_height_km - start_height_km) / 2.0;
+    for (size_t j = 0; j < NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT; j++) {
+      pHeight_km[count] = mid_point + (half_diff * xi[j]);
+      pWeight[count] = half_diff * wi[j];
+      count++;
+    }
+    i++;
+  } while (i < interval_count);
+
+  return count;
+}
+
+int32_t Gauss_Kronrod_Patterson_integrate(
+  gauss_kronrod_context_t* const pContext,
+  NeQuickG_context_t* const pNequick_Context,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pResult) {
+
+  *pResult = 0.0;
+
+  double_t mid_point = (point_1_height_km + point_2_height_km) / 2.0;
+  double_t half_diff = (point_2_height_km - point_1_height_km) / 2.0;
+
+  double_t K15_density[NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT];
+  double_t K15_integration;
+  double_t G7_integration;
+
+  int32_t ret = get_K15_G7_integration(
+    pNequick_Context,
+    point_1_height_km,
+    point_2_height_km,
+    K15_density,
+    &K15_integration,
+    &G7_integration);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  double_t integration = K15_integration;
+  bool is_within_tolerance = is_error_within_tolerance(
+    pContext, K15_integration, G7_integration);
+
+  NeQuickG_integration_t* const pIntegration = &pNequick_Context->integration;
+  double_t error = fabs(K15_integration - G7_integration);
+
+  // extend the rule before splitting the segment
+  if (!is_within_tolerance &&
+      is_within_budget(
+        pIntegration, NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT)) {
+    double_t P31_density[NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT];
+    ret = get_electron_densities(
+      pNequick_Context,
+      mid_point,
+      half_diff,
+      patterson_31_xi,
+      (size_t)NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT,
+      P31_density);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+
+    double_t P31_integration = half_diff * (
+      get_weighted_sum(
+        K15_density,
+        patterson_31_wi_K15,
+        (size_t)NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT) +
+      get_weighted_sum(
+        P31_density,
+        patterson_31_wi,
+        (size_t)NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT));
+
+    integration = P31_integration;
+    error = fabs(P31_integration - K15_integration);
+    is_within_tolerance = is_error_within_tolerance(
+      pContext, P31_integration, K15_integration);
+
+    if (!is_within_tolerance &&
+        is_within_budget(
+          pIntegration, NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT)) {
+      double_t P63_density[NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT];
+      ret = get_electron_densities(
+        pNequick_Context,
+        mid_point,
+        half_diff,
+        patterson_63_xi,
+        (size_t)NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT,
+        P63_density);
+      if (ret != NEQUICK_OK) {
+        return ret;
+      }
+
+      integration = half_diff * (
+        get_weighted_sum(
+          K15_density,
+          patterson_63_wi_K15,
+          (size_t)NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT) +
+        get_weighted_sum(
+          P31_density,
+          patterson_63_wi_31,
+          (size_t)NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT) +
+        get_weighted_sum(
+          P63_density,
+          patterson_63_wi,
+          (size_t)NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT));
+
+      error = fabs(integration - P31_integration);
+      is_within_tolerance = is_error_within_tolerance(
+        pContext, integration, P31_integration);
+    }
+  }
+
+  if (is_within_tolerance ||
+      (pContext->recursion_level == pContext->recursion_max) ||
+      !is_within_budget(
+        pIntegration, 2 * NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT)) {
+    pIntegration->error_estimate += error;
+    *pResult = integration;
+    return NEQUICK_OK;
+  }
+
+  // Error still not acceptable with 63 pts
+  // split into two parts and try again.
+  pContext->recursion_level++;
+
+  double_t result;
+
+  pIntegration->evaluation_reserved += NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT;
+  ret = Gauss_Kronrod_Patterson_integrate(
+    pContext,
+    pNequick_Context,
+    point_1_height_km,
+    point_1_height_km + half_diff,
+    pResult);
+  pIntegration->evaluation_reserved -= NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT;
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  ret = Gauss_Kronrod_Patterson_integrate(
+    pContext,
+    pNequick_Context,
+    point_1_height_km + half_diff,
+    point_2_height_km,
+    &result);
+
+  *pResult += result;
+
+  pContext->recursion_level--;
+
+  return ret;
+}
+
+/** Sub-interval of the global adaptive integration */
+typedef struct gauss_kronrod_interval_st {
+  double_t point_1_height_km;
+  double_t point_2_height_km;
+  /** K15 estimate of the integral on the sub-interval */
+  double_t K15_integration;
+  /** |K15 - G7| error estimate on the sub-interval */
+  double_t error;
+} gauss_kronrod_interval_t;
+
+static void swap_intervals(
+  gauss_kronrod_interval_t* const pInterval_1,
+  gauss_kronrod_interval_t* const pInterval_2) {
+  gauss_kronrod_interval_t temp = *pInterval_1;
+  *pInterval_1 = *pInterval_2;
+  *pInterval_2 = temp;
+}
+
+/** Pushes an interval in the max-heap ordered by error estimate */
+static void heap_push(
+  gauss_kronrod_interval_t* const pHeap,
+  size_t* const pCount,
+  const gauss_kronrod_interval_t* const pInterval) {
+
+  size_t child = (*pCount)++;
+  pHeap[child] = *pInterval;
+
+  while (child > 0) {
+    size_t parent = (child - 1) / 2;
+    if (!(pHeap[child].error > pHeap[parent].error)) {
+      break;
+    }
+    swap_intervals(&pHeap[child], &pHeap[parent]);
+    child = parent;
+  }
+}
+
+/** Pops the interval with the largest error estimate */
+static void heap_pop(
+  gauss_kronrod_interval_t* const pHeap,
+  size_t* const pCount,
+  gauss_kronrod_interval_t* const pInterval) {
+
+  *pInterval = pHeap[0];
+  pHeap[0] = pHeap[--(*pCount)];
+
+  size_t parent = 0;
+  for (;;) {
+    size_t largest = parent;
+    size_t left = (2 * parent) + 1;
+    size_t right = left + 1;
+    if ((left < *pCount) && (pHeap[left].error > pHeap[largest].error)) {
+      largest = left;
+    }
+    if ((right < *pCount) && (pHeap[right].error > pHeap[largest].error)) {
+      largest = right;
+    }
+    if (largest == parent) {
+      break;
+    }
+    swap_intervals(&pHeap[parent], &pHeap[largest]);
+    parent = largest;
+  }
+}
+
+static int32_t get_interval(
+  NeQuickG_context_t* const pNequick_Context,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  gauss_kronrod_interval_t* const pInterval) {
+
+  double_t electron_density[NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT];
+  double_t G7_integration;
+
+  pInterval->point_1_height_km = point_1_height_km;
+  pInterval->point_2_height_km = point_2_height_km;
+
+  int32_t ret = get_K15_G7_integration(
+    pNequick_Context,
+    point_1_height_km,
+    point_2_height_km,
+    electron_density,
+    &pInterval->K15_integration,
+    &G7_integration);
+
+  pInterval->error = fabs(pInterval->K15_integration - G7_integration);
+  return ret;
+}
+
+int32_t Gauss_Kronrod_integrate_global(
+  const gauss_kronrod_context_t* const pContext,
+  NeQuickG_context_t* const pNequick_Context,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pResult) {
+
+  *pResult = 0.0;
+
+  gauss_kronrod_interval_t heap[NEQUICK_G_JRC_KRONROD_INTERVAL_COUNT_MAX];
+  size_t count = 0;
+
+  gauss_kronrod_interval_t interval;
+  int32_t ret = get_interval(
+    pNequick_Context,
+    point_1_height_km,
+    point_2_height_km,
+    &interval);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+  heap_push(heap, &count, &interval);
+
+  double_t result = interval.K15_integration;
+  double_t error = interval.error;
+
+  // each split replaces one interval by its two halves
+  while (!((error <= (pContext->tolerance * fabs(result))) ||
+           (error <= pContext->tolerance)) &&
+         (count < NEQUICK_G_JRC_KRONROD_INTERVAL_COUNT_MAX) &&
+         is_within_budget(
+           &pNequick_Context->integration,
+           2 * NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT)) {
+
+    heap_pop(heap, &count, &interval);
+
+    double_t mid_point =
+      (interval.point_1_height_km + interval.point_2_height_km) / 2.0;
+
+    gauss_kronrod_interval_t left;
+    ret = get_interval(
+      pNequick_Context,
+      interval.point_1_height_km,
+      mid_point,
+      &left);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+
+    gauss_kronrod_interval_t right;
+    ret = get_interval(
+      pNequick_Context,
+      mid_point,
+      interval.point_2_height_km,
+      &right);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+
+    heap_push(heap, &count, &left);
+    heap_push(heap, &count, &right);
+
+    result += (left.K15_integration + right.K15_integration) -
+      interval.K15_integration;
+    error += (left.error + right.error) - interval.error;
+  }
+
+  // sum again to get rid of the rounding of the running total
+  for (size_t i = 0; i < count; i++) {
+    *pResult += heap[i].K15_integration;
+    pNequick_Context->integration.error_estimate += heap[i].error;
+  }
+  return NEQUICK_OK;
+}
+
+#undef NEQUICK_G_JRC_KRONROD_MESH_COARSEN_RATIO
+
 #undef NEQUICK_G_JRC_KRONROD_K15_POINT_COUNT
 #undef NEQUICK_G_JRC_KRONROD_G7_POINT_COUNT
+#undef NEQUICK_G_JRC_PATTERSON_31_NEW_POINT_COUNT
+#undef NEQUICK_G_JRC_PATTERSON_63_NEW_POINT_COUNT
 
 #undef NEQUICK_G_JRC_KRONROD_POINT_1
 #undef NEQUICK_G_JRC_KRONROD_POINT_2
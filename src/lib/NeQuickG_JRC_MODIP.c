@@ -13,13 +13,12 @@
 #include <assert.h>
 
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-int32_t modip_init(
+void modip_init(
   modip_context_t* const pContext,
-  const char* const pModip_file) {
-  assert(pModip_file);
-  return modip_grid_init(
-    pModip_file,
-    &pContext->grid);
+  const modip_grid_t* const pGrid) {
+  assert(pGrid);
+  assert(pGrid->is_loaded);
+  pContext->pGrid = pGrid;
 }
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
@@ -57,5 +56,28 @@ void modip_get(
 
   // otherwise interpolate using the grid
   modip_grid_interpolate(
-    &pContext->grid, pPosition, &pContext->modip_degree);
+    pContext->pGrid, pPosition, &pContext->modip_degree);
+}
+
+void modip_get_dual(
+  const modip_context_t* const pContext,
+  const position_t* const pPosition,
+  NeQuickG_dual_t* const pModip_degree) {
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+  (void)pContext;
+#endif // FTR_MODIP_CCIR_AS_CONSTANTS
+
+  if (pPosition->latitude.degree <=
+      NEQUICK_G_JRC_LAT_MIN_VALUE_DEGREE) {
+    *pModip_degree =
+      NeQuickG_dual_constant(NEQUICK_G_JRC_LAT_MIN_VALUE_DEGREE);
+  } else if (pPosition->latitude.degree >=
+      NEQUICK_G_JRC_LAT_MAX_VALUE_DEGREE) {
+    *pModip_degree =
+      NeQuickG_dual_constant(NEQUICK_G_JRC_LAT_MAX_VALUE_DEGREE);
+  } else {
+    modip_grid_interpolate_dual(
+      pContext->pGrid, pPosition, pModip_degree);
+  }
 }
@@ -210,20 +210,19 @@ static void grid_get_lat_position(
 }
 
 #ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define grid_get_lat_interpol_points(pGrid, pLatitude, longitude_grid_index, pPoints) \
+  grid_get_lat_interpol_points(pLatitude, longitude_grid_index, pPoints)
 #define grid_get_lon_interpol_point(pGrid, pLatitude, longitude_grid_index) \
   grid_get_lon_interpol_point(pLatitude, longitude_grid_index)
+#define grid_get_lon_interpol_point_derivative(pGrid, pLatitude, longitude_grid_index) \
+  grid_get_lon_interpol_point_derivative(pLatitude, longitude_grid_index)
 #endif
 
-/**
- * Interpolate across lat grid
- */
-static double_t
-grid_get_lon_interpol_point(
+static void grid_get_lat_interpol_points(
   const modip_grid_t* const pGrid,
   const grid_position_t* const pLatitude,
-  uint_fast8_t longitude_grid_index) {
-  double_t
-    lat_interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+  uint_fast8_t longitude_grid_index,
+  double_t lat_interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT]) {
   size_t lat_grid_index = pLatitude->index;
   for (size_t i = 0;
         i < NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT; i++) {
@@ -236,11 +235,43 @@ grid_get_lon_interpol_point(
         [lat_grid_index++]
         [longitude_grid_index];
   }
+}
+
+/**
+ * Interpolate across lat grid
+ */
+static double_t
+grid_get_lon_interpol_point(
+  const modip_grid_t* const pGrid,
+  const grid_position_t* const pLatitude,
+  uint_fast8_t longitude_grid_index) {
+  double_t
+    lat_interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+  grid_get_lat_interpol_points(
+    pGrid, pLatitude, longitude_grid_index, lat_interpol_points);
   return interpolation_third_order(
     lat_interpol_points,
     pLatitude->offset);
 }
 
+/**
+ * Derivative of the interpolation across lat grid
+ * with respect to the latitude offset
+ */
+static double_t
+grid_get_lon_interpol_point_derivative(
+  const modip_grid_t* const pGrid,
+  const grid_position_t* const pLatitude,
+  uint_fast8_t longitude_grid_index) {
+  double_t
+    lat_interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+  grid_get_lat_interpol_points(
+    pGrid, pLatitude, longitude_grid_index, lat_interpol_points);
+  return interpolation_third_order_derivative(
+    lat_interpol_points,
+    pLatitude->offset);
+}
+
 #ifdef FTR_MODIP_CCIR_AS_CONSTANTS
 #define grid_2D_interpolation(pGrid, pLongitude, pLatitude) \
   grid_2D_interpolation(pLongitude, pLatitude)
@@ -282,4 +313,40 @@ void modip_grid_interpolate(
   *pModip_degree = grid_2D_interpolation(pGrid, &longitude, &latitude);
 }
 
+void modip_grid_interpolate_dual(
+  const modip_grid_t* const pGrid,
+  const position_t* const pPosition,
+  NeQuickG_dual_t* const pModip_degree) {
+
+  grid_position_t longitude;
+  grid_get_long_position(pPosition->longitude.degree, &longitude);
+
+  grid_position_t latitude;
+  grid_get_lat_position(pPosition->latitude.degree, &latitude);
+
+  double_t
+    lon_interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+  double_t
+    lon_interpol_derivatives[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+
+  for (size_t i = 0;
+        i < NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT; i++) {
+    lon_interpol_points[i] = grid_get_lon_interpol_point(
+                              pGrid, &latitude, longitude.index);
+    lon_interpol_derivatives[i] = grid_get_lon_interpol_point_derivative(
+                              pGrid, &latitude, longitude.index);
+    longitude.index++;
+  }
+
+  *pModip_degree = NeQuickG_dual_constant(
+    interpolation_third_order(lon_interpol_points, longitude.offset));
+  pModip_degree->d[NEQUICKG_DUAL_PARTIAL_LATITUDE] =
+    interpolation_third_order(lon_interpol_derivatives, longitude.offset) /
+    NEQUICK_G_JRC_MODIP_GRID_LAT_STEP_DEGREE;
+  pModip_degree->d[NEQUICKG_DUAL_PARTIAL_LONGITUDE] =
+    interpolation_third_order_derivative(
+      lon_interpol_points, longitude.offset) /
+    NEQUICK_G_JRC_MODIP_GRID_LONG_STEP_DEGREE;
+}
+
 #undef NEQUICK_G_JRC_MODIP_GRID_LONG_UNIQUE_COUNT
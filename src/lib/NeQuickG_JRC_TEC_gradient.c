@@ -0,0 +1,467 @@
+/** NeQuickG partial derivatives of the Slant Total Electron Content (STEC).
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_TEC_gradient.h"
+
+#include <string.h>
+
+#include "NeQuickG_JRC_electron_density.h"
+#include "NeQuickG_JRC_Gauss_Kronrod_integration.h"
+#include "NeQuickG_JRC_geometry.h"
+#include "NeQuickG_JRC_macros.h"
+#include "NeQuickG_JRC_MODIP.h"
+#include "NeQuickG_JRC_ray_slant.h"
+#include "NeQuickG_JRC_ray_vertical.h"
+#include "NeQuickG_JRC_solar_activity.h"
+#include "NeQuickG_JRC_TEC_integration.h"
+
+/** Sub-intervals of the ray when the integration mesh could not be kept */
+#define NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_INTERVAL_COUNT (64)
+/** Recursion level of the sub-intervals of
+ * #NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_INTERVAL_COUNT
+ */
+#define NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_DEPTH (6)
+/** Maximum number of nodes of a segment */
+#define NEQUICK_G_JRC_TEC_GRADIENT_NODE_COUNT_MAX \
+  (NEQUICK_G_JRC_MESH_INTERVAL_COUNT_MAX * \
+   NEQUICK_G_JRC_KRONROD_SEGMENT_EVALUATION_COUNT)
+
+/** Index of the receiver coordinates in NeQuickG_TEC_gradient_t.receiver */
+#define NEQUICK_G_JRC_TEC_GRADIENT_LATITUDE (0)
+#define NEQUICK_G_JRC_TEC_GRADIENT_LONGITUDE (1)
+#define NEQUICK_G_JRC_TEC_GRADIENT_HEIGHT (2)
+
+/** Earth-centred cartesian coordinates */
+#define NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT (3)
+
+/** Local frame of a position, Earth-centred unit vectors */
+typedef struct TEC_gradient_frame_st {
+  /** towards the zenith */
+  double_t up[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  /** towards the north */
+  double_t north[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  /** towards the east */
+  double_t east[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+} TEC_gradient_frame_t;
+
+/** Straight line from the receiver to the satellite */
+typedef struct TEC_gradient_line_st {
+  /** receiver, Earth-centred in km */
+  double_t receiver_km[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  /** unit vector from the receiver to the satellite */
+  double_t direction[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  /** distance from the receiver to the satellite in km */
+  double_t length_km;
+} TEC_gradient_line_t;
+
+/** Weighted sums of the derivative pass */
+typedef struct TEC_gradient_sum_st {
+  /** d(STEC)/d(Az) in km/m<SUP>3</SUP>/sfu */
+  double_t Az;
+  /** d(STEC)/d(receiver), Earth-centred, in 1/m<SUP>3</SUP> */
+  double_t receiver[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+} TEC_gradient_sum_t;
+
+static void get_frame(
+  const position_t* const pPosition,
+  TEC_gradient_frame_t* const pFrame) {
+
+  const angle_t* const pLatitude = &pPosition->latitude;
+  const angle_t* const pLongitude = &pPosition->longitude;
+
+  pFrame->up[0] = pLatitude->cos * pLongitude->cos;
+  pFrame->up[1] = pLatitude->cos * pLongitude->sin;
+  pFrame->up[2] = pLatitude->sin;
+
+  pFrame->north[0] = -pLatitude->sin * pLongitude->cos;
+  pFrame->north[1] = -pLatitude->sin * pLongitude->sin;
+  pFrame->north[2] = pLatitude->cos;
+
+  pFrame->east[0] = -pLongitude->sin;
+  pFrame->east[1] = pLongitude->cos;
+  pFrame->east[2] = 0.0;
+}
+
+static double_t get_dot_product(
+  const double_t* const pA,
+  const double_t* const pB) {
+
+  double_t sum = 0.0;
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    sum += (pA[i] * pB[i]);
+  }
+  return sum;
+}
+
+/** Spherical Earth as in the model: radius along the zenith */
+static void get_earth_centred(
+  const position_t* const pPosition,
+  const TEC_gradient_frame_t* const pFrame,
+  double_t* const pPoint_km) {
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    pPoint_km[i] = pPosition->radius_km * pFrame->up[i];
+  }
+}
+
+/** The positions of the input data: the receiver latitude of a slant ray
+ * is replaced by the ray perigee latitude
+ */
+static void get_line(
+  const input_data_t* const pInput_data,
+  TEC_gradient_line_t* const pLine) {
+
+  TEC_gradient_frame_t frame;
+  get_frame(&pInput_data->station_position, &frame);
+  get_earth_centred(&pInput_data->station_position, &frame, pLine->receiver_km);
+
+  double_t satellite_km[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  get_frame(&pInput_data->satellite_position, &frame);
+  get_earth_centred(&pInput_data->satellite_position, &frame, satellite_km);
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    pLine->direction[i] = satellite_km[i] - pLine->receiver_km[i];
+  }
+  pLine->length_km = sqrt(get_dot_product(pLine->direction, pLine->direction));
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    pLine->direction[i] /= pLine->length_km;
+  }
+}
+
+/** Electron density at a point of the ray with its derivatives, the
+ * vertical profile is the same for all the points of a vertical ray
+ */
+static int32_t get_electron_density(
+  NeQuickG_context_t* const pContext,
+  iono_profile_dual_t* const pVertical_profile,
+  const double_t point_km,
+  position_t* const pPosition,
+  NeQuickG_dual_t* const pElectron_density) {
+
+  if (!pContext->ray.is_vertical) {
+    return ray_slant_get_electron_density_dual(
+      pContext, point_km, pPosition, pElectron_density);
+  }
+
+  *pPosition = pContext->input_data.station_position;
+  pPosition->height = point_km;
+  pPosition->radius_km = get_radius_from_height(point_km);
+
+  NeQuickG_dual_t height =
+    NeQuickG_dual_variable(point_km, NEQUICKG_DUAL_PARTIAL_HEIGHT);
+  *pElectron_density = electron_density_get_dual(pVertical_profile, &height);
+  return NEQUICK_OK;
+}
+
+/** Position of a point of the ray relative to the receiver:
+ * 0 at the receiver, 1 at the satellite
+ */
+static double_t get_line_fraction(
+  const TEC_gradient_line_t* const pLine,
+  const double_t* const pPoint_km) {
+
+  double_t offset_km[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    offset_km[i] = pPoint_km[i] - pLine->receiver_km[i];
+  }
+  return get_dot_product(offset_km, pLine->direction) / pLine->length_km;
+}
+
+/** A point X = R + t(S - R) of the ray follows the receiver R with a
+ * factor 1 - t: adds w(1 - t) grad(Ne) and w d(Ne)/d(Az)
+ */
+static void add_node(
+  const TEC_gradient_line_t* const pLine,
+  const position_t* const pPosition,
+  const NeQuickG_dual_t* const pElectron_density,
+  const double_t weight_km,
+  TEC_gradient_sum_t* const pSum) {
+
+  TEC_gradient_frame_t frame;
+  get_frame(pPosition, &frame);
+
+  double_t point_km[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  get_earth_centred(pPosition, &frame, point_km);
+
+  // d(Ne)/d(km) along the local frame
+  double_t up = pElectron_density->d[NEQUICKG_DUAL_PARTIAL_HEIGHT];
+  double_t north =
+    (pElectron_density->d[NEQUICKG_DUAL_PARTIAL_LATITUDE] *
+      NEQUICK_G_JRC_RADIAN_TO_DEGREE) / pPosition->radius_km;
+  double_t east = 0.0;
+  if (pPosition->latitude.cos > 0.0) {
+    east =
+      (pElectron_density->d[NEQUICKG_DUAL_PARTIAL_LONGITUDE] *
+        NEQUICK_G_JRC_RADIAN_TO_DEGREE) /
+      (pPosition->radius_km * pPosition->latitude.cos);
+  }
+
+  double_t factor = weight_km * (1.0 - get_line_fraction(pLine, point_km));
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    pSum->receiver[i] += factor *
+      ((up * frame.up[i]) + (north * frame.north[i]) + (east * frame.east[i]));
+  }
+  pSum->Az += weight_km * pElectron_density->d[NEQUICKG_DUAL_PARTIAL_AZ];
+}
+
+/** A receiver below the ground moves the start of the path at height 0:
+ * adds Ne(A)(1 - t<SUB>A</SUB>) A / (A.u)
+ */
+static int32_t add_start_point(
+  NeQuickG_context_t* const pContext,
+  iono_profile_dual_t* const pVertical_profile,
+  const TEC_gradient_line_t* const pLine,
+  const double_t point_km,
+  TEC_gradient_sum_t* const pSum) {
+
+  position_t position;
+  NeQuickG_dual_t electron_density;
+  int32_t ret = get_electron_density(
+    pContext, pVertical_profile, point_km, &position, &electron_density);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+  pContext->integration.evaluation_count++;
+
+  TEC_gradient_frame_t frame;
+  get_frame(&position, &frame);
+  double_t start_km[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  get_earth_centred(&position, &frame, start_km);
+
+  double_t projection_km = get_dot_product(start_km, pLine->direction);
+  if (!(projection_km > 0.0)) {
+    return NEQUICK_OK;
+  }
+
+  double_t factor =
+    (electron_density.value * (1.0 - get_line_fraction(pLine, start_km))) /
+    projection_km;
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    pSum->receiver[i] += factor * start_km[i];
+  }
+  return NEQUICK_OK;
+}
+
+/** Adds the K<SUB>15</SUB> nodes of the sub-intervals of a segment,
+ * see #Gauss_Kronrod_get_fixed_nodes
+ */
+static int32_t add_segment(
+  NeQuickG_context_t* const pContext,
+  iono_profile_dual_t* const pVertical_profile,
+  const TEC_gradient_line_t* const pLine,
+  const integration_mesh_interval_t* const pInterval,
+  const integration_mesh_segment_t* const pSegment,
+  TEC_gradient_sum_t* const pSum) {
+
+  double_t point_km[NEQUICK_G_JRC_TEC_GRADIENT_NODE_COUNT_MAX];
+  double_t weight_km[NEQUICK_G_JRC_TEC_GRADIENT_NODE_COUNT_MAX];
+  size_t count = Gauss_Kronrod_get_fixed_nodes(
+    pInterval,
+    pSegment->interval_count,
+    pSegment->point_1_km,
+    pSegment->point_2_km,
+    point_km,
+    weight_km);
+
+  pContext->integration.evaluation_count += count;
+
+  for (size_t i = 0; i < count; i++) {
+    position_t position;
+    NeQuickG_dual_t electron_density;
+    int32_t ret = get_electron_density(
+      pContext, pVertical_profile, point_km[i], &position, &electron_density);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+    add_node(pLine, &position, &electron_density, weight_km[i], pSum);
+  }
+  return NEQUICK_OK;
+}
+
+/** Derivative pass: the nodes of the final sub-intervals of the integration,
+ * or a uniform partition of the ray if they could not be kept
+ */
+static int32_t get_sums(
+  NeQuickG_context_t* const pContext,
+  const integration_mesh_t* const pMesh,
+  const TEC_gradient_line_t* const pLine,
+  TEC_gradient_sum_t* const pSum) {
+
+  iono_profile_dual_t vertical_profile;
+  if (pContext->ray.is_vertical) {
+    int32_t ret = ray_vertical_get_profile_dual(pContext, &vertical_profile);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+  }
+
+  // the path starts at the receiver or at height 0 below the ground
+  double_t start_height_km =
+    max(0.0, pContext->input_data.station_position.height);
+  double_t start_km = pContext->ray.is_vertical ?
+    start_height_km :
+    get_slant_distance(&pContext->ray, get_radius_from_height(start_height_km));
+  double_t end_km = pContext->ray.is_vertical ?
+    pContext->ray.satellite_position.height :
+    pContext->ray.slant.satellite_distance_km;
+  if (!(end_km > start_km)) {
+    return NEQUICK_OK;
+  }
+
+  int32_t ret = NEQUICK_OK;
+  if (pMesh->is_valid) {
+    for (size_t i = 0; (i < pMesh->segment_count) && (ret == NEQUICK_OK); i++) {
+      const integration_mesh_segment_t* const pSegment = &pMesh->segment[i];
+      ret = add_segment(
+        pContext,
+        &vertical_profile,
+        pLine,
+        &pMesh->interval[pSegment->first_interval],
+        pSegment,
+        pSum);
+    }
+  } else {
+    integration_mesh_interval_t
+      interval[NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_INTERVAL_COUNT];
+    for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_INTERVAL_COUNT; i++) {
+      interval[i].error_ratio = 0.0;
+      interval[i].depth = NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_DEPTH;
+    }
+    integration_mesh_segment_t segment;
+    segment.point_1_km = start_km;
+    segment.point_2_km = end_km;
+    segment.first_interval = 0;
+    segment.interval_count = NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_INTERVAL_COUNT;
+    ret = add_segment(
+      pContext, &vertical_profile, pLine, interval, &segment, pSum);
+  }
+
+  if ((ret == NEQUICK_OK) &&
+      (pContext->input_data.station_position.height < 0.0)) {
+    ret = add_start_point(
+      pContext, &vertical_profile, pLine, start_km, pSum);
+  }
+  return ret;
+}
+
+/** Chains the sums to the receiver coordinates and to the Az coefficients,
+ * Az follows the MODIP of the receiver
+ */
+static void get_derivatives(
+  const NeQuickG_context_t* const pContext,
+  const TEC_gradient_line_t* const pLine,
+  const TEC_gradient_sum_t* const pSum,
+  const double_t TEC,
+  NeQuickG_TEC_gradient_t* const pGradient) {
+
+  const position_t* const pReceiver = &pContext->input_data.station_position;
+
+  // the length of the ray: d(STEC)/d(R) = -u STEC/L + sum
+  double_t receiver[NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT; i++) {
+    receiver[i] = pSum->receiver[i] -
+      ((pLine->direction[i] * TEC * 1.0E13) / pLine->length_km);
+  }
+
+  TEC_gradient_frame_t frame;
+  get_frame(pReceiver, &frame);
+
+  double_t radius_km = pReceiver->radius_km;
+  double_t latitude_derivative =
+    get_dot_product(receiver, frame.north) *
+    radius_km * NEQUICK_G_JRC_DEGREE_TO_RADIAN;
+  double_t longitude_derivative =
+    get_dot_product(receiver, frame.east) *
+    radius_km * pReceiver->latitude.cos * NEQUICK_G_JRC_DEGREE_TO_RADIAN;
+  // the derivative is per meter
+  double_t height_derivative = get_dot_product(receiver, frame.up) / 1000.0;
+
+  NeQuickG_dual_t receiver_modip_degree;
+  modip_get_dual(
+    &pContext->modip,
+    &pContext->input_data.station_position,
+    &receiver_modip_degree);
+
+  double_t Az_gradient[NEQUICKG_AZ_COEFFICIENTS_COUNT];
+  solar_activity_get_effective_ionisation_level_gradient(
+    &pContext->solar_activity,
+    receiver_modip_degree.value,
+    Az_gradient);
+  for (size_t i = 0; i < NEQUICKG_AZ_COEFFICIENTS_COUNT; i++) {
+    // Eq. 151, Eq. 202 for the correction factor
+    pGradient->Az_coefficients[i] = (pSum->Az * Az_gradient[i]) / 1.0E13;
+  }
+
+  double_t Az_modip_derivative =
+    pSum->Az *
+    solar_activity_get_effective_ionisation_level_modip_derivative(
+      &pContext->solar_activity, receiver_modip_degree.value);
+  latitude_derivative += Az_modip_derivative *
+    receiver_modip_degree.d[NEQUICKG_DUAL_PARTIAL_LATITUDE];
+  longitude_derivative += Az_modip_derivative *
+    receiver_modip_degree.d[NEQUICKG_DUAL_PARTIAL_LONGITUDE];
+
+  pGradient->receiver[NEQUICK_G_JRC_TEC_GRADIENT_LATITUDE] =
+    latitude_derivative / 1.0E13;
+  pGradient->receiver[NEQUICK_G_JRC_TEC_GRADIENT_LONGITUDE] =
+    longitude_derivative / 1.0E13;
+  pGradient->receiver[NEQUICK_G_JRC_TEC_GRADIENT_HEIGHT] =
+    height_derivative / 1.0E13;
+}
+
+int32_t NeQuickG_TEC_gradient_get(
+  NeQuickG_context_t* const pContext,
+  double_t* const pTEC,
+  NeQuickG_TEC_gradient_t* const pGradient) {
+
+  memset(pGradient, 0, sizeof(*pGradient));
+
+  NeQuickG_integration_t* const pIntegration = &pContext->integration;
+
+  // only the recursion keeps its sub-intervals
+  const NeQuickG_integration_settings_t settings = pIntegration->settings;
+  pIntegration->settings.method = NEQUICKG_INTEGRATION_RECURSIVE;
+  pIntegration->settings.semi_analytic_vertical = false;
+
+  integration_mesh_t mesh;
+  memset(&mesh, 0, sizeof(mesh));
+  pIntegration->pMesh = &mesh;
+
+  NeQuickG_context_get_solar_activity(pContext);
+
+  int32_t ret = NeQuickG_context_get_slant_total_electron_content(
+    pContext, pTEC);
+
+  pIntegration->pMesh = NULL;
+
+  if (ret == NEQUICK_OK) {
+    TEC_gradient_line_t line;
+    get_line(&pContext->input_data, &line);
+
+    TEC_gradient_sum_t sum;
+    memset(&sum, 0, sizeof(sum));
+
+    ret = get_sums(pContext, &mesh, &line, &sum);
+    if (ret == NEQUICK_OK) {
+      get_derivatives(pContext, &line, &sum, *pTEC, pGradient);
+    }
+  }
+
+  pIntegration->settings = settings;
+  return ret;
+}
+
+#undef NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_INTERVAL_COUNT
+#undef NEQUICK_G_JRC_TEC_GRADIENT_FALLBACK_DEPTH
+#undef NEQUICK_G_JRC_TEC_GRADIENT_NODE_COUNT_MAX
+#undef NEQUICK_G_JRC_TEC_GRADIENT_LATITUDE
+#undef NEQUICK_G_JRC_TEC_GRADIENT_LONGITUDE
+#undef NEQUICK_G_JRC_TEC_GRADIENT_HEIGHT
+#undef NEQUICK_G_JRC_TEC_GRADIENT_AXIS_COUNT
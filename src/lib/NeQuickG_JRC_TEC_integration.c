@@ -11,11 +11,14 @@
 #include "NeQuickG_JRC_TEC_integration.h"
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
 #include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_error.h"
 #include "NeQuickG_JRC_Gauss_Kronrod_integration.h"
 #include "NeQuickG_JRC_macros.h"
+#include "NeQuickG_JRC_ray_slant.h"
 #include "NeQuickG_JRC_ray_vertical.h"
 
 #define NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM (1000.0)
@@ -30,24 +33,93 @@
  */
 #define NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_ABOVE_FIRST_POINT (0.01)
 
+/** Height where a slant ray takes the layer peak heights,
+ * about the height of the F2 layer peak
+ */
+#define NEQUICK_G_JRC_INTEGRATION_LAYER_PEAK_REFERENCE_HEIGHT_KM (300.0)
+
+/** Integration presets, indexed by preset */
+static const NeQuickG_integration_settings_t integration_presets[] = {
+  // NEQUICKG_INTEGRATION_PRESET_SPECIFICATION
+  {
+    .method = NEQUICKG_INTEGRATION_RECURSIVE,
+    .first_point_height_km = NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM,
+    .second_point_height_km = NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM,
+    .tolerance_below_first_point =
+      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_BELOW_FIRST_POINT,
+    .tolerance_above_first_point =
+      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_ABOVE_FIRST_POINT,
+    .recursion_max = NEQUICK_G_JRC_RECURSION_LIMIT_MAX,
+    .split_at_layer_peaks = false,
+    .semi_analytic_vertical = false,
+    .evaluation_max = 0,
+    .profile_anchor_count = 0
+  },
+  // NEQUICKG_INTEGRATION_PRESET_NAVIGATION
+  {
+    .method = NEQUICKG_INTEGRATION_RECURSIVE,
+    .first_point_height_km = NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM,
+    .second_point_height_km = NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM,
+    .tolerance_below_first_point = 0.01,
+    .tolerance_above_first_point = 0.05,
+    .recursion_max = 10,
+    .split_at_layer_peaks = true,
+    .semi_analytic_vertical = true,
+    .evaluation_max = 0,
+    .profile_anchor_count = 0
+  },
+  // NEQUICKG_INTEGRATION_PRESET_REFERENCE
+  {
+    .method = NEQUICKG_INTEGRATION_RECURSIVE,
+    .first_point_height_km = NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM,
+    .second_point_height_km = NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM,
+    .tolerance_below_first_point = 1.0e-5,
+    .tolerance_above_first_point = 1.0e-4,
+    .recursion_max = NEQUICK_G_JRC_RECURSION_LIMIT_MAX,
+    .split_at_layer_peaks = false,
+    .semi_analytic_vertical = false,
+    .evaluation_max = 0,
+    .profile_anchor_count = 0
+  }
+};
+
 #define IS_SATELLITE_BELOW_FIRST_POINT(_p) \
   (_p->ray.satellite_position.height <= \
-  NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM)
+   _p->integration.settings.first_point_height_km)
 
 #define IS_SATELLITE_BELOW_SECOND_POINT(_p) \
   (_p->ray.satellite_position.height <= \
-  NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM)
+   _p->integration.settings.second_point_height_km)
 
 #define IS_RECEIVER_ABOVE_FIRST_POINT(_p) \
   (_p->ray.receiver_position.height >= \
-   NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM)
+   _p->integration.settings.first_point_height_km)
 
 #define IS_RECEIVER_ABOVE_SECOND_POINT(_p) \
   (_p->ray.receiver_position.height >= \
-   NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM)
+   _p->integration.settings.second_point_height_km)
+
+int32_t NeQuickG_integration_get_preset(
+  const uint8_t preset,
+  NeQuickG_integration_settings_t* const pSettings) {
+
+  if (!pSettings) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Integration preset. null pointer exception.");
+  }
+
+  if (preset >= (sizeof(integration_presets)/sizeof(integration_presets[0]))) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS,
+      "Integration preset %u is not supported", preset);
+  }
 
-/** Kronrod G7-K15 integration maximum recursion level */
-#define NEQUICK_G_JRC_RECURSION_LIMIT_MAX (50)
+  *pSettings = integration_presets[preset];
+  return NEQUICK_OK;
+}
 
 static double_t get_point_height(
   const NeQuickG_context_t* const pContext,
@@ -67,15 +139,137 @@ static double_t get_point_zero_height(
   return get_point_height(pContext, temp);
 }
 
-static int32_t Gauss_Kronrod_integrate_impl(
+/** Gets the points of the ray at the E, F1 and F2 layer peak heights.
+ * A vertical ray uses its own profile, a slant ray the profile where it
+ * crosses #NEQUICK_G_JRC_INTEGRATION_LAYER_PEAK_REFERENCE_HEIGHT_KM.
+ * The peaks are only a hint for splitting the path, their exact position
+ * does not change the integral.
+ */
+static int32_t get_layer_peak_points(
+  NeQuickG_context_t* const pContext) {
+
+  NeQuickG_integration_t* const pIntegration = &pContext->integration;
+  pIntegration->layer_peak_point_count = 0;
+
+  if (!pContext->ray.is_vertical) {
+    double_t reference_radius_km = get_radius_from_height(
+      max(NEQUICK_G_JRC_INTEGRATION_LAYER_PEAK_REFERENCE_HEIGHT_KM,
+          pContext->ray.receiver_position.height));
+
+    // the ray does not go down to the reference height
+    if (!(reference_radius_km > pContext->ray.slant.perigee_radius_km)) {
+      return NEQUICK_OK;
+    }
+
+    int32_t ret = ray_slant_get_profile(
+      pContext,
+      get_slant_distance(&pContext->ray, reference_radius_km));
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+    pIntegration->evaluation_count++;
+  }
+
+  // hmE < hmF1 < hmF2, so the points are in ascending order
+  const double_t peak_height_km[NEQUICK_G_JRC_LAYER_PEAK_COUNT] = {
+    pContext->profile.E.layer.peak.height_km,
+    pContext->profile.F1.peak.height_km,
+    pContext->profile.F2.layer.peak.height_km
+  };
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_LAYER_PEAK_COUNT; i++) {
+    // a slant ray with its perigee above the peak does not cross it
+    if (pContext->ray.is_vertical ||
+        (get_radius_from_height(peak_height_km[i]) >
+         pContext->ray.slant.perigee_radius_km)) {
+      pIntegration->layer_peak_point_km[
+        pIntegration->layer_peak_point_count++] =
+          get_point_height(pContext, peak_height_km[i]);
+    }
+  }
+  return NEQUICK_OK;
+}
+
+/** Gets the layer peaks at the anchors of a slant ray,
+ * see NeQuickG_integration_settings_t.profile_anchor_count
+ */
+static int32_t get_profile_anchors(
+  NeQuickG_context_t* const pContext) {
+
+  pContext->profile_anchors.count = 0;
+
+  const size_t anchor_count =
+    pContext->integration.settings.profile_anchor_count;
+  if ((anchor_count == 0) || pContext->ray.is_vertical) {
+    return NEQUICK_OK;
+  }
+
+  // the part of the ray the nodes are on
+  double_t start_km = get_point_zero_height(pContext);
+  double_t end_km = pContext->ray.slant.satellite_distance_km;
+  if (!(end_km > start_km)) {
+    return NEQUICK_OK;
+  }
+
+  return ray_slant_set_profile_anchors(
+    pContext, anchor_count, start_km, end_km);
+}
+
+static int32_t Gauss_Kronrod_integrate_segment(
   gauss_kronrod_context_t* const pContext,
   NeQuickG_context_t* const pNequick_Context,
   const double_t point_1_height_km,
   const double_t point_2_height_km,
   double_t* const pTEC) {
 
+  NeQuickG_integration_t* const pIntegration = &pNequick_Context->integration;
+
+  if (pIntegration->settings.method ==
+      NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE) {
+    return Gauss_Kronrod_integrate_global(
+      pContext,
+      pNequick_Context,
+      point_1_height_km,
+      point_2_height_km,
+      pTEC);
+  }
+
   pContext->recursion_level = 0;
-  pContext->recursion_max = NEQUICK_G_JRC_RECURSION_LIMIT_MAX;
+  pContext->recursion_max = pIntegration->settings.recursion_max;
+  pContext->pMesh = NULL;
+
+  if (pIntegration->settings.method == NEQUICKG_INTEGRATION_PATTERSON) {
+    return Gauss_Kronrod_Patterson_integrate(
+      pContext,
+      pNequick_Context,
+      point_1_height_km,
+      point_2_height_km,
+      pTEC);
+  }
+
+  if (pIntegration->pMesh) {
+    // start from the same segment of the previous epoch of the link
+    const integration_mesh_segment_t* pSegment =
+      integration_mesh_get_segment(
+        pIntegration->pMesh,
+        pIntegration->next_mesh.segment_count,
+        point_1_height_km,
+        point_2_height_km);
+
+    integration_mesh_add_segment(
+      &pIntegration->next_mesh, point_1_height_km, point_2_height_km);
+    pContext->pMesh = &pIntegration->next_mesh;
+
+    return Gauss_Kronrod_integrate_mesh(
+      pContext,
+      pNequick_Context,
+      pSegment ?
+        &pIntegration->pMesh->interval[pSegment->first_interval] : NULL,
+      pSegment ? pSegment->interval_count : 0,
+      point_1_height_km,
+      point_2_height_km,
+      pTEC);
+  }
 
   return Gauss_Kronrod_integrate(
     pContext,
@@ -85,13 +279,184 @@ static int32_t Gauss_Kronrod_integrate_impl(
     pTEC);
 }
 
+/** Gets the first point the path is split at between two points:
+ * a layer peak point or a point of the partial integrals
+ *
+ * @return false if there is none
+ */
+static bool get_next_split_point(
+  const NeQuickG_integration_t* const pIntegration,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pSplit_point_km) {
+
+  double_t split_point_km = point_2_height_km;
+
+  for (size_t i = 0; i < pIntegration->layer_peak_point_count; i++) {
+    double_t point_km = pIntegration->layer_peak_point_km[i];
+    if ((point_km > point_1_height_km) && (point_km < split_point_km)) {
+      split_point_km = point_km;
+    }
+  }
+
+  const NeQuickG_integration_partial_t* const pPartial =
+    pIntegration->pPartial;
+  if (pPartial) {
+    size_t point_count = pPartial->height_count + pPartial->distance_count;
+    for (size_t i = 0; i < point_count; i++) {
+      double_t point_km = pPartial->point_km[i];
+      if ((point_km > point_1_height_km) && (point_km < split_point_km)) {
+        split_point_km = point_km;
+      }
+    }
+  }
+
+  *pSplit_point_km = split_point_km;
+  return (split_point_km < point_2_height_km);
+}
+
+/** Adds the integral of a part of the path to the points above it */
+static void add_partial_integral(
+  NeQuickG_integration_t* const pIntegration,
+  const double_t point_2_height_km,
+  const double_t TEC) {
+
+  NeQuickG_integration_partial_t* const pPartial = pIntegration->pPartial;
+  if (!pPartial) {
+    return;
+  }
+
+  size_t point_count = pPartial->height_count + pPartial->distance_count;
+  for (size_t i = 0; i < point_count; i++) {
+    if (!(point_2_height_km > pPartial->point_km[i])) {
+      pPartial->TEC_below[i] += TEC;
+    }
+  }
+}
+
+/** Gets the points of the partial integrals, see
+ * NeQuickG_integration_t.pPartial
+ */
+static void get_partial_points(
+  NeQuickG_context_t* const pContext) {
+
+  NeQuickG_integration_partial_t* const pPartial =
+    pContext->integration.pPartial;
+
+  size_t point_count = 0;
+
+  for (size_t i = 0; i < pPartial->height_count; i++) {
+    double_t height_km = pPartial->height_km[i];
+    // a slant ray with its perigee above the height does not cross it
+    pPartial->point_km[point_count++] =
+      (pContext->ray.is_vertical ||
+       (get_radius_from_height(height_km) >
+        pContext->ray.slant.perigee_radius_km)) ?
+        get_point_height(pContext, height_km) : -HUGE_VAL;
+  }
+
+  double_t receiver_point_km =
+    pContext->ray.is_vertical ?
+      pContext->ray.receiver_position.height :
+      pContext->ray.slant.receiver_distance_km;
+
+  for (size_t i = 0; i < pPartial->distance_count; i++) {
+    pPartial->point_km[point_count++] =
+      receiver_point_km + pPartial->distance_km[i];
+  }
+
+  for (size_t i = 0; i < point_count; i++) {
+    pPartial->TEC_below[i] = 0.0;
+  }
+}
+
+/** Integrates between two points, the path is split first
+ * at the layer peak points and at the points of the partial integrals
+ * inside it (if any)
+ */
+static int32_t Gauss_Kronrod_integrate_impl(
+  gauss_kronrod_context_t* const pContext,
+  NeQuickG_context_t* const pNequick_Context,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pTEC) {
+
+  NeQuickG_integration_t* const pIntegration =
+    &pNequick_Context->integration;
+
+  // the first rule of the extra segments is set aside
+  double_t split_point_km = point_1_height_km;
+  while (get_next_split_point(
+           pIntegration, split_point_km, point_2_height_km, &split_point_km)) {
+    pIntegration->evaluation_reserved +=
+      NEQUICK_G_JRC_KRONROD_SEGMENT_EVALUATION_COUNT;
+  }
+
+  double_t total_electron_content = 0.0;
+  double_t start_height_km = point_1_height_km;
+  double_t end_height_km;
+
+  do {
+    (void)get_next_split_point(
+      pIntegration, start_height_km, point_2_height_km, &end_height_km);
+
+    pIntegration->evaluation_reserved -=
+      NEQUICK_G_JRC_KRONROD_SEGMENT_EVALUATION_COUNT;
+    double_t total_electron_content_;
+    int32_t ret = Gauss_Kronrod_integrate_segment(
+      pContext,
+      pNequick_Context,
+      start_height_km,
+      end_height_km,
+      &total_electron_content_);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+    add_partial_integral(pIntegration, end_height_km, total_electron_content_);
+    total_electron_content += total_electron_content_;
+    start_height_km = end_height_km;
+  } while (start_height_km < point_2_height_km);
+
+  *pTEC = total_electron_content;
+  return NEQUICK_OK;
+}
+
+/** Integrates a vertical ray semi-analytically,
+ * split at the points of the partial integrals (if any)
+ */
+static void semi_analytic_integrate(
+  NeQuickG_context_t* const pContext,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pTEC) {
+
+  NeQuickG_integration_t* const pIntegration = &pContext->integration;
+
+  double_t total_electron_content = 0.0;
+  double_t start_height_km = point_1_height_km;
+  double_t end_height_km;
+
+  do {
+    (void)get_next_split_point(
+      pIntegration, start_height_km, point_2_height_km, &end_height_km);
+
+    double_t total_electron_content_ = ray_vertical_get_integral(
+      pContext, start_height_km, end_height_km);
+    add_partial_integral(pIntegration, end_height_km, total_electron_content_);
+    total_electron_content += total_electron_content_;
+    start_height_km = end_height_km;
+  } while (start_height_km < point_2_height_km);
+
+  *pTEC = total_electron_content;
+}
+
 static int32_t both_below_first_integration_point(
   NeQuickG_context_t* const pContext,
   double_t* const pTEC) {
 
   gauss_kronrod_context_t gauss_kronrod_context;
   gauss_kronrod_context.tolerance =
-   NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_BELOW_FIRST_POINT;
+   pContext->integration.settings.tolerance_below_first_point;
 
   double_t zero_point_height_km = get_point_zero_height(pContext);
 
@@ -116,7 +481,7 @@ static int32_t between_integration_points(
 
   gauss_kronrod_context_t gauss_kronrod_context;
   gauss_kronrod_context.tolerance =
-   NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_BELOW_FIRST_POINT;
+   pContext->integration.settings.tolerance_below_first_point;
 
   double_t first_point_height_km =
     pContext->ray.is_vertical ?
@@ -153,13 +518,14 @@ static int32_t path_crosses_first_integration_point(
   gauss_kronrod_context_t gauss_kronrod_context;
 
   double_t first_integration_point_height_km =
-    get_point_height(pContext, NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM);
+    get_point_height(
+      pContext, pContext->integration.settings.first_point_height_km);
 
   {
     double_t zero_point_height_km = get_point_zero_height(pContext);
 
     gauss_kronrod_context.tolerance =
-      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_BELOW_FIRST_POINT;
+      pContext->integration.settings.tolerance_below_first_point;
 
      ret =
       Gauss_Kronrod_integrate_impl(
@@ -180,7 +546,7 @@ static int32_t path_crosses_first_integration_point(
       pContext->ray.slant.satellite_distance_km;
 
     gauss_kronrod_context.tolerance =
-      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_ABOVE_FIRST_POINT;
+      pContext->integration.settings.tolerance_above_first_point;
 
       double_t total_electron_content_;
       ret =
@@ -215,10 +581,11 @@ static int32_t path_crosses_second_integration_point(
 
   gauss_kronrod_context_t gauss_kronrod_context;
   gauss_kronrod_context.tolerance =
-      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_ABOVE_FIRST_POINT;
+      pContext->integration.settings.tolerance_above_first_point;
 
   double_t second_integration_point_height_km =
-    get_point_height(pContext, NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM);
+    get_point_height(
+      pContext, pContext->integration.settings.second_point_height_km);
 
   {
     double_t first_point_height_km =
@@ -281,7 +648,7 @@ static int32_t both_above_second_integration_point(
 
   gauss_kronrod_context_t gauss_kronrod_context;
   gauss_kronrod_context.tolerance =
-   NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_ABOVE_FIRST_POINT;
+   pContext->integration.settings.tolerance_above_first_point;
 
   return Gauss_Kronrod_integrate_impl(
     &gauss_kronrod_context,
@@ -306,12 +673,13 @@ static int32_t path_crosses_both_integration_points(
   double_t total_electron_content;
 
   double_t first_integration_point_height_km =
-      get_point_height(pContext, NEQUICK_G_JRC_INTEGRATION_FIRST_POINT_KM);
+      get_point_height(
+        pContext, pContext->integration.settings.first_point_height_km);
   {
     double_t zero_point_height_km = get_point_zero_height(pContext);
 
     gauss_kronrod_context.tolerance =
-      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_BELOW_FIRST_POINT;
+      pContext->integration.settings.tolerance_below_first_point;
 
      ret =
       Gauss_Kronrod_integrate_impl(
@@ -326,10 +694,11 @@ static int32_t path_crosses_both_integration_points(
   }
 
   gauss_kronrod_context.tolerance =
-      NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_ABOVE_FIRST_POINT;
+      pContext->integration.settings.tolerance_above_first_point;
 
   double_t second_integration_point_height_km =
-   get_point_height(pContext, NEQUICK_G_JRC_INTEGRATION_SECOND_POINT_KM);
+   get_point_height(
+     pContext, pContext->integration.settings.second_point_height_km);
 
   {
     double_t total_electron_content_;
@@ -370,12 +739,36 @@ static int32_t path_crosses_both_integration_points(
   return NEQUICK_OK;
 }
 
-int32_t NeQuickG_integrate(
+/** Number of breakpoint ranges the path is split into,
+ * same cases as #integrate
+ */
+static size_t get_range_count(
+  const NeQuickG_context_t* const pContext) {
+
+  if (IS_SATELLITE_BELOW_FIRST_POINT(pContext)) {
+    return 1;
+  }
+
+  if (IS_SATELLITE_BELOW_SECOND_POINT(pContext)) {
+    return IS_RECEIVER_ABOVE_FIRST_POINT(pContext) ? 1 : 2;
+  }
+
+  if (IS_RECEIVER_ABOVE_SECOND_POINT(pContext)) {
+    return 1;
+  }
+
+  if (IS_RECEIVER_ABOVE_FIRST_POINT(pContext)) {
+    return 2;
+  }
+
+  return 3;
+}
+
+static int32_t integrate(
   NeQuickG_context_t* const pContext,
   double_t* const pTEC) {
 
   int32_t ret;
-  *pTEC = 0.0;
 
   if (pContext->ray.is_vertical) {
     ret = ray_vertical_get_profile(pContext);
@@ -384,6 +777,37 @@ int32_t NeQuickG_integrate(
     }
   }
 
+  if (pContext->integration.pPartial) {
+    get_partial_points(pContext);
+  }
+
+  ret = get_profile_anchors(pContext);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  if (pContext->ray.is_vertical &&
+      pContext->integration.settings.semi_analytic_vertical) {
+    semi_analytic_integrate(
+      pContext,
+      get_point_zero_height(pContext),
+      pContext->ray.satellite_position.height,
+      pTEC);
+    return NEQUICK_OK;
+  }
+
+  if (pContext->integration.settings.split_at_layer_peaks &&
+      !IS_RECEIVER_ABOVE_FIRST_POINT(pContext)) {
+    ret = get_layer_peak_points(pContext);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+  }
+
+  // the first rule of every range is set aside
+  pContext->integration.evaluation_reserved =
+    get_range_count(pContext) * NEQUICK_G_JRC_KRONROD_SEGMENT_EVALUATION_COUNT;
+
   if (IS_SATELLITE_BELOW_FIRST_POINT(pContext)) {
     return both_below_first_integration_point(pContext, pTEC);
   }
@@ -405,7 +829,60 @@ int32_t NeQuickG_integrate(
   return path_crosses_both_integration_points(pContext, pTEC);
 }
 
-#undef NEQUICK_G_JRC_RECURSION_LIMIT_MAX
+static void update_statistics(
+  NeQuickG_integration_t* const pIntegration) {
+
+  NeQuickG_integration_statistics_t* const pStatistics =
+    &pIntegration->statistics;
+
+  pStatistics->integration_count++;
+  if (pIntegration->is_budget_exhausted) {
+    pStatistics->budget_exhausted_count++;
+  }
+  pStatistics->evaluation_count += pIntegration->evaluation_count;
+  pStatistics->evaluation_count_max = max(
+    pStatistics->evaluation_count_max, pIntegration->evaluation_count);
+}
+
+static void integration_begin(
+  NeQuickG_integration_t* const pIntegration) {
+  pIntegration->evaluation_count = 0;
+  pIntegration->evaluation_reserved = 0;
+  pIntegration->is_budget_exhausted = false;
+  pIntegration->error_estimate = 0.0;
+  pIntegration->layer_peak_point_count = 0;
+}
+
+int32_t NeQuickG_integrate(
+  NeQuickG_context_t* const pContext,
+  double_t* const pTEC) {
+
+  NeQuickG_integration_t* const pIntegration = &pContext->integration;
+
+  *pTEC = 0.0;
+  integration_begin(pIntegration);
+
+  if (pIntegration->pMesh) {
+    integration_mesh_begin(&pIntegration->next_mesh, pIntegration->pMesh);
+  }
+
+  int32_t ret = integrate(pContext, pTEC);
+
+  if (pIntegration->pMesh) {
+    if (ret == NEQUICK_OK) {
+      *pIntegration->pMesh = pIntegration->next_mesh;
+    } else {
+      pIntegration->pMesh->is_valid = false;
+    }
+  }
+
+  if (ret == NEQUICK_OK) {
+    update_statistics(pIntegration);
+  }
+  return ret;
+}
+
+#undef NEQUICK_G_JRC_INTEGRATION_LAYER_PEAK_REFERENCE_HEIGHT_KM
 #undef IS_SATELLITE_BELOW_FIRST_POINT
 #undef IS_SATELLITE_BELOW_SECOND_POINT
 #undef IS_RECEIVER_ABOVE_FIRST_POINT
@@ -0,0 +1,142 @@
+/** NeQuickG partial Slant Total Electron Content (STEC): per height shell
+ * and cumulative along the ray.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_TEC_partial.h"
+
+#include <stdbool.h>
+
+#include "NeQuickG_JRC_error.h"
+
+#define NEQUICK_G_JRC_TEC_PARTIAL_METERS_TO_KM(_h) ((_h)*1e-3)
+
+/** Eq. 151, Eq. 202 for the correction factor */
+#define NEQUICK_G_JRC_TEC_PARTIAL_TO_TECU(_TEC) ((_TEC) / 1.0E13)
+
+static bool is_ascending(
+  const double_t* const pValue,
+  const size_t count) {
+  for (size_t i = 1; i < count; i++) {
+    if (!(pValue[i] > pValue[i - 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int32_t check_partial(
+  const NeQuickG_TEC_partial_t* const pPartial) {
+
+  if (!pPartial ||
+      !pPartial->pShell_TEC ||
+      ((pPartial->shell_boundary_count > 0) &&
+       !pPartial->pShell_boundary_height_meters) ||
+      ((pPartial->cumulative_point_count > 0) &&
+       (!pPartial->pCumulative_distance_meters ||
+        !pPartial->pCumulative_TEC))) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Partial TEC. null pointer exception.");
+  }
+
+  if ((pPartial->shell_boundary_count >
+       NEQUICKG_TEC_SHELL_BOUNDARY_COUNT_MAX) ||
+      (pPartial->cumulative_point_count >
+       NEQUICKG_TEC_CUMULATIVE_POINT_COUNT_MAX)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_TEC_PARTIAL,
+      "Partial TEC. at most %d shell boundaries and %d cumulative points",
+      NEQUICKG_TEC_SHELL_BOUNDARY_COUNT_MAX,
+      NEQUICKG_TEC_CUMULATIVE_POINT_COUNT_MAX);
+  }
+
+  if (!is_ascending(
+        pPartial->pShell_boundary_height_meters,
+        pPartial->shell_boundary_count) ||
+      !is_ascending(
+        pPartial->pCumulative_distance_meters,
+        pPartial->cumulative_point_count) ||
+      ((pPartial->cumulative_point_count > 0) &&
+       (pPartial->pCumulative_distance_meters[0] < 0.0))) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_TEC_PARTIAL,
+      "Partial TEC. shell boundaries and cumulative distances must be "
+      "in ascending order, the distances positive");
+  }
+
+  return NEQUICK_OK;
+}
+
+int32_t NeQuickG_TEC_partial_get(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_TEC_partial_t* const pPartial,
+  double_t* const pTEC) {
+
+  *pTEC = 0.0;
+
+  int32_t ret = check_partial(pPartial);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  size_t shell_boundary_count = pPartial->shell_boundary_count;
+  size_t cumulative_point_count = pPartial->cumulative_point_count;
+
+  for (size_t i = 0; i <= shell_boundary_count; i++) {
+    pPartial->pShell_TEC[i] = 0.0;
+  }
+  for (size_t i = 0; i < cumulative_point_count; i++) {
+    pPartial->pCumulative_TEC[i] = 0.0;
+  }
+
+  NeQuickG_integration_partial_t partial;
+  partial.height_count = shell_boundary_count;
+  for (size_t i = 0; i < shell_boundary_count; i++) {
+    partial.height_km[i] = NEQUICK_G_JRC_TEC_PARTIAL_METERS_TO_KM(
+      pPartial->pShell_boundary_height_meters[i]);
+  }
+  partial.distance_count = cumulative_point_count;
+  for (size_t i = 0; i < cumulative_point_count; i++) {
+    partial.distance_km[i] = NEQUICK_G_JRC_TEC_PARTIAL_METERS_TO_KM(
+      pPartial->pCumulative_distance_meters[i]);
+  }
+
+  NeQuickG_context_get_solar_activity(pContext);
+
+  pContext->integration.pPartial = &partial;
+  ret = NeQuickG_context_get_slant_total_electron_content(pContext, pTEC);
+  pContext->integration.pPartial = NULL;
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  // the shell boundaries come first, then the cumulative points
+  double_t TEC_below = 0.0;
+  for (size_t i = 0; i < shell_boundary_count; i++) {
+    double_t TEC_below_boundary =
+      NEQUICK_G_JRC_TEC_PARTIAL_TO_TECU(partial.TEC_below[i]);
+    pPartial->pShell_TEC[i] = TEC_below_boundary - TEC_below;
+    TEC_below = TEC_below_boundary;
+  }
+  pPartial->pShell_TEC[shell_boundary_count] = *pTEC - TEC_below;
+
+  for (size_t i = 0; i < cumulative_point_count; i++) {
+    pPartial->pCumulative_TEC[i] = NEQUICK_G_JRC_TEC_PARTIAL_TO_TECU(
+      partial.TEC_below[shell_boundary_count + i]);
+  }
+
+  return NEQUICK_OK;
+}
+
+#undef NEQUICK_G_JRC_TEC_PARTIAL_METERS_TO_KM
+#undef NEQUICK_G_JRC_TEC_PARTIAL_TO_TECU
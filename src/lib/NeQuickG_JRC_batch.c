@@ -0,0 +1,480 @@
+/** NeQuickG batch of receiver-satellite links.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_batch.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_macros.h"
+
+/** Exact comparison, the cached state is reused only for identical inputs */
+#define NEQUICK_G_BATCH_IS_EQUAL(_d1, _d2) \
+  (memcmp(&(_d1), &(_d2), sizeof(double_t)) == 0)
+
+/** Group delay per TECU: 40.3 m<SUP>3</SUP>/s<SUP>2</SUP> times
+ * 10<SUP>16</SUP> electrons/m<SUP>2</SUP>, divided by f<SUP>2</SUP> gives meters
+ */
+#define NEQUICK_G_BATCH_GROUP_DELAY_FACTOR (40.3e16)
+/** Number of links of an ECEF batch converted to geodetic coordinates at once */
+#define NEQUICK_G_BATCH_ECEF_BLOCK_SIZE (32)
+
+int32_t NeQuickG_batch_check_links(
+  const NeQuickG_links_t* const pLinks,
+  const double_t* const pTEC,
+  const int32_t* const pStatus) {
+
+  if (!pLinks || !pTEC || !pStatus) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Batch. null pointer exception.");
+  }
+
+  if ((pLinks->count > 0) &&
+      (!pLinks->pMonth ||
+       !pLinks->pUTC ||
+       !pLinks->pReceiver_longitude_degree ||
+       !pLinks->pReceiver_latitude_degree ||
+       !pLinks->pReceiver_height_meters ||
+       !pLinks->pSatellite_longitude_degree ||
+       !pLinks->pSatellite_latitude_degree ||
+       !pLinks->pSatellite_height_meters)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Batch links. null pointer exception.");
+  }
+  return NEQUICK_OK;
+}
+
+/** Gets the status of an item of a batch.
+ * The error source and code of the first item that failed are kept,
+ * the next items overwrite the last error of the thread.
+ *
+ * @param[in] item_ret NEQUICK_OK or the error source of the item
+ * @param[in, out] pRet error source of the first item that failed
+ * @param[in, out] pError_code error code of the first item that failed
+ * @return NEQUICK_OK or the error code of the item
+ */
+static int32_t get_item_status(
+  const int32_t item_ret,
+  int32_t* const pRet,
+  int32_t* const pError_code) {
+
+  if (item_ret == NEQUICK_OK) {
+    return NEQUICK_OK;
+  }
+
+  int32_t error_code;
+  (void)NeQuickG_error_get_last(&error_code);
+  if (*pRet == NEQUICK_OK) {
+    *pRet = item_ret;
+    *pError_code = error_code;
+  }
+  return error_code;
+}
+
+/** Records the first error of a batch as the last error of the thread
+ * @param[in] ret NEQUICK_OK or the error source of the first item that failed
+ * @param[in] error_code error code of the first item that failed
+ * @return ret
+ */
+static int32_t get_batch_ret(
+  const int32_t ret,
+  const int32_t error_code) {
+  if (ret != NEQUICK_OK) {
+    NeQuickG_error_set_last(ret, error_code);
+  }
+  return ret;
+}
+
+static bool is_same_epoch(
+  const NeQuickG_context_t* const pContext,
+  uint8_t month,
+  double_t UTC) {
+  return (
+    NEQUICK_G_TIME_MONTH_EQUAL(month, pContext->input_data.time.month) &&
+    NEQUICK_G_BATCH_IS_EQUAL(UTC, pContext->input_data.time.utc));
+}
+
+static int32_t set_epoch(
+  NeQuickG_context_t* const pContext,
+  uint8_t month,
+  double_t UTC,
+  bool* const pIs_receiver_valid) {
+
+  if (*pIs_receiver_valid && is_same_epoch(pContext, month, UTC)) {
+    return NEQUICK_OK;
+  }
+
+  int32_t ret = NeQuickG_context_set_time(pContext, month, UTC);
+  if (ret != NEQUICK_OK) {
+    *pIs_receiver_valid = false;
+  }
+  return ret;
+}
+
+static bool is_same_receiver(
+  const NeQuickG_links_t* const pLinks,
+  size_t i) {
+  size_t previous = i - 1;
+  return (
+    NEQUICK_G_BATCH_IS_EQUAL(
+      pLinks->pReceiver_longitude_degree[i],
+      pLinks->pReceiver_longitude_degree[previous]) &&
+    NEQUICK_G_BATCH_IS_EQUAL(
+      pLinks->pReceiver_latitude_degree[i],
+      pLinks->pReceiver_latitude_degree[previous]) &&
+    NEQUICK_G_BATCH_IS_EQUAL(
+      pLinks->pReceiver_height_meters[i],
+      pLinks->pReceiver_height_meters[previous]));
+}
+
+static int32_t get_link(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_t* const pLinks,
+  size_t i,
+  bool* const pIs_receiver_valid,
+  double_t* const pTEC) {
+
+  *pTEC = 0.0;
+
+  int32_t ret = set_epoch(
+    pContext, pLinks->pMonth[i], pLinks->pUTC[i], pIs_receiver_valid);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  if (!(*pIs_receiver_valid && is_same_receiver(pLinks, i))) {
+    *pIs_receiver_valid = false;
+
+    ret = position_set(
+      &pContext->input_data.station_position,
+      pLinks->pReceiver_longitude_degree[i],
+      pLinks->pReceiver_latitude_degree[i],
+      pLinks->pReceiver_height_meters[i],
+      NEQUICK_G_JRC_HEIGHT_UNITS_METERS);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+
+    NeQuickG_context_get_solar_activity(pContext);
+    *pIs_receiver_valid = true;
+  }
+
+  ret = position_set(
+    &pContext->input_data.satellite_position,
+    pLinks->pSatellite_longitude_degree[i],
+    pLinks->pSatellite_latitude_degree[i],
+    pLinks->pSatellite_height_meters[i],
+    NEQUICK_G_JRC_HEIGHT_UNITS_METERS);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return NeQuickG_context_get_slant_total_electron_content(pContext, pTEC);
+}
+
+int32_t NeQuickG_batch_get_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  int32_t ret = NeQuickG_batch_check_links(pLinks, pTEC, pStatus);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  // the receiver-side state is valid for the previous link
+  bool is_receiver_valid = false;
+  int32_t error_code = NEQUICK_OK;
+
+  for (size_t i = 0; i < pLinks->count; i++) {
+    pStatus[i] = get_item_status(
+      get_link(pContext, pLinks, i, &is_receiver_valid, &pTEC[i]),
+      &ret, &error_code);
+  }
+  return get_batch_ret(ret, error_code);
+}
+
+static bool is_same_receiver_ECEF(
+  const NeQuickG_links_ECEF_t* const pLinks,
+  size_t i) {
+  size_t previous = i - 1;
+  return (
+    NEQUICK_G_BATCH_IS_EQUAL(
+      pLinks->pReceiver_x_meters[i],
+      pLinks->pReceiver_x_meters[previous]) &&
+    NEQUICK_G_BATCH_IS_EQUAL(
+      pLinks->pReceiver_y_meters[i],
+      pLinks->pReceiver_y_meters[previous]) &&
+    NEQUICK_G_BATCH_IS_EQUAL(
+      pLinks->pReceiver_z_meters[i],
+      pLinks->pReceiver_z_meters[previous]));
+}
+
+static int32_t get_link_ECEF(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_ECEF_t* const pLinks,
+  size_t i,
+  const position_t* const pReceiver_position,
+  const position_t* const pSatellite_position,
+  bool* const pIs_receiver_valid,
+  double_t* const pTEC) {
+
+  *pTEC = 0.0;
+
+  int32_t ret = set_epoch(
+    pContext, pLinks->pMonth[i], pLinks->pUTC[i], pIs_receiver_valid);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  if (!(*pIs_receiver_valid && is_same_receiver_ECEF(pLinks, i))) {
+    pContext->input_data.station_position = *pReceiver_position;
+    NeQuickG_context_get_solar_activity(pContext);
+    *pIs_receiver_valid = true;
+  }
+
+  pContext->input_data.satellite_position = *pSatellite_position;
+
+  return NeQuickG_context_get_slant_total_electron_content(pContext, pTEC);
+}
+
+int32_t NeQuickG_batch_get_total_electron_content_ECEF(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_ECEF_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  if (!pLinks || !pTEC || !pStatus) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "ECEF batch. null pointer exception.");
+  }
+
+  if ((pLinks->count > 0) &&
+      (!pLinks->pMonth ||
+       !pLinks->pUTC ||
+       !pLinks->pReceiver_x_meters ||
+       !pLinks->pReceiver_y_meters ||
+       !pLinks->pReceiver_z_meters ||
+       !pLinks->pSatellite_x_meters ||
+       !pLinks->pSatellite_y_meters ||
+       !pLinks->pSatellite_z_meters)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "ECEF batch links. null pointer exception.");
+  }
+
+  int32_t ret = NEQUICK_OK;
+  int32_t error_code = NEQUICK_OK;
+
+  bool is_receiver_valid = false;
+
+  // the positions are converted a block at a time, in one pass per block
+  position_t receiver_positions[NEQUICK_G_BATCH_ECEF_BLOCK_SIZE];
+  position_t satellite_positions[NEQUICK_G_BATCH_ECEF_BLOCK_SIZE];
+  int32_t receiver_status[NEQUICK_G_BATCH_ECEF_BLOCK_SIZE];
+  int32_t satellite_status[NEQUICK_G_BATCH_ECEF_BLOCK_SIZE];
+
+  for (size_t first = 0;
+       first < pLinks->count;
+       first += NEQUICK_G_BATCH_ECEF_BLOCK_SIZE) {
+
+    size_t block_size =
+      min(pLinks->count - first, (size_t)NEQUICK_G_BATCH_ECEF_BLOCK_SIZE);
+
+    // a rejected position only fails its own link
+    (void)positions_set_from_ECEF(
+      receiver_positions,
+      &pLinks->pReceiver_x_meters[first],
+      &pLinks->pReceiver_y_meters[first],
+      &pLinks->pReceiver_z_meters[first],
+      block_size,
+      receiver_status);
+
+    (void)positions_set_from_ECEF(
+      satellite_positions,
+      &pLinks->pSatellite_x_meters[first],
+      &pLinks->pSatellite_y_meters[first],
+      &pLinks->pSatellite_z_meters[first],
+      block_size,
+      satellite_status);
+
+    for (size_t j = 0; j < block_size; j++) {
+      size_t i = first + j;
+      int32_t position_code = (receiver_status[j] != NEQUICK_OK) ?
+        receiver_status[j] : satellite_status[j];
+      int32_t link_ret;
+      if (position_code == NEQUICK_OK) {
+        link_ret = get_link_ECEF(
+          pContext, pLinks, i,
+          &receiver_positions[j],
+          &satellite_positions[j],
+          &is_receiver_valid,
+          &pTEC[i]);
+      } else {
+        // the whole block was converted, the rejected position
+        // becomes the last error again
+        NeQuickG_error_set_last(NEQUICK_ERROR_SRC_INPUT_DATA, position_code);
+        link_ret = NEQUICK_ERROR_SRC_INPUT_DATA;
+        pTEC[i] = 0.0;
+        is_receiver_valid = false;
+      }
+      pStatus[i] = get_item_status(link_ret, &ret, &error_code);
+    }
+  }
+  return get_batch_ret(ret, error_code);
+}
+
+int32_t NeQuickG_batch_get_group_delay(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_t* const pLinks,
+  const NeQuickG_frequencies_t* const pFrequencies,
+  double_t* const pDelay,
+  int32_t* const pStatus) {
+
+  int32_t ret = NeQuickG_batch_check_links(pLinks, pDelay, pStatus);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  if (!pFrequencies ||
+      ((pFrequencies->count > 0) && !pFrequencies->pFrequency_Hz)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Group delay frequencies. null pointer exception.");
+  }
+
+  for (size_t j = 0; j < pFrequencies->count; j++) {
+    if (!(pFrequencies->pFrequency_Hz[j] > 0.0)) {
+      NEQUICK_ERROR_RETURN(
+        NEQUICK_ERROR_SRC_INPUT_DATA,
+        NEQUICK_ERROR_CODE_BAD_FREQUENCY,
+        "Group delay. frequency %lf (Hz) must be positive",
+        pFrequencies->pFrequency_Hz[j]);
+    }
+  }
+
+  bool is_receiver_valid = false;
+  int32_t error_code = NEQUICK_OK;
+
+  for (size_t i = 0; i < pLinks->count; i++) {
+    double_t TEC;
+    pStatus[i] = get_item_status(
+      get_link(pContext, pLinks, i, &is_receiver_valid, &TEC),
+      &ret, &error_code);
+    double_t* const pLink_delay = &pDelay[i*pFrequencies->count];
+    for (size_t j = 0; j < pFrequencies->count; j++) {
+      double_t frequency_Hz = pFrequencies->pFrequency_Hz[j];
+      pLink_delay[j] =
+        NEQUICK_G_BATCH_GROUP_DELAY_FACTOR*TEC/(frequency_Hz*frequency_Hz);
+    }
+  }
+  return get_batch_ret(ret, error_code);
+}
+
+int32_t NeQuickG_batch_get_total_electron_content_epoch(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_satellites_t* const pSatellites,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  if (!pSatellites || !pTEC || !pStatus) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Epoch. null pointer exception.");
+  }
+
+  if ((pSatellites->count > 0) &&
+      (!pSatellites->pLongitude_degree ||
+       !pSatellites->pLatitude_degree ||
+       !pSatellites->pHeight_meters)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Epoch satellites. null pointer exception.");
+  }
+
+  // receiver-side state, shared by all the rays
+  NeQuickG_context_get_solar_activity(pContext);
+
+  int32_t ret = NEQUICK_OK;
+  int32_t error_code = NEQUICK_OK;
+
+  for (size_t i = 0; i < pSatellites->count; i++) {
+    pTEC[i] = 0.0;
+    int32_t satellite_ret = position_set(
+      &pContext->input_data.satellite_position,
+      pSatellites->pLongitude_degree[i],
+      pSatellites->pLatitude_degree[i],
+      pSatellites->pHeight_meters[i],
+      NEQUICK_G_JRC_HEIGHT_UNITS_METERS);
+    if (satellite_ret == NEQUICK_OK) {
+      satellite_ret =
+        NeQuickG_context_get_slant_total_electron_content(pContext, &pTEC[i]);
+    }
+    pStatus[i] = get_item_status(satellite_ret, &ret, &error_code);
+  }
+  return get_batch_ret(ret, error_code);
+}
+
+int32_t NeQuickG_batch_get_vertical_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_locations_t* const pLocations,
+  const double_t bottom_height_meters,
+  const double_t top_height_meters,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  if (!pLocations || !pTEC || !pStatus) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Vertical batch. null pointer exception.");
+  }
+
+  if ((pLocations->count > 0) &&
+      (!pLocations->pLongitude_degree ||
+       !pLocations->pLatitude_degree)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Vertical batch locations. null pointer exception.");
+  }
+
+  int32_t ret = NEQUICK_OK;
+  int32_t error_code = NEQUICK_OK;
+
+  for (size_t i = 0; i < pLocations->count; i++) {
+    pStatus[i] = get_item_status(
+      NeQuickG_context_get_vertical_total_electron_content(
+        pContext,
+        pLocations->pLongitude_degree[i],
+        pLocations->pLatitude_degree[i],
+        bottom_height_meters,
+        top_height_meters,
+        &pTEC[i]),
+      &ret, &error_code);
+  }
+  return get_batch_ret(ret, error_code);
+}
+
+#undef NEQUICK_G_BATCH_ECEF_BLOCK_SIZE
+#undef NEQUICK_G_BATCH_GROUP_DELAY_FACTOR
+#undef NEQUICK_G_BATCH_IS_EQUAL
@@ -0,0 +1,378 @@
+/**
+ * NeQuick G JRC library context.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_context.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_electron_density.h"
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_TEC_integration.h"
+
+#define NEQUICK_G_CONTEXT_METERS_TO_KM(_h) ((_h)*1e-3)
+
+static void integration_init(NeQuickG_integration_t* const pIntegration) {
+  // the specification preset is always defined
+  (void)NeQuickG_integration_get_preset(
+    NEQUICKG_INTEGRATION_PRESET_SPECIFICATION,
+    &pIntegration->settings);
+  pIntegration->evaluation_count = 0;
+  pIntegration->evaluation_reserved = 0;
+  pIntegration->is_budget_exhausted = false;
+  pIntegration->error_estimate = 0.0;
+  memset(&pIntegration->statistics, 0, sizeof(pIntegration->statistics));
+  pIntegration->layer_peak_point_count = 0;
+  // the meshes are kept allocated, only the links are forgotten
+  if (pIntegration->pMesh_cache) {
+    integration_mesh_cache_init(pIntegration->pMesh_cache);
+  }
+  pIntegration->pMesh = NULL;
+  pIntegration->pPartial = NULL;
+}
+
+static bool is_integration_method_valid(const uint8_t method) {
+  return (
+    (method == NEQUICKG_INTEGRATION_RECURSIVE) ||
+    (method == NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE) ||
+    (method == NEQUICKG_INTEGRATION_PATTERSON));
+}
+
+void NeQuickG_context_init(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_model_t* const pModel) {
+
+  pContext->pModel = pModel;
+  pContext->pOwned_model = NULL;
+  pContext->is_pooled = false;
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  modip_init(&pContext->modip, &pModel->modip_grid);
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+
+  iono_profile_init(
+    &pContext->profile, pModel->pCCIR_folder, pModel->pCCIR_months);
+
+  pContext->integration.pMesh_cache = NULL;
+  integration_init(&pContext->integration);
+  profile_cache_init(&pContext->profile_cache);
+  profile_anchors_init(&pContext->profile_anchors);
+}
+
+void NeQuickG_context_reset(
+  NeQuickG_context_t* const pContext) {
+
+  memset(&pContext->input_data, 0, sizeof(pContext->input_data));
+  NeQuickG_time_init(&pContext->input_data.time);
+
+  memset(&pContext->solar_activity, 0, sizeof(pContext->solar_activity));
+  memset(&pContext->ray, 0, sizeof(pContext->ray));
+
+  // the solar declination depends on the time that has just been cleared
+  pContext->profile.E.is_solar_declination_valid = false;
+
+  // the caches are emptied, their settings and their entries are kept:
+  // the same size is set again, nothing is allocated
+  (void)F2_layer_fourier_coefficients_set_cache(
+    &pContext->profile.F2.coef,
+    pContext->profile.F2.coef.cache.entry_count);
+
+  integration_init(&pContext->integration);
+  (void)profile_cache_set(
+    &pContext->profile_cache,
+    pContext->profile_cache.is_enabled,
+    pContext->profile_cache.quantum_degree,
+    pContext->profile_cache.set_count);
+  profile_anchors_init(&pContext->profile_anchors);
+}
+
+void NeQuickG_context_close(
+  NeQuickG_context_t* const pContext) {
+  iono_profile_close(&pContext->profile);
+  (void)profile_cache_set(&pContext->profile_cache, false, 0.0, 0);
+  free(pContext->integration.pMesh_cache);
+  pContext->integration.pMesh_cache = NULL;
+}
+
+int32_t NeQuickG_context_set_time(
+  NeQuickG_context_t* const pContext,
+  const uint8_t month,
+  const double_t UTC) {
+
+  int32_t ret = NeQuickG_time_set(&pContext->input_data.time, month, UTC);
+
+  pContext->profile.E.is_solar_declination_valid = false;
+
+  return ret;
+}
+
+int32_t NeQuickG_context_set_integration_method(
+  NeQuickG_context_t* const pContext,
+  const uint8_t method) {
+
+  if (!is_integration_method_valid(method)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_METHOD,
+      "Integration method %u is not supported", method);
+  }
+
+  pContext->integration.settings.method = method;
+  return NEQUICK_OK;
+}
+
+int32_t NeQuickG_context_set_integration_settings(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_integration_settings_t* const pSettings) {
+
+  if (!pSettings) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Integration settings. null pointer exception.");
+  }
+
+  if (!is_integration_method_valid(pSettings->method)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_METHOD,
+      "Integration method %u is not supported", pSettings->method);
+  }
+
+  if (!(pSettings->first_point_height_km > 0.0) ||
+      !(pSettings->second_point_height_km >
+        pSettings->first_point_height_km)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS,
+      "Integration breakpoints %lf and %lf (km) must be positive and ordered",
+      pSettings->first_point_height_km, pSettings->second_point_height_km);
+  }
+
+  if (!(pSettings->tolerance_below_first_point > 0.0) ||
+      !(pSettings->tolerance_above_first_point > 0.0)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS,
+      "Integration tolerances %lf and %lf must be positive",
+      pSettings->tolerance_below_first_point,
+      pSettings->tolerance_above_first_point);
+  }
+
+  if (pSettings->recursion_max > NEQUICK_G_JRC_RECURSION_LIMIT_MAX) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS,
+      "Integration recursion level %zu must be at most %d",
+      pSettings->recursion_max,
+      NEQUICK_G_JRC_RECURSION_LIMIT_MAX);
+  }
+
+  if ((pSettings->evaluation_max != 0) &&
+      (pSettings->evaluation_max < NEQUICKG_INTEGRATION_EVALUATION_BUDGET_MIN)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS,
+      "Integration evaluation budget %zu must be 0 or at least %d",
+      pSettings->evaluation_max,
+      NEQUICKG_INTEGRATION_EVALUATION_BUDGET_MIN);
+  }
+
+  if ((pSettings->profile_anchor_count != 0) &&
+      ((pSettings->profile_anchor_count <
+        NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN) ||
+       (pSettings->profile_anchor_count >
+        NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX))) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS,
+      "Integration profile anchor count %zu must be 0 or between %d and %d",
+      pSettings->profile_anchor_count,
+      NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN,
+      NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX);
+  }
+
+  pContext->integration.settings = *pSettings;
+  // the meshes were built with the previous settings
+  if (pContext->integration.pMesh_cache) {
+    integration_mesh_cache_init(pContext->integration.pMesh_cache);
+  }
+  return NEQUICK_OK;
+}
+
+void NeQuickG_context_get_modip(
+  NeQuickG_context_t* const pContext) {
+  input_data_to_km(&pContext->input_data);
+  modip_get(&pContext->modip, &pContext->input_data.station_position);
+}
+
+void NeQuickG_context_get_solar_activity(
+  NeQuickG_context_t* const pContext) {
+  NeQuickG_context_get_modip(pContext);
+  solar_activity_get(&pContext->solar_activity, pContext->modip.modip_degree);
+}
+
+static int32_t get_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  double_t* const pTEC) {
+
+  int32_t ret = NeQuickG_integrate(pContext, pTEC);
+  if (ret == NEQUICK_OK) {
+    // Eq. 151, Eq. 202 for the correction factor
+    *pTEC = (*pTEC / 1.0E13);
+  }
+  return ret;
+}
+
+int32_t NeQuickG_context_get_slant_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  double_t* const pTEC) {
+
+  *pTEC = 0.0;
+
+  input_data_to_km(&pContext->input_data);
+
+  int32_t ret = ray_get(
+    &pContext->ray,
+    &pContext->input_data.station_position,
+    &pContext->input_data.satellite_position);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  return get_total_electron_content(pContext, pTEC);
+}
+
+int32_t NeQuickG_context_get_slant_total_electron_content_link(
+  NeQuickG_context_t* const pContext,
+  const uint32_t link_id,
+  double_t* const pTEC) {
+
+  if (!pContext->integration.pMesh_cache) {
+    // calloc: no link is remembered
+    pContext->integration.pMesh_cache =
+      calloc(1, sizeof(integration_mesh_cache_t));
+    if (!pContext->integration.pMesh_cache) {
+      NEQUICK_ERROR_RETURN(
+        NEQUICK_ERROR_SRC_MEMORY,
+        NEQUICK_ERROR_CODE_NO_RESOURCES,
+        "Not enough resources to allocate the link meshes");
+    }
+  }
+
+  pContext->integration.pMesh =
+    integration_mesh_cache_get(pContext->integration.pMesh_cache, link_id);
+
+  int32_t ret = NeQuickG_context_get_slant_total_electron_content(
+    pContext, pTEC);
+
+  pContext->integration.pMesh = NULL;
+  return ret;
+}
+
+int32_t NeQuickG_context_get_vertical_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  const double_t longitude_degree,
+  const double_t latitude_degree,
+  const double_t bottom_height_meters,
+  const double_t top_height_meters,
+  double_t* const pTEC) {
+
+  *pTEC = 0.0;
+
+  if (!(top_height_meters > bottom_height_meters)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_HEIGHTS,
+      "Vertical ray. top height %lf (m) must be above bottom height %lf (m)",
+      top_height_meters, bottom_height_meters);
+  }
+
+  int32_t ret = position_set(
+    &pContext->input_data.station_position,
+    longitude_degree,
+    latitude_degree,
+    bottom_height_meters,
+    NEQUICK_G_JRC_HEIGHT_UNITS_METERS);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  ret = position_set(
+    &pContext->input_data.satellite_position,
+    longitude_degree,
+    latitude_degree,
+    top_height_meters,
+    NEQUICK_G_JRC_HEIGHT_UNITS_METERS);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  // the location is the receiver for the Effective Ionisation Level
+  NeQuickG_context_get_solar_activity(pContext);
+
+  ray_get_vertical(
+    &pContext->ray,
+    &pContext->input_data.station_position,
+    &pContext->input_data.satellite_position);
+
+  return get_total_electron_content(pContext, pTEC);
+}
+
+int32_t NeQuickG_context_get_electron_density_profile(
+  NeQuickG_context_t* const pContext,
+  const double_t longitude_degree,
+  const double_t latitude_degree,
+  const double_t* const pHeight_meters,
+  const size_t height_count,
+  double_t* const pElectron_density) {
+
+  if ((height_count > 0) && (!pHeight_meters || !pElectron_density)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_NULL_POINTER,
+      "Electron density profile. null pointer exception.");
+  }
+
+  int32_t ret = position_set(
+    &pContext->input_data.station_position,
+    longitude_degree,
+    latitude_degree,
+    0.0,
+    NEQUICK_G_JRC_HEIGHT_UNITS_METERS);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  // the location is the receiver for the Effective Ionisation Level
+  NeQuickG_context_get_solar_activity(pContext);
+
+  ret = iono_profile_get(
+    &pContext->profile,
+    &pContext->input_data.time,
+    &pContext->modip,
+    &pContext->solar_activity,
+    &pContext->input_data.station_position);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  for (size_t i = 0; i < height_count; i++) {
+    pElectron_density[i] = electron_density_get(
+      &pContext->profile,
+      NEQUICK_G_CONTEXT_METERS_TO_KM(pHeight_meters[i]));
+  }
+  return NEQUICK_OK;
+}
+
+#undef NEQUICK_G_CONTEXT_METERS_TO_KM
@@ -25,6 +25,14 @@
  * @see position_is_exterior
  */
 #define NEQUICK_G_POSITION_HORIZONTAL_COORD_EPSILON (1.0e-5)
+/** WGS-84 semi-major axis a (m) */
+#define NEQUICK_G_WGS_84_SEMI_MAJOR_AXIS_METERS (6378137.0)
+/** WGS-84 flattening f */
+#define NEQUICK_G_WGS_84_FLATTENING (1.0/298.257223563)
+/** Lowest ellipsoidal height (m) of an ECEF position, below the lowest
+ * land surface (Dead Sea shore, about -0.4 km)
+ */
+#define NEQUICK_G_ECEF_HEIGHT_MIN_METERS (-1.0e3)
 
 /** From the height get the radius in km
  * @param[in] p pointer to the position structure
@@ -78,6 +86,116 @@ int32_t position_set(
   return NEQUICK_OK;
 }
 
+/** Heikkinen closed form, see J. Zhu, "Conversion of Earth-centered
+ * Earth-fixed coordinates to geodetic coordinates", IEEE Transactions
+ * on Aerospace and Electronic Systems, 30 (1994)
+ */
+static int32_t position_set_from_ECEF(
+  position_t* const p,
+  double_t x,
+  double_t y,
+  double_t z) {
+
+  const double_t a = NEQUICK_G_WGS_84_SEMI_MAJOR_AXIS_METERS;
+  const double_t b = a*(1.0 - NEQUICK_G_WGS_84_FLATTENING);
+  const double_t a2 = a*a;
+  const double_t b2 = b*b;
+  const double_t e2 = (a2 - b2)/a2;
+  const double_t ep2 = (a2 - b2)/b2;
+
+  double_t p2 = x*x + y*y;
+  double_t r = sqrt(p2);
+  double_t z2 = z*z;
+
+  // the conversion is singular at the centre of the Earth:
+  // any point closer than the polar radius is below the surface
+  if (!isfinite(x) || !isfinite(y) || !isfinite(z) ||
+      !(sqrt(p2 + z2) >= (b + NEQUICK_G_ECEF_HEIGHT_MIN_METERS))) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_POSITION,
+      "ECEF position (%lf, %lf, %lf) (m) must be finite and above the Earth surface",
+      x, y, z);
+  }
+
+  double_t F = 54.0*b2*z2;
+  double_t G = p2 + (1.0 - e2)*z2 - e2*(a2 - b2);
+  double_t c = e2*e2*F*p2/(G*G*G);
+  double_t s = cbrt(1.0 + c + sqrt(c*c + 2.0*c));
+  double_t k = s + 1.0 + 1.0/s;
+  double_t P = F/(3.0*k*k*G*G);
+  double_t Q = sqrt(1.0 + 2.0*e2*e2*P);
+  double_t r0 =
+    -(P*e2*r)/(1.0 + Q) +
+    sqrt(0.5*a2*(1.0 + 1.0/Q) -
+         P*(1.0 - e2)*z2/(Q*(1.0 + Q)) -
+         0.5*P*p2);
+  double_t t = r - e2*r0;
+  double_t U = sqrt(t*t + z2);
+  double_t V = sqrt(t*t + (1.0 - e2)*z2);
+  double_t z0 = b2*z/(a*V);
+
+  {
+    double_t num = z + ep2*z0;
+    double_t norm = sqrt(num*num + p2);
+    p->latitude.rad = atan2(num, r);
+    p->latitude.degree = NEQUICKG_JRC_RAD_TO_DEGREE(p->latitude.rad);
+    p->latitude.sin = num/norm;
+    p->latitude.cos = r/norm;
+  }
+
+  {
+    p->longitude_org = NEQUICKG_JRC_RAD_TO_DEGREE(atan2(y, x));
+    /* Longitude must be between 0.0 and 360.0 */
+    p->longitude.degree =
+      fmod(p->longitude_org + NEQUICK_G_JRC_CIRCLE_DEGREES,
+           NEQUICK_G_JRC_CIRCLE_DEGREES);
+    p->longitude.rad = NEQUICKG_JRC_DEGREE_TO_RAD(p->longitude.degree);
+    if (r > 0.0) {
+      p->longitude.sin = y/r;
+      p->longitude.cos = x/r;
+    } else {
+      p->longitude.sin = 0.0;
+      p->longitude.cos = 1.0;
+    }
+  }
+
+  p->height = U*(1.0 - b2/(a*V));
+  p->height_units = NEQUICK_G_JRC_HEIGHT_UNITS_METERS;
+  p->radius_km = position_get_radius_km(p);
+
+  if (p->height < NEQUICK_G_ECEF_HEIGHT_MIN_METERS) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_POSITION,
+      "ECEF position height %lf (m) is below the Earth surface",
+      p->height);
+  }
+  return NEQUICK_OK;
+}
+
+int32_t positions_set_from_ECEF(
+  position_t* const pPositions,
+  const double_t* const pX_meters,
+  const double_t* const pY_meters,
+  const double_t* const pZ_meters,
+  size_t count,
+  int32_t* const pStatus) {
+  int32_t ret = NEQUICK_OK;
+  for (size_t i = 0; i < count; i++) {
+    int32_t position_ret = position_set_from_ECEF(
+      &pPositions[i], pX_meters[i], pY_meters[i], pZ_meters[i]);
+    pStatus[i] = NEQUICK_OK;
+    if (position_ret != NEQUICK_OK) {
+      (void)NeQuickG_error_get_last(&pStatus[i]);
+      if (ret == NEQUICK_OK) {
+        ret = position_ret;
+      }
+    }
+  }
+  return ret;
+}
+
 void position_to_km(position_t* const p) {
   if (p->height_units == NEQUICK_G_JRC_HEIGHT_UNITS_METERS) {
     p->height = NEQUICK_G_POSITION_METERS_TO_KM(p->height);
@@ -119,6 +237,9 @@ double_t get_height_from_radius(const double_t radius_km) {
   return (radius_km - NEQUICK_G_EARTH_RADIUS_IN_KM);
 }
 
+#undef NEQUICK_G_ECEF_HEIGHT_MIN_METERS
+#undef NEQUICK_G_WGS_84_FLATTENING
+#undef NEQUICK_G_WGS_84_SEMI_MAJOR_AXIS_METERS
 #undef NEQUICK_G_POSITION_HORIZONTAL_COORD_EPSILON
 #undef NEQUICK_G_EARTH_RADIUS_IN_KM
 #undef NEQUICK_G_POSITION_KM_TO_METERS
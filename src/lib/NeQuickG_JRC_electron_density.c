@@ -37,6 +37,43 @@
 /** Bottom side electron density. Factor to get electron density in m<SUP>-3</SUP>].Eq. 121 */
 #define NEQUICK_G_JRC_ELE_DENSITY_TO_ELECTRON_DENSITY(_N) (1.0e11*_N)
 
+/** Integral. Below this height the bottom side electron density
+ * (Eq. 120, Z < -4) is negligible
+ */
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_KM (60.0)
+/** Integral. Num of pts of the Gauss-Legendre rule of the corrected parts */
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_POINT_COUNT (8)
+/** Integral. Maximum number of panels of the bottom side (100 km - hmF2) */
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_PANEL_COUNT_MAX (6)
+/** Integral. Top side panel breakpoints in the Epstein argument t,
+ * the topside scale grows fastest around r/(g(1 + r))
+ */
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_1 (2.0)
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_2 (5.0)
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_3 \
+  (NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2 / \
+   (NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_1 * \
+    (1.0 + NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2)))
+#define NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_4 (10.0)
+
+/** 8 points Gauss-Legendre nodes, the rule is symmetric */
+static const double_t Gauss_Legendre_xi[
+  NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_POINT_COUNT/2] = {
+  0.183434642495649804939476142360184,
+  0.525532409916328985817739049189246,
+  0.796666477413626739591553936475831,
+  0.960289856497536231683560868569473
+};
+
+/** 8 points Gauss-Legendre weights */
+static const double_t Gauss_Legendre_wi[
+  NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_POINT_COUNT/2] = {
+  0.362683783378361982965150449277196,
+  0.313706645877887287337962201986601,
+  0.222381034453374470544355994426241,
+  0.101228536290376259152531354309962
+};
+
 typedef struct bottom_side_st {
   double_t B_param;
   double_t exponential_arg;
@@ -285,6 +322,465 @@ double_t electron_density_get(
   }
 }
 
+/** Integrand of the semi-analytic integral, in m<SUP>-3</SUP>
+ * (see #electron_density_get_integral)
+ */
+typedef double_t (*integrand_t)(
+  iono_profile_t* const pProfile,
+  const double_t x);
+
+/** Gauss-Legendre integral of an integrand between two points */
+static double_t Gauss_Legendre_integrate(
+  integrand_t integrand,
+  iono_profile_t* const pProfile,
+  const double_t point_1,
+  const double_t point_2,
+  size_t* const pEvaluation_count) {
+
+  if (!(point_2 > point_1)) {
+    return 0.0;
+  }
+
+  double_t mid_point = (point_1 + point_2) / 2.0;
+  double_t half_diff = (point_2 - point_1) / 2.0;
+
+  double_t sum = 0.0;
+  for (size_t i = 0; i < (NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_POINT_COUNT/2); i++) {
+    sum += Gauss_Legendre_wi[i] * (
+      integrand(pProfile, mid_point - (half_diff * Gauss_Legendre_xi[i])) +
+      integrand(pProfile, mid_point + (half_diff * Gauss_Legendre_xi[i])));
+  }
+  *pEvaluation_count += NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_POINT_COUNT;
+
+  return (sum * half_diff);
+}
+
+/** Bottom side electron density without the F2 Epstein layer,
+ * i.e. the E and F1 layers with the correction around the F2 peak (Eq. 113),
+ * above 100 km
+ */
+static double_t bottom_side_corrected(
+  iono_profile_t* const pProfile,
+  const double_t height_km) {
+
+  bottom_side_info_t bottom_side_info;
+
+  bottom_side_get_B_params(&bottom_side_info, pProfile, height_km);
+  bottom_side_get_exp_params(&bottom_side_info, pProfile, height_km);
+  bottom_side_get_s_params(&bottom_side_info, pProfile);
+
+  return NEQUICK_G_JRC_ELE_DENSITY_TO_ELECTRON_DENSITY(
+    (bottom_side_info.F1.s + bottom_side_info.E.s));
+}
+
+/** Closed form integral of the F2 Epstein layer (Eq. 111) between two
+ * heights above 100 km and below hmF2:
+ * the antiderivative of A e/(1 + e)<SUP>2</SUP> is A B/(1 + 1/e).<br>
+ * The threshold of Eq. 114 is not applied, the layer is below
+ * 10<SUP>-10</SUP> of its peak there.
+ */
+static double_t bottom_side_F2_integral(
+  const iono_profile_t* const pProfile,
+  const double_t height_1_km,
+  const double_t height_2_km) {
+
+  const peak_t* const pPeak = &pProfile->F2.layer.peak;
+
+  double_t logistic_1 =
+    1.0 / (1.0 + exp((pPeak->height_km - height_1_km) /
+                     pPeak->thickness.bottom_km));
+  double_t logistic_2 =
+    1.0 / (1.0 + exp((pPeak->height_km - height_2_km) /
+                     pPeak->thickness.bottom_km));
+
+  return NEQUICK_G_JRC_ELE_DENSITY_TO_ELECTRON_DENSITY(
+    pPeak->amplitude * pPeak->thickness.bottom_km *
+    (logistic_2 - logistic_1));
+}
+
+/** Top side Epstein argument t = &Delta;h/H(&Delta;h), Eq. 122 to 125 */
+static double_t top_side_get_argument(
+  const double_t thickness_km,
+  const double_t height_above_F2_peak_km) {
+
+  double_t delta_height =
+    NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_1 * height_above_F2_peak_km;
+
+  return (
+    height_above_F2_peak_km /
+    (thickness_km *
+     (1.0 +
+      ((NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2 * delta_height) /
+       ((NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2 * thickness_km) +
+        delta_height)))));
+}
+
+/** Top side integrand in the Epstein argument t:
+ * the electron density is 4 N<SUB>m</SUB> e<SUP>-t</SUP>/(1 + e<SUP>-t</SUP>)<SUP>2</SUP>
+ * and &Delta;h(t) is the positive root of a quadratic, so the integrand
+ * is closed form, without #electron_density_get.
+ * The peak electron density factor is applied by the caller.
+ */
+static double_t top_side_integrand(
+  iono_profile_t* const pProfile,
+  const double_t argument) {
+
+  const double_t H0 = pProfile->F2.layer.peak.thickness.top_km;
+  const double_t g = NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_1;
+  const double_t r = NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2;
+
+  // g dh^2 + b dh - t r H0^2 = 0
+  double_t b = H0 * (r - (argument * g * (1.0 + r)));
+  double_t c = argument * r * H0 * H0;
+  double_t discriminant_sqrt = sqrt((b * b) + (4.0 * g * c));
+  double_t height_above_F2_peak_km = (2.0 * c) / (b + discriminant_sqrt);
+
+  double_t derivative =
+    ((H0 * g * (1.0 + r) * height_above_F2_peak_km) + (r * H0 * H0)) /
+    discriminant_sqrt;
+
+  double_t temp = exp(-argument);
+  return (
+    NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(
+      temp / NeQuickG_square(1.0 + temp)) *
+    derivative);
+}
+
+static double_t top_side_integral(
+  iono_profile_t* const pProfile,
+  const double_t height_1_km,
+  const double_t height_2_km,
+  size_t* const pEvaluation_count) {
+
+  static const double_t argument_breakpoint[] = {
+    NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_1,
+    NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_2,
+    NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_3,
+    NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_4
+  };
+
+  const double_t thickness_km = pProfile->F2.layer.peak.thickness.top_km;
+  double_t argument = top_side_get_argument(
+    thickness_km, height_1_km - pProfile->F2.layer.peak.height_km);
+  double_t argument_2 = top_side_get_argument(
+    thickness_km, height_2_km - pProfile->F2.layer.peak.height_km);
+
+  double_t integral = 0.0;
+  for (size_t i = 0;
+       i < (sizeof(argument_breakpoint)/sizeof(argument_breakpoint[0]));
+       i++) {
+    if ((argument_breakpoint[i] > argument) &&
+        (argument_breakpoint[i] < argument_2)) {
+      integral += Gauss_Legendre_integrate(
+        top_side_integrand,
+        pProfile,
+        argument,
+        argument_breakpoint[i],
+        pEvaluation_count);
+      argument = argument_breakpoint[i];
+    }
+  }
+  integral += Gauss_Legendre_integrate(
+    top_side_integrand,
+    pProfile,
+    argument,
+    argument_2,
+    pEvaluation_count);
+
+  // the peak electron density is the bottom side one at hmF2
+  return (
+    integral *
+    electron_density_get(pProfile, pProfile->F2.layer.peak.height_km));
+}
+
+double_t electron_density_get_integral(
+  iono_profile_t* const pProfile,
+  const double_t height_1_km,
+  const double_t height_2_km,
+  size_t* const pEvaluation_count) {
+
+  const double_t F2_peak_height_km = pProfile->F2.layer.peak.height_km;
+
+  *pEvaluation_count = 0;
+  double_t integral = 0.0;
+
+  // below 100 km: Eq. 120
+  integral += Gauss_Legendre_integrate(
+    electron_density_get,
+    pProfile,
+    max(height_1_km, NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_KM),
+    min(height_2_km, NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CORRECTION_ANCHOR_POINT),
+    pEvaluation_count);
+
+  // from 100 km to hmF2: closed form F2 layer, the corrected E and F1
+  // layers on panels split at their peaks and along the E layer topside
+  double_t bottom_height_km =
+    max(height_1_km, NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CORRECTION_ANCHOR_POINT);
+  double_t top_height_km = min(height_2_km, F2_peak_height_km);
+
+  if (top_height_km > bottom_height_km) {
+    integral += bottom_side_F2_integral(
+      pProfile, bottom_height_km, top_height_km);
+
+    const double_t E_peak_height_km = pProfile->E.layer.peak.height_km;
+    const double_t E_thickness_km = pProfile->E.layer.peak.thickness.top_km;
+    const double_t F1_peak_height_km = pProfile->F1.peak.height_km;
+
+    const double_t breakpoint_km[
+      NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_PANEL_COUNT_MAX - 1] = {
+      E_peak_height_km,
+      E_peak_height_km + (2.0 * E_thickness_km),
+      E_peak_height_km + (6.0 * E_thickness_km),
+      F1_peak_height_km,
+      (F1_peak_height_km + F2_peak_height_km) / 2.0
+    };
+
+    double_t height_km = bottom_height_km;
+    for (size_t i = 0;
+         i < (NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_PANEL_COUNT_MAX - 1);
+         i++) {
+      if ((breakpoint_km[i] > height_km) &&
+          (breakpoint_km[i] < top_height_km)) {
+        integral += Gauss_Legendre_integrate(
+          bottom_side_corrected,
+          pProfile,
+          height_km,
+          breakpoint_km[i],
+          pEvaluation_count);
+        height_km = breakpoint_km[i];
+      }
+    }
+    integral += Gauss_Legendre_integrate(
+      bottom_side_corrected,
+      pProfile,
+      height_km,
+      top_height_km,
+      pEvaluation_count);
+  }
+
+  // above hmF2
+  if (height_2_km > F2_peak_height_km) {
+    integral += top_side_integral(
+      pProfile,
+      max(height_1_km, F2_peak_height_km),
+      height_2_km,
+      pEvaluation_count);
+  }
+
+  return integral;
+}
+
+/** Semi-Epstein layer term of the bottom side with its derivatives:
+ * s and ds of #get_s_param and #get_ds_param
+ */
+typedef struct bottom_side_dual_st {
+  NeQuickG_dual_t s;
+  NeQuickG_dual_t ds;
+} bottom_side_dual_t;
+
+static void bottom_side_get_layer_dual(
+  const peak_dual_t* const pPeak,
+  const NeQuickG_dual_t* const pB_param,
+  const NeQuickG_dual_t* const pHeight_km,
+  const NeQuickG_dual_t* const pCorrection,
+  bottom_side_dual_t* const pLayer) {
+
+  NeQuickG_dual_t exponential_arg =
+    NeQuickG_dual_div(
+      NeQuickG_dual_sub(*pHeight_km, pPeak->height_km),
+      *pB_param);
+  if (pCorrection) {
+    exponential_arg = NeQuickG_dual_mul(exponential_arg, *pCorrection);
+  }
+
+  if (is_exponential_arg_above_threshold(exponential_arg.value)) {
+    pLayer->s = NeQuickG_dual_constant(0.0);
+    pLayer->ds = NeQuickG_dual_constant(0.0);
+    return;
+  }
+
+  NeQuickG_dual_t exponential = NeQuickG_dual_exp(exponential_arg);
+  NeQuickG_dual_t exponential_plus_1 =
+    NeQuickG_dual_linear(exponential, 1.0, 1.0);
+
+  pLayer->s =
+    NeQuickG_dual_div(
+      NeQuickG_dual_mul(pPeak->amplitude, exponential),
+      NeQuickG_dual_square(exponential_plus_1));
+
+  pLayer->ds =
+    NeQuickG_dual_div(
+      NeQuickG_dual_div(
+        NeQuickG_dual_linear(exponential, -1.0, 1.0),
+        exponential_plus_1),
+      *pB_param);
+}
+
+/** #bottom_side with the derivatives */
+static NeQuickG_dual_t bottom_side_dual(
+  const iono_profile_dual_t* const pProfile,
+  const NeQuickG_dual_t* const pHeight_km) {
+
+  const peak_dual_t* const pF2 = &pProfile->F2.layer.peak;
+  const peak_dual_t* const pF1 = &pProfile->F1.peak;
+  const peak_dual_t* const pE = &pProfile->E.peak;
+
+  NeQuickG_dual_t height_km =
+    (pHeight_km->value >
+      NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CORRECTION_ANCHOR_POINT) ?
+    *pHeight_km :
+    NeQuickG_dual_constant(
+      NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CORRECTION_ANCHOR_POINT);
+
+  NeQuickG_dual_t height_above_F2_peak_km =
+    NeQuickG_dual_sub(height_km, pF2->height_km);
+
+  NeQuickG_dual_t correction =
+    NeQuickG_dual_exp(
+      NeQuickG_dual_div(
+        NeQuickG_dual_constant(NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CONST_1),
+        NeQuickG_dual_linear(
+          height_above_F2_peak_km,
+          (height_above_F2_peak_km.value < 0.0) ?
+            -NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CONST_2 :
+            NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CONST_2,
+          1.0)));
+
+  bottom_side_dual_t F2;
+  bottom_side_get_layer_dual(
+    pF2, &pF2->thickness.bottom_km, &height_km, NULL, &F2);
+
+  bottom_side_dual_t F1;
+  bottom_side_get_layer_dual(
+    pF1,
+    (pHeight_km->value > pF1->height_km.value) ?
+      &pF1->thickness.top_km :
+      &pF1->thickness.bottom_km,
+    &height_km, &correction, &F1);
+
+  bottom_side_dual_t E;
+  bottom_side_get_layer_dual(
+    pE,
+    (pHeight_km->value > pE->height_km.value) ?
+      &pE->thickness.top_km :
+      &pE->thickness.bottom_km,
+    &height_km, &correction, &E);
+
+  NeQuickG_dual_t electron_density =
+    NeQuickG_dual_add(NeQuickG_dual_add(F2.s, F1.s), E.s);
+
+  if (pHeight_km->value <
+      NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CORRECTION_ANCHOR_POINT) {
+
+    NeQuickG_dual_t s_ds_sum =
+      NeQuickG_dual_add(
+        NeQuickG_dual_add(
+          NeQuickG_dual_mul(F2.s, F2.ds),
+          NeQuickG_dual_mul(F1.s, F1.ds)),
+        NeQuickG_dual_mul(E.s, E.ds));
+
+    // chapman parameters BC and Z
+    NeQuickG_dual_t BC =
+      NeQuickG_dual_linear(
+        NeQuickG_dual_div(s_ds_sum, electron_density),
+        -NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_SCALE,
+        1.0);
+
+    NeQuickG_dual_t Z =
+      NeQuickG_dual_linear(
+        *pHeight_km,
+        1.0 / NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_SCALE,
+        -NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_CORRECTION_ANCHOR_POINT /
+          NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_SCALE);
+
+    electron_density =
+      NeQuickG_dual_mul(
+        electron_density,
+        NeQuickG_dual_exp(
+          NeQuickG_dual_linear(
+            NeQuickG_dual_add(
+              NeQuickG_dual_mul(BC, Z),
+              NeQuickG_dual_exp(NeQuickG_dual_linear(Z, -1.0, 0.0))),
+            -1.0,
+            1.0)));
+  }
+
+  return NeQuickG_dual_linear(
+    electron_density,
+    NEQUICK_G_JRC_ELE_DENSITY_TO_ELECTRON_DENSITY(1.0),
+    0.0);
+}
+
+/** #top_side with the derivatives */
+static NeQuickG_dual_t top_side_dual(
+  iono_profile_dual_t* const pProfile,
+  const NeQuickG_dual_t* const pHeight_km) {
+
+  peak_dual_t* const pF2 = &pProfile->F2.layer.peak;
+
+  NeQuickG_dual_t height_above_F2_peak_km =
+    NeQuickG_dual_sub(*pHeight_km, pF2->height_km);
+
+  NeQuickG_dual_t delta_height =
+    NeQuickG_dual_linear(
+      height_above_F2_peak_km,
+      NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_1,
+      0.0);
+
+  NeQuickG_dual_t temp =
+    NeQuickG_dual_exp(
+      NeQuickG_dual_div(
+        height_above_F2_peak_km,
+        NeQuickG_dual_mul(
+          pF2->thickness.top_km,
+          NeQuickG_dual_linear(
+            NeQuickG_dual_div(
+              NeQuickG_dual_linear(
+                delta_height, NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2, 0.0),
+              NeQuickG_dual_add(
+                NeQuickG_dual_linear(
+                  pF2->thickness.top_km,
+                  NEQUICK_G_JRC_ELE_DENSITY_TOP_CONST_2,
+                  0.0),
+                delta_height)),
+            1.0,
+            1.0))));
+
+  if (temp.value > NEQUICK_G_JRC_ELE_DENSITY_TOP_APROXIMATION_EPSILON) {
+    temp = NeQuickG_dual_div(NeQuickG_dual_constant(1.0), temp);
+  } else {
+    temp = NeQuickG_dual_div(
+      temp,
+      NeQuickG_dual_square(NeQuickG_dual_linear(temp, 1.0, 1.0)));
+  }
+
+  if (isnan(pF2->electron_density.value)) {
+    pF2->electron_density = bottom_side_dual(pProfile, &pF2->height_km);
+  }
+  return NeQuickG_dual_mul(
+    NeQuickG_dual_linear(temp, NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(1.0), 0.0),
+    pF2->electron_density);
+}
+
+NeQuickG_dual_t electron_density_get_dual(
+  iono_profile_dual_t* const pProfile,
+  const NeQuickG_dual_t* const pHeight_km) {
+
+  if (pHeight_km->value > pProfile->F2.layer.peak.height_km.value) {
+    return top_side_dual(pProfile, pHeight_km);
+  } else {
+    return bottom_side_dual(pProfile, pHeight_km);
+  }
+}
+
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_KM
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_POINT_COUNT
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_BOTTOM_PANEL_COUNT_MAX
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_1
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_2
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_3
+#undef NEQUICK_G_JRC_ELE_DENSITY_INTEGRAL_TOP_BREAKPOINT_4
+
 #undef NEQUICK_G_JRC_ELE_DENSITY_TO_ELECTRON_DENSITY
 
 #undef NEQUICK_G_JRC_ELE_DENSITY_BOTTOM_EPSILON
@@ -0,0 +1,42 @@
+/** NeQuick G JRC error state
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_error.h"
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_macros.h"
+
+/** Last error */
+typedef struct NeQuickG_error_st {
+  /** error source */
+  int32_t source;
+  /** error code */
+  int32_t code;
+} NeQuickG_error_t;
+
+/** The only library state outside the model and the handles:
+ * one instance per thread, zero initialized i.e. no error
+ */
+static NEQUICK_G_THREAD_LOCAL NeQuickG_error_t g_NeQuickG_last_error;
+
+void NeQuickG_error_set_last(
+  int32_t error_src,
+  int32_t error_code) {
+  g_NeQuickG_last_error.source = error_src;
+  g_NeQuickG_last_error.code = error_code;
+}
+
+int32_t NeQuickG_error_get_last(
+  int32_t* const pError_code) {
+  if (pError_code) {
+    *pError_code = g_NeQuickG_last_error.code;
+  }
+  return g_NeQuickG_last_error.source;
+}
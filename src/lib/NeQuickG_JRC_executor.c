@@ -0,0 +1,330 @@
+/** NeQuickG parallel executor for batches of links.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_executor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "NeQuickG_JRC_batch.h"
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_macros.h"
+#include "NeQuickG_JRC_solar_activity.h"
+
+/** Each worker gets at least this number of chunks, so that there is
+ * something left to steal when the cost of the links is uneven.
+ */
+#define NEQUICK_G_EXECUTOR_CHUNKS_PER_THREAD (8)
+/** Upper bound of the links per chunk */
+#define NEQUICK_G_EXECUTOR_CHUNK_SIZE_MAX (32)
+
+static size_t get_chunk_count(const NeQuickG_executor_t* const pExecutor) {
+  return (
+    (pExecutor->pLinks->count + pExecutor->chunk_size - 1) /
+    pExecutor->chunk_size);
+}
+
+/** Takes the first chunk of the worker queue */
+static bool pop_chunk(
+  NeQuickG_executor_queue_t* const pQueue,
+  size_t* const pChunk) {
+
+  bool is_found = false;
+  pthread_mutex_lock(&pQueue->lock);
+  if (pQueue->begin < pQueue->end) {
+    *pChunk = pQueue->begin++;
+    is_found = true;
+  }
+  pthread_mutex_unlock(&pQueue->lock);
+  return is_found;
+}
+
+/** Moves the last half of the chunks of another worker to the worker queue,
+ * the victims are visited in order starting from the next worker.
+ */
+static bool steal_chunks(NeQuickG_executor_worker_t* const pThief) {
+
+  const NeQuickG_executor_t* const pExecutor = pThief->pExecutor;
+  size_t thief_index = (size_t)(pThief - pExecutor->pWorkers);
+
+  for (size_t i = 1; i < pExecutor->thread_count; i++) {
+    NeQuickG_executor_queue_t* pVictim_queue =
+      &pExecutor->pWorkers[
+        (thief_index + i) % pExecutor->thread_count].queue;
+
+    size_t begin = 0;
+    size_t end = 0;
+    pthread_mutex_lock(&pVictim_queue->lock);
+    if (pVictim_queue->begin < pVictim_queue->end) {
+      end = pVictim_queue->end;
+      begin = end - ((end - pVictim_queue->begin + 1) / 2);
+      pVictim_queue->end = begin;
+    }
+    pthread_mutex_unlock(&pVictim_queue->lock);
+
+    if (begin < end) {
+      pthread_mutex_lock(&pThief->queue.lock);
+      pThief->queue.begin = begin;
+      pThief->queue.end = end;
+      pthread_mutex_unlock(&pThief->queue.lock);
+      return true;
+    }
+  }
+  return false;
+}
+
+static void evaluate_chunk(
+  NeQuickG_executor_worker_t* const pWorker,
+  size_t chunk) {
+
+  const NeQuickG_executor_t* const pExecutor = pWorker->pExecutor;
+  const NeQuickG_links_t* const pLinks = pExecutor->pLinks;
+
+  size_t first = chunk*pExecutor->chunk_size;
+
+  NeQuickG_links_t links;
+  links.count = min(pExecutor->chunk_size, pLinks->count - first);
+  links.pMonth = &pLinks->pMonth[first];
+  links.pUTC = &pLinks->pUTC[first];
+  links.pReceiver_longitude_degree = &pLinks->pReceiver_longitude_degree[first];
+  links.pReceiver_latitude_degree = &pLinks->pReceiver_latitude_degree[first];
+  links.pReceiver_height_meters = &pLinks->pReceiver_height_meters[first];
+  links.pSatellite_longitude_degree = &pLinks->pSatellite_longitude_degree[first];
+  links.pSatellite_latitude_degree = &pLinks->pSatellite_latitude_degree[first];
+  links.pSatellite_height_meters = &pLinks->pSatellite_height_meters[first];
+
+  // the per link status holds the errors
+  int32_t ret = NeQuickG_batch_get_total_electron_content(
+    &pWorker->context,
+    &links,
+    &pExecutor->pTEC[first],
+    &pExecutor->pStatus[first]);
+
+  // the last error is thread-local, the caller gets it from the worker
+  if ((ret != NEQUICK_OK) && (first < pWorker->error_link)) {
+    pWorker->error_link = first;
+    pWorker->error_source = ret;
+    (void)NeQuickG_error_get_last(&pWorker->error_code);
+  }
+}
+
+static void evaluate_job(NeQuickG_executor_worker_t* const pWorker) {
+
+  pWorker->error_link = pWorker->pExecutor->pLinks->count;
+
+  // the coefficients were validated before the job was posted
+  (void)solar_activity_coefficients_set(
+    &pWorker->context.solar_activity,
+    pWorker->pExecutor->az,
+    (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT);
+
+  size_t chunk;
+  for (;;) {
+    if (pop_chunk(&pWorker->queue, &chunk)) {
+      evaluate_chunk(pWorker, chunk);
+    } else if (!steal_chunks(pWorker)) {
+      break;
+    }
+  }
+}
+
+static void* worker_run(void* pArg) {
+
+  NeQuickG_executor_worker_t* const pWorker =
+    (NeQuickG_executor_worker_t*)pArg;
+  NeQuickG_executor_t* const pExecutor = pWorker->pExecutor;
+
+  for (;;) {
+    pthread_mutex_lock(&pExecutor->lock);
+    while (!pExecutor->is_closing &&
+           (pExecutor->job_id == pWorker->job_id)) {
+      pthread_cond_wait(&pExecutor->job_ready, &pExecutor->lock);
+    }
+    if (pExecutor->is_closing) {
+      pthread_mutex_unlock(&pExecutor->lock);
+      return NULL;
+    }
+    pWorker->job_id = pExecutor->job_id;
+    pthread_mutex_unlock(&pExecutor->lock);
+
+    evaluate_job(pWorker);
+
+    pthread_mutex_lock(&pExecutor->lock);
+    pExecutor->workers_busy--;
+    if (pExecutor->workers_busy == 0) {
+      pthread_cond_signal(&pExecutor->job_done);
+    }
+    pthread_mutex_unlock(&pExecutor->lock);
+  }
+}
+
+/** Stops the first started_count workers */
+static void stop_workers(
+  NeQuickG_executor_t* const pExecutor,
+  size_t started_count) {
+
+  pthread_mutex_lock(&pExecutor->lock);
+  pExecutor->is_closing = true;
+  pthread_cond_broadcast(&pExecutor->job_ready);
+  pthread_mutex_unlock(&pExecutor->lock);
+
+  for (size_t i = 0; i < started_count; i++) {
+    pthread_join(pExecutor->pWorkers[i].thread, NULL);
+  }
+  for (size_t i = 0; i < pExecutor->thread_count; i++) {
+    pthread_mutex_destroy(&pExecutor->pWorkers[i].queue.lock);
+    NeQuickG_context_close(&pExecutor->pWorkers[i].context);
+  }
+  pthread_cond_destroy(&pExecutor->job_done);
+  pthread_cond_destroy(&pExecutor->job_ready);
+  pthread_mutex_destroy(&pExecutor->lock);
+
+  free(pExecutor->pWorkers);
+  pExecutor->pWorkers = NULL;
+}
+
+int32_t NeQuickG_executor_init(
+  NeQuickG_executor_t* const pExecutor,
+  const NeQuickG_model_t* const pModel,
+  size_t thread_count) {
+
+  if (thread_count == 0) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_THREAD_COUNT,
+      "Executor. the thread count must be at least 1");
+  }
+
+  pExecutor->pWorkers =
+    calloc(thread_count, sizeof(NeQuickG_executor_worker_t));
+  if (!pExecutor->pWorkers) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to allocate the executor workers on the heap");
+  }
+
+  pExecutor->job_id = 0;
+  pExecutor->workers_busy = 0;
+  pExecutor->is_closing = false;
+  pExecutor->thread_count = thread_count;
+  pthread_mutex_init(&pExecutor->lock, NULL);
+  pthread_cond_init(&pExecutor->job_ready, NULL);
+  pthread_cond_init(&pExecutor->job_done, NULL);
+
+  for (size_t i = 0; i < thread_count; i++) {
+    NeQuickG_executor_worker_t* pWorker = &pExecutor->pWorkers[i];
+    pWorker->pExecutor = pExecutor;
+    pWorker->job_id = 0;
+    pthread_mutex_init(&pWorker->queue.lock, NULL);
+    NeQuickG_context_init(&pWorker->context, pModel);
+  }
+
+  for (size_t i = 0; i < thread_count; i++) {
+    if (pthread_create(
+          &pExecutor->pWorkers[i].thread,
+          NULL,
+          worker_run,
+          &pExecutor->pWorkers[i]) != 0) {
+      stop_workers(pExecutor, i);
+      NEQUICK_ERROR_RETURN(
+        NEQUICK_ERROR_SRC_MEMORY,
+        NEQUICK_ERROR_CODE_NO_RESOURCES,
+        "Not enough resources to create the executor thread %zu", i);
+    }
+  }
+  return NEQUICK_OK;
+}
+
+void NeQuickG_executor_close(
+  NeQuickG_executor_t* const pExecutor) {
+  if (pExecutor->pWorkers) {
+    stop_workers(pExecutor, pExecutor->thread_count);
+  }
+}
+
+int32_t NeQuickG_executor_get_total_electron_content(
+  NeQuickG_executor_t* const pExecutor,
+  const double_t* const pAz,
+  size_t az_size,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus) {
+
+  int32_t ret = NeQuickG_batch_check_links(pLinks, pTEC, pStatus);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  {
+    solar_activity_t solar_activity;
+    ret = solar_activity_coefficients_set(&solar_activity, pAz, az_size);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+  }
+
+  if (pLinks->count == 0) {
+    return NEQUICK_OK;
+  }
+
+  memcpy(pExecutor->az, pAz, sizeof(pExecutor->az));
+  pExecutor->pLinks = pLinks;
+  pExecutor->pTEC = pTEC;
+  pExecutor->pStatus = pStatus;
+  pExecutor->chunk_size =
+    pLinks->count /
+    (pExecutor->thread_count*NEQUICK_G_EXECUTOR_CHUNKS_PER_THREAD);
+  pExecutor->chunk_size =
+    max(min(pExecutor->chunk_size, (size_t)NEQUICK_G_EXECUTOR_CHUNK_SIZE_MAX),
+        (size_t)1);
+
+  // deal the chunks evenly
+  size_t chunk_count = get_chunk_count(pExecutor);
+  for (size_t i = 0; i < pExecutor->thread_count; i++) {
+    NeQuickG_executor_queue_t* pQueue = &pExecutor->pWorkers[i].queue;
+    pthread_mutex_lock(&pQueue->lock);
+    pQueue->begin = (i*chunk_count) / pExecutor->thread_count;
+    pQueue->end = ((i + 1)*chunk_count) / pExecutor->thread_count;
+    pthread_mutex_unlock(&pQueue->lock);
+  }
+
+  pthread_mutex_lock(&pExecutor->lock);
+  pExecutor->workers_busy = pExecutor->thread_count;
+  pExecutor->job_id++;
+  pthread_cond_broadcast(&pExecutor->job_ready);
+  while (pExecutor->workers_busy > 0) {
+    pthread_cond_wait(&pExecutor->job_done, &pExecutor->lock);
+  }
+  pthread_mutex_unlock(&pExecutor->lock);
+
+  // the chunks are disjoint: the worker with the first chunk that failed
+  // holds the error of the first link that failed
+  const NeQuickG_executor_worker_t* pError_worker = NULL;
+  for (size_t i = 0; i < pExecutor->thread_count; i++) {
+    const NeQuickG_executor_worker_t* pWorker = &pExecutor->pWorkers[i];
+    if ((pWorker->error_link < pLinks->count) &&
+        (!pError_worker ||
+         (pWorker->error_link < pError_worker->error_link))) {
+      pError_worker = pWorker;
+    }
+  }
+
+  if (!pError_worker) {
+    return NEQUICK_OK;
+  }
+
+  NeQuickG_error_set_last(
+    pError_worker->error_source, pError_worker->error_code);
+  return pError_worker->error_source;
+}
+
+#undef NEQUICK_G_EXECUTOR_CHUNK_SIZE_MAX
+#undef NEQUICK_G_EXECUTOR_CHUNKS_PER_THREAD
@@ -0,0 +1,121 @@
+/** NeQuickG integration mesh of the links of a session.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_integration_mesh.h"
+
+#include <string.h>
+
+/** A segment whose end points moved by more than this fraction of its
+ * length starts from scratch: the link ID was reused for another link,
+ * or there was a long gap between the epochs.
+ */
+#define NEQUICK_G_JRC_MESH_JUMP_FRACTION (0.1)
+
+void integration_mesh_cache_init(
+  integration_mesh_cache_t* const pCache) {
+  memset(pCache, 0, sizeof(*pCache));
+}
+
+integration_mesh_t* integration_mesh_cache_get(
+  integration_mesh_cache_t* const pCache,
+  const uint32_t link_id) {
+
+  pCache->clock++;
+
+  integration_mesh_t* pLeast_recently_used = &pCache->mesh[0];
+  for (size_t i = 0; i < NEQUICK_G_JRC_MESH_LINK_COUNT; i++) {
+    integration_mesh_t* pMesh = &pCache->mesh[i];
+    if (pMesh->is_valid && (pMesh->link_id == link_id)) {
+      pMesh->last_use = pCache->clock;
+      return pMesh;
+    }
+    if (pMesh->last_use < pLeast_recently_used->last_use) {
+      pLeast_recently_used = pMesh;
+    }
+  }
+
+  pLeast_recently_used->link_id = link_id;
+  pLeast_recently_used->is_valid = false;
+  pLeast_recently_used->last_use = pCache->clock;
+  return pLeast_recently_used;
+}
+
+void integration_mesh_begin(
+  integration_mesh_t* const pNext_mesh,
+  const integration_mesh_t* const pMesh) {
+  pNext_mesh->link_id = pMesh->link_id;
+  pNext_mesh->is_valid = true;
+  pNext_mesh->last_use = pMesh->last_use;
+  pNext_mesh->segment_count = 0;
+  pNext_mesh->interval_count = 0;
+}
+
+void integration_mesh_add_segment(
+  integration_mesh_t* const pMesh,
+  const double_t point_1_km,
+  const double_t point_2_km) {
+
+  if (pMesh->segment_count == NEQUICK_G_JRC_MESH_SEGMENT_COUNT_MAX) {
+    pMesh->is_valid = false;
+    return;
+  }
+
+  integration_mesh_segment_t* pSegment =
+    &pMesh->segment[pMesh->segment_count++];
+  pSegment->point_1_km = point_1_km;
+  pSegment->point_2_km = point_2_km;
+  pSegment->first_interval = pMesh->interval_count;
+  pSegment->interval_count = 0;
+}
+
+void integration_mesh_add_interval(
+  integration_mesh_t* const pMesh,
+  const size_t depth,
+  const double_t error_ratio) {
+
+  if (!pMesh->is_valid ||
+      (pMesh->interval_count == NEQUICK_G_JRC_MESH_INTERVAL_COUNT_MAX)) {
+    pMesh->is_valid = false;
+    return;
+  }
+
+  integration_mesh_interval_t* pInterval =
+    &pMesh->interval[pMesh->interval_count++];
+  pInterval->depth = depth;
+  pInterval->error_ratio = error_ratio;
+
+  pMesh->segment[pMesh->segment_count - 1].interval_count++;
+}
+
+const integration_mesh_segment_t* integration_mesh_get_segment(
+  const integration_mesh_t* const pMesh,
+  const size_t index,
+  const double_t point_1_km,
+  const double_t point_2_km) {
+
+  if (!pMesh->is_valid || (index >= pMesh->segment_count)) {
+    return NULL;
+  }
+
+  const integration_mesh_segment_t* pSegment = &pMesh->segment[index];
+
+  double_t shift_km =
+    fabs(point_1_km - pSegment->point_1_km) +
+    fabs(point_2_km - pSegment->point_2_km);
+  if (shift_km >
+      (NEQUICK_G_JRC_MESH_JUMP_FRACTION *
+       (pSegment->point_2_km - pSegment->point_1_km))) {
+    return NULL;
+  }
+
+  return pSegment;
+}
+
+#undef NEQUICK_G_JRC_MESH_JUMP_FRACTION
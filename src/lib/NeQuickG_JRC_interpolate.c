@@ -30,14 +30,9 @@
 /** Second Constant used in interpolation_third_order */
 #define NEQUICK_G_JRC_INTERPOL_SECOND_CONST (16.0)
 
-double_t interpolation_third_order(
+static void get_coefficients(
   const double_t interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT],
-  double_t offset) {
-  double_t result = 0.0;
-
-  if (fabs(offset) < NEQUICK_G_JRC_INTERPOL_EPSILON) {
-    return interpol_points[NEQUICK_G_JRC_INTERPOL_POINT_1_INDEX];
-  }
+  double_t coefficients[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT]) {
 
   double_t sum_1_2 = interpol_points[NEQUICK_G_JRC_INTERPOL_POINT_2_INDEX] +
                    interpol_points[NEQUICK_G_JRC_INTERPOL_POINT_1_INDEX];
@@ -50,7 +45,6 @@ double_t interpolation_third_order(
                      interpol_points[NEQUICK_G_JRC_INTERPOL_POINT_0_INDEX])/
                      (double_t)((double_t)NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT - 1.0);
 
-  double_t coefficients[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
   {
      size_t i = 0;
      coefficients[i++] =
@@ -60,6 +54,20 @@ double_t interpolation_third_order(
      coefficients[i++] = (sum_3_0 - sum_1_2);
      coefficients[i] = (grad_3_0 - grad_2_1);
   }
+}
+
+double_t interpolation_third_order(
+  const double_t interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT],
+  double_t offset) {
+  double_t result = 0.0;
+
+  if (fabs(offset) < NEQUICK_G_JRC_INTERPOL_EPSILON) {
+    return interpol_points[NEQUICK_G_JRC_INTERPOL_POINT_1_INDEX];
+  }
+
+  double_t coefficients[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+  get_coefficients(interpol_points, coefficients);
+
   double_t delta = (2.0 * offset) - 1.0;
   for (int_fast8_t i = NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT - 1;
        i >= 0x00 ; i--) {
@@ -68,6 +76,22 @@ double_t interpolation_third_order(
   return (result / NEQUICK_G_JRC_INTERPOL_SECOND_CONST);
 }
 
+double_t interpolation_third_order_derivative(
+  const double_t interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT],
+  double_t offset) {
+  double_t result = 0.0;
+
+  double_t coefficients[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT];
+  get_coefficients(interpol_points, coefficients);
+
+  double_t delta = (2.0 * offset) - 1.0;
+  for (int_fast8_t i = NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT - 1;
+       i >= 0x01 ; i--) {
+    result = (result * delta) + ((double_t)i * coefficients[i]);
+  }
+  return ((2.0 * result) / NEQUICK_G_JRC_INTERPOL_SECOND_CONST);
+}
+
 #undef NEQUICK_G_JRC_INTERPOL_EPSILON
 #undef NEQUICK_G_JRC_INTERPOL_POINT_0_INDEX
 #undef NEQUICK_G_JRC_INTERPOL_POINT_1_INDEX
@@ -94,6 +94,8 @@ void E_layer_get_critical_freq_MHz(
   {
     if (!pLayer->is_solar_declination_valid) {
       pLayer->solar_declination = solar_get_declination(pTime);
+      // depends only on the time, reset when the time is set
+      pLayer->is_solar_declination_valid = true;
     }
 
     solar_effective_angle_degree =
@@ -121,11 +123,91 @@ void E_layer_get_critical_freq_MHz(
     NEQUICK_G_JRC_IONO_GET_e_DENSITY(pLayer->layer.critical_frequency_MHz);
 }
 
+void E_layer_get_critical_freq_MHz_dual(
+  E_layer_t* const pLayer,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_dual_t* const pSolar_activity,
+  const position_t* const pPosition,
+  layer_dual_t* const pE) {
+
+  NeQuickG_dual_t solar_effective_angle_degree;
+  {
+    if (!pLayer->is_solar_declination_valid) {
+      pLayer->solar_declination = solar_get_declination(pTime);
+      pLayer->is_solar_declination_valid = true;
+    }
+
+    solar_effective_angle_degree =
+      solar_get_effective_zenith_angle_dual(
+        pPosition, pTime, &pLayer->solar_declination);
+  }
+
+  NeQuickG_dual_t parameter;
+  {
+    NeQuickG_dual_t ee =
+      NeQuickG_dual_exp(
+        NeQuickG_dual_linear(
+          NeQuickG_dual_variable(
+            pPosition->latitude.degree, NEQUICKG_DUAL_PARTIAL_LATITUDE),
+          NEQUICK_G_JRC_IONO_E_LAYER_LAT_FACTOR,
+          0.0));
+    parameter =
+      NeQuickG_dual_linear(
+        NeQuickG_dual_div(
+          NeQuickG_dual_linear(ee, 1.0, -1.0),
+          NeQuickG_dual_linear(ee, 1.0, 1.0)),
+        get_seasonal_parameter(pTime),
+        0.0);
+  }
+
+  NeQuickG_dual_t critical_freq =
+    NeQuickG_dual_mul(
+      NeQuickG_dual_linear(
+        parameter,
+        -NEQUICK_G_JRC_IONO_E_LAYER_CONSTANT_2,
+        NEQUICK_G_JRC_IONO_E_LAYER_CONSTANT_1),
+      NeQuickG_dual_sqrt(
+        NeQuickG_dual_sqrt(pSolar_activity->effective_ionisation_level_sfu)));
+
+  critical_freq =
+    NeQuickG_dual_mul(
+      critical_freq,
+      NeQuickG_dual_exp(
+        NeQuickG_dual_linear(
+          NeQuickG_dual_log(
+            NeQuickG_dual_cos(
+              NeQuickG_dual_linear(
+                solar_effective_angle_degree,
+                NEQUICKG_JRC_DEGREE_TO_RAD(1.0),
+                0.0))),
+          NEQUICK_G_JRC_IONO_E_LAYER_CONSTANT_3,
+          0.0)));
+
+  pE->critical_frequency_MHz =
+    NeQuickG_dual_sqrt(
+      NeQuickG_dual_linear(
+        NeQuickG_dual_square(critical_freq),
+        1.0,
+        NEQUICK_G_JRC_IONO_E_LAYER_CONSTANT_4));
+
+  pE->peak.electron_density =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_square(pE->critical_frequency_MHz),
+      NEQUICK_G_JRC_FREQ_TO_NE_FACTOR_D,
+      0.0);
+}
+
 void E_layer_get_peak_height(E_layer_t* const pLayer) {
   pLayer->layer.peak.height_km =
     NEQUICK_G_JRC_IONO_E_LAYER_MAX_e_DENSITY_HEIGHT_KM;
 }
 
+void E_layer_get_peak_height_dual(layer_dual_t* const pE) {
+  pE->peak.height_km =
+    NeQuickG_dual_constant(
+      NEQUICK_G_JRC_IONO_E_LAYER_MAX_e_DENSITY_HEIGHT_KM);
+}
+
 void E_layer_get_peak_thickness(
   E_layer_t* const pE,
   const double_t F1_peak_thickness_bottom_km) {
@@ -136,6 +218,20 @@ void E_layer_get_peak_thickness(
   pE->layer.peak.thickness.bottom_km = NEQUICK_G_JRC_IONO_E_LAYER_BOTTOM_KM;
 }
 
+void E_layer_get_peak_thickness_dual(
+  layer_dual_t* const pE,
+  const NeQuickG_dual_t* const pF1_peak_thickness_bottom_km) {
+
+  pE->peak.thickness.top_km =
+    (pF1_peak_thickness_bottom_km->value >=
+      NEQUICK_G_JRC_IONO_E_LAYER_MIN_TOP_KM) ?
+    *pF1_peak_thickness_bottom_km :
+    NeQuickG_dual_constant(NEQUICK_G_JRC_IONO_E_LAYER_MIN_TOP_KM);
+
+  pE->peak.thickness.bottom_km =
+    NeQuickG_dual_constant(NEQUICK_G_JRC_IONO_E_LAYER_BOTTOM_KM);
+}
+
 void E_layer_init(E_layer_t* const pE) {
   pE->is_solar_declination_valid = false;
 }
@@ -84,6 +84,86 @@ void F1_layer_get_peak_thickness(
     (pF1->peak.height_km - E_peak_height_km);
 }
 
+void F1_layer_get_critical_freq_MHz_dual(
+  layer_dual_t* const pLayer,
+  const NeQuickG_dual_t* const pCritical_freq_E_layer_MHz,
+  const NeQuickG_dual_t* const pCritical_freq_F2_layer_MHz) {
+
+  NeQuickG_dual_t critical_freq_F1_layer_MHz =
+    NeQuickG_dual_func_join(
+      NeQuickG_dual_linear(
+        *pCritical_freq_E_layer_MHz,
+        NEQUICK_G_JRC_IONO_F1_LAYER_TITHERIDGE_FACTOR,
+        0.0),
+      NeQuickG_dual_constant(0.0),
+      NEQUICK_G_JRC_IONO_F1_LAYER_JOIN_FRACTIONAL_1,
+      NeQuickG_dual_linear(*pCritical_freq_E_layer_MHz, 1.0, -2.0));
+
+  critical_freq_F1_layer_MHz =
+    NeQuickG_dual_func_join(
+      NeQuickG_dual_constant(0.0),
+      critical_freq_F1_layer_MHz,
+      NEQUICK_G_JRC_IONO_F1_LAYER_JOIN_FRACTIONAL_1,
+      NeQuickG_dual_sub(
+        *pCritical_freq_E_layer_MHz, critical_freq_F1_layer_MHz));
+
+  critical_freq_F1_layer_MHz =
+    NeQuickG_dual_func_join(
+      critical_freq_F1_layer_MHz,
+      NeQuickG_dual_linear(
+        critical_freq_F1_layer_MHz,
+        NEQUICK_G_JRC_IONO_F1_LAYER_HEIGHT_CONSTANT,
+        0.0),
+      NEQUICK_G_JRC_IONO_F1_LAYER_JOIN_FRACTIONAL_2,
+      NeQuickG_dual_sub(
+        NeQuickG_dual_linear(
+          *pCritical_freq_F2_layer_MHz,
+          NEQUICK_G_JRC_IONO_F1_LAYER_HEIGHT_CONSTANT,
+          0.0),
+        critical_freq_F1_layer_MHz));
+
+  pLayer->critical_frequency_MHz =
+    (critical_freq_F1_layer_MHz.value <
+      NEQUICK_G_JRC_IONO_F1_FREQUENCY_LOWER_LIMIT_MHZ) ?
+    NeQuickG_dual_constant(0.0) :
+    critical_freq_F1_layer_MHz;
+
+  pLayer->peak.electron_density =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_square(pLayer->critical_frequency_MHz),
+      NEQUICK_G_JRC_FREQ_TO_NE_FACTOR_D,
+      0.0);
+}
+
+void F1_layer_get_peak_height_dual(
+  layer_dual_t* const pLayer,
+  const NeQuickG_dual_t* const pE_peak_height_km,
+  const NeQuickG_dual_t* const pF2_peak_height_km) {
+  pLayer->peak.height_km =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_add(*pE_peak_height_km, *pF2_peak_height_km),
+      0.5,
+      0.0);
+}
+
+void F1_layer_get_peak_thickness_dual(
+  layer_dual_t* const pF1,
+  const NeQuickG_dual_t* const pE_peak_height_km,
+  const NeQuickG_dual_t* const pF2_peak_height_km) {
+
+  pF1->peak.thickness.top_km =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_sub(*pF2_peak_height_km, pF1->peak.height_km),
+      NEQUICK_G_JRC_IONO_F1_LAYER_THICKNESS_TOP_FACTOR,
+      0.0);
+
+  pF1->peak.thickness.bottom_km =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_sub(pF1->peak.height_km, *pE_peak_height_km),
+      NEQUICK_G_JRC_IONO_F1_LAYER_THICKNESS_BOTTOM_FACTOR,
+      0.0);
+}
+
 #undef NEQUICK_G_JRC_IONO_F1_LAYER_THICKNESS_TOP_FACTOR
 #undef NEQUICK_G_JRC_IONO_F1_LAYER_THICKNESS_BOTTOM_FACTOR
 
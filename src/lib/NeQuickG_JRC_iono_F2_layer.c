@@ -257,6 +257,155 @@ static double_t legendre_expansion(
   return parameter;
 }
 
+/** Variables of the Legendre expansion with their derivatives */
+typedef struct legendre_dual_st {
+  /** modip coefficients, see #get_legrende_coeff_for_modip */
+  double_t modip_coeff[NEQUICKG_JRC_IONO_F2_LAYER_MODIP_COEFF_COUNT];
+  /** derivatives of the modip coefficients with respect to sin(MODIP) */
+  double_t modip_coeff_derivative[NEQUICKG_JRC_IONO_F2_LAYER_MODIP_COEFF_COUNT];
+  /** longitude coefficients, see #get_legrende_coeff_for_longitude */
+  double_t long_coeff_sinus[NEQUICKG_JRC_IONO_F2_LAYER_LONG_COEFF_COUNT];
+  /** longitude coefficients, see #get_legrende_coeff_for_longitude */
+  double_t long_coeff_cosinus[NEQUICKG_JRC_IONO_F2_LAYER_LONG_COEFF_COUNT];
+  /** sin(MODIP) */
+  NeQuickG_dual_t sin_modip;
+  /** cosinus of the latitude */
+  NeQuickG_dual_t cos_lat;
+  /** longitude in radians */
+  NeQuickG_dual_t longitude_rad;
+  /** effective sun spot count */
+  NeQuickG_dual_t sun_spot_count;
+} legendre_dual_t;
+
+static void get_legendre_dual(
+  const NeQuickG_dual_t* const pModip_degree,
+  const solar_activity_dual_t* const pSolar_activity,
+  const position_t* const pPosition,
+  legendre_dual_t* const pLegendre) {
+
+  get_legrende_coeff_for_modip(
+    pModip_degree->value, pLegendre->modip_coeff);
+
+  pLegendre->modip_coeff_derivative[0] = 0.0;
+  for (size_t i = 1; i < NEQUICKG_JRC_IONO_F2_LAYER_MODIP_COEFF_COUNT; i++) {
+    pLegendre->modip_coeff_derivative[i] =
+      (double_t)i * pLegendre->modip_coeff[i - 1];
+  }
+
+  get_legrende_coeff_for_longitude(
+    &pPosition->longitude,
+    pLegendre->long_coeff_sinus,
+    pLegendre->long_coeff_cosinus);
+
+  pLegendre->sin_modip =
+    NeQuickG_dual_constant(pLegendre->modip_coeff[1]);
+  {
+    double_t cos_modip =
+      cos(NEQUICKG_JRC_DEGREE_TO_RAD(pModip_degree->value));
+    for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+      pLegendre->sin_modip.d[i] =
+        cos_modip * NEQUICKG_JRC_DEGREE_TO_RAD(pModip_degree->d[i]);
+    }
+  }
+
+  pLegendre->cos_lat = NeQuickG_dual_constant(pPosition->latitude.cos);
+  pLegendre->cos_lat.d[NEQUICKG_DUAL_PARTIAL_LATITUDE] =
+    -NEQUICKG_JRC_DEGREE_TO_RAD(pPosition->latitude.sin);
+
+  pLegendre->longitude_rad =
+    NeQuickG_dual_constant(pPosition->longitude.rad);
+  pLegendre->longitude_rad.d[NEQUICKG_DUAL_PARTIAL_LONGITUDE] =
+    NEQUICKG_JRC_DEGREE_TO_RAD(1.0);
+
+  pLegendre->sun_spot_count = pSolar_activity->effective_sun_spot_count;
+}
+
+/** #legendre_expansion with its derivatives,
+ * pFourier_coeff_derivative are the derivatives of the Fourier coefficients
+ * with respect to the effective sun spot count
+ */
+static NeQuickG_dual_t legendre_expansion_dual(
+  const double_t* const pFourier_coeff,
+  const double_t* const pFourier_coeff_derivative,
+  const size_t* const pLegendre_degrees_per_order,
+  size_t legendre_degrees_per_order_size,
+  const legendre_dual_t* const pLegendre) {
+
+  const double_t* const pModip_coeff = pLegendre->modip_coeff;
+  const double_t* const pModip_coeff_derivative =
+    pLegendre->modip_coeff_derivative;
+  double_t cos_lat = pLegendre->cos_lat.value;
+
+  double_t parameter = 0.0;
+  double_t d_sun_spot = 0.0;
+  double_t d_sin_modip = 0.0;
+  double_t d_cos_lat = 0.0;
+  double_t d_longitude = 0.0;
+
+  size_t degree_index;
+
+  // Order 0 term
+  for (
+    degree_index = 0;
+    degree_index < pLegendre_degrees_per_order[0];
+    degree_index++) {
+    parameter +=
+      pFourier_coeff[degree_index] * pModip_coeff[degree_index];
+    d_sun_spot +=
+      pFourier_coeff_derivative[degree_index] * pModip_coeff[degree_index];
+    d_sin_modip +=
+      pFourier_coeff[degree_index] * pModip_coeff_derivative[degree_index];
+  }
+
+  double_t lat_coeff = cos_lat;
+  double_t lat_coeff_derivative = 1.0;
+
+  // Order i + 1 term
+  for (
+    size_t i = 1;
+    i < legendre_degrees_per_order_size;
+    i++) {
+
+    double_t long_cos = pLegendre->long_coeff_cosinus[i - 1];
+    double_t long_sin = pLegendre->long_coeff_sinus[i - 1];
+
+    for (
+      size_t j = 0;
+      j < pLegendre_degrees_per_order[i];
+      j++) {
+      double_t term =
+        (pFourier_coeff[degree_index] * long_cos) +
+        (pFourier_coeff[degree_index + 1] * long_sin);
+
+      parameter += (pModip_coeff[j] * lat_coeff * term);
+      d_sun_spot +=
+        (pModip_coeff[j] * lat_coeff *
+        ((pFourier_coeff_derivative[degree_index] * long_cos) +
+        (pFourier_coeff_derivative[degree_index + 1] * long_sin)));
+      d_sin_modip += (pModip_coeff_derivative[j] * lat_coeff * term);
+      d_cos_lat += (pModip_coeff[j] * lat_coeff_derivative * term);
+      d_longitude +=
+        (pModip_coeff[j] * lat_coeff * (double_t)i *
+        ((pFourier_coeff[degree_index + 1] * long_cos) -
+        (pFourier_coeff[degree_index] * long_sin)));
+      degree_index += 2;
+    }
+
+    lat_coeff_derivative = (double_t)(i + 1) * lat_coeff;
+    lat_coeff *= cos_lat;
+  }
+
+  NeQuickG_dual_t result = NeQuickG_dual_constant(parameter);
+  for (size_t k = 0; k < NEQUICKG_DUAL_PARTIAL_COUNT; k++) {
+    result.d[k] =
+      (d_sun_spot * pLegendre->sun_spot_count.d[k]) +
+      (d_sin_modip * pLegendre->sin_modip.d[k]) +
+      (d_cos_lat * pLegendre->cos_lat.d[k]) +
+      (d_longitude * pLegendre->longitude_rad.d[k]);
+  }
+  return result;
+}
+
 static double_t get_transmission_factor(
   const Fm3_fourier_coefficient_array_t Cm3,
   const double_t* const pModip_coeff,
@@ -280,19 +429,19 @@ static double_t get_transmission_factor(
     NEQUICKG_JRC_IONO_F2_TRANS_FACTOR_MINIMUM_VALUE);
 }
 
-int32_t F2_layer_init(
+void F2_layer_init(
   F2_layer_t* const pLayer,
-  const char* const pCCIR_folder) {
+  const char* const pCCIR_folder,
+  const F2_layer_ionosonde_coefficients_t* const pCCIR_months) {
 
-  return F2_layer_fourier_coefficients_init(
-    &pLayer->coef, pCCIR_folder);
+  F2_layer_fourier_coefficients_init(
+    &pLayer->coef, pCCIR_folder, pCCIR_months);
 }
 
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-void F2_layer_close(F2_layer_t* const pLayer) {
+void F2_layer_close(
+  F2_layer_t* const pLayer) {
   F2_layer_fourier_coefficients_close(&pLayer->coef);
 }
-#endif
 
 int32_t F2_layer_get_critical_freq_MHz(
   F2_layer_t * const pF2,
@@ -349,6 +498,90 @@ int32_t F2_layer_get_critical_freq_MHz(
   return NEQUICK_OK;
 }
 
+/** Derivatives of the Fourier coefficients with respect to the effective
+ * sun spot count: the interpolation between the low (R12 = 0) and high
+ * (R12 = 100) solar activity conditions is linear
+ */
+static void get_fourier_coefficients_derivative(
+  const double_t* const pLow,
+  const double_t* const pHigh,
+  const size_t count,
+  double_t* const pDerivative) {
+  for (size_t i = 0; i < count; i++) {
+    pDerivative[i] = (pHigh[i] - pLow[i]) / 100.0;
+  }
+}
+
+int32_t F2_layer_get_critical_freq_MHz_dual(
+  F2_layer_t * const pF2,
+  const NeQuickG_time_t* const pTime,
+  const NeQuickG_dual_t* const pModip_degree,
+  const solar_activity_t* const pSolar_activity,
+  const solar_activity_dual_t* const pSolar_activity_dual,
+  const position_t * const pCurrent_position,
+  F2_layer_dual_t* const pLayer) {
+
+  int32_t ret = F2_layer_fourier_coefficients_get(
+    &pF2->coef,
+    pTime,
+    pSolar_activity);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  legendre_dual_t legendre;
+  get_legendre_dual(
+    pModip_degree,
+    pSolar_activity_dual,
+    pCurrent_position,
+    &legendre);
+
+  F2_fourier_coefficient_array_t CF2_derivative;
+  get_fourier_coefficients_derivative(
+    pF2->coef.projected.CF2[ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX],
+    pF2->coef.projected.CF2[ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX],
+    ITU_F2_COEFF_MAX_DEGREE,
+    CF2_derivative);
+
+  Fm3_fourier_coefficient_array_t Cm3_derivative;
+  get_fourier_coefficients_derivative(
+    pF2->coef.projected.Cm3[ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX],
+    pF2->coef.projected.Cm3[ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX],
+    ITU_FM3_COEFF_MAX_DEGREE,
+    Cm3_derivative);
+
+  // to satisfy lint
+  size_t order_count = NEQUICKG_JRC_IONO_F2_CRITICAL_FREQ_ORDER_COUNT;
+  pLayer->layer.critical_frequency_MHz = legendre_expansion_dual(
+    pF2->coef.fourier.CF2,
+    CF2_derivative,
+    NeQuickG_iono_F2_layer_crit_f_legrendre_grades,
+    order_count,
+    &legendre);
+
+  pLayer->layer.peak.electron_density =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_square(pLayer->layer.critical_frequency_MHz),
+      NEQUICK_G_JRC_FREQ_TO_NE_FACTOR_D,
+      0.0);
+
+  order_count = NEQUICKG_JRC_IONO_F2_TRANS_FACTOR_ORDER_COUNT;
+  pLayer->trans_factor = legendre_expansion_dual(
+    pF2->coef.fourier.Cm3,
+    Cm3_derivative,
+    NeQuickG_iono_F2_layer_trans_factor_grades,
+    order_count,
+    &legendre);
+
+  if (pLayer->trans_factor.value <
+      NEQUICKG_JRC_IONO_F2_TRANS_FACTOR_MINIMUM_VALUE) {
+    pLayer->trans_factor =
+      NeQuickG_dual_constant(NEQUICKG_JRC_IONO_F2_TRANS_FACTOR_MINIMUM_VALUE);
+  }
+
+  return NEQUICK_OK;
+}
+
 static double_t get_E_Term_for_peak_height(
   const double_t critical_freq_F2_layer_MHz,
   const double_t critical_freq_E_layer_MHz) {
@@ -407,6 +640,72 @@ void F2_layer_get_peak_height(
     NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_7;
 }
 
+void F2_layer_get_peak_height_dual(
+  F2_layer_dual_t* const pF2,
+  const NeQuickG_dual_t* const pCritical_freq_E_layer_MHz) {
+
+  NeQuickG_dual_t transmission_factor_squared =
+    NeQuickG_dual_square(pF2->trans_factor);
+
+  NeQuickG_dual_t numerator =
+    NeQuickG_dual_mul(
+      NeQuickG_dual_linear(
+        pF2->trans_factor,
+        NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_1,
+        0.0),
+      NeQuickG_dual_sqrt(
+        NeQuickG_dual_div(
+          NeQuickG_dual_linear(
+            transmission_factor_squared,
+            NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_2,
+            1.0),
+          NeQuickG_dual_linear(
+            transmission_factor_squared,
+            NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_3,
+            -1.0))));
+
+  NeQuickG_dual_t denominator =
+    NeQuickG_dual_linear(
+      pF2->trans_factor,
+      1.0,
+      NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_4);
+
+  if (NEQUICK_G_JRC_IONO_E_LAYER_INFLUENCES_F2_PEAK_HEIGHT(
+        pCritical_freq_E_layer_MHz->value)) {
+
+    NeQuickG_dual_t E_term =
+      NeQuickG_dual_div(
+        pF2->layer.critical_frequency_MHz,
+        *pCritical_freq_E_layer_MHz);
+
+    E_term = NeQuickG_dual_func_join(
+      E_term,
+      NeQuickG_dual_constant(
+        NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_JOIN_CLIP_CONST),
+      NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_JOIN_CONST,
+      NeQuickG_dual_linear(
+        E_term,
+        1.0,
+        -NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_JOIN_CLIP_CONST));
+
+    denominator = NeQuickG_dual_add(
+      denominator,
+      NeQuickG_dual_div(
+        NeQuickG_dual_constant(
+          NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_5),
+        NeQuickG_dual_linear(
+          E_term,
+          1.0,
+          -NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_6)));
+  }
+
+  pF2->layer.peak.height_km =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_div(numerator, denominator),
+      1.0,
+      NEQUICKG_JRC_IONO_F2_MAX_e_DENSITY_DUDENEY_CONST_7);
+}
+
 void F2_layer_get_peak_thickness(F2_layer_t* const pF2) {
   pF2->layer.peak.thickness.top_km = INFINITY;
   pF2->layer.peak.thickness.bottom_km =
@@ -428,12 +727,48 @@ void F2_layer_get_peak_thickness(F2_layer_t* const pF2) {
   pF2->layer.peak.thickness.bottom_km /= grad;
 }
 
+void F2_layer_get_peak_thickness_dual(F2_layer_dual_t* const pF2) {
+  pF2->layer.peak.thickness.top_km = NeQuickG_dual_constant(INFINITY);
+
+  NeQuickG_dual_t grad =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_exp(
+        NeQuickG_dual_add(
+          NeQuickG_dual_linear(
+            NeQuickG_dual_log(
+              NeQuickG_dual_square(pF2->layer.critical_frequency_MHz)),
+            NEQUICKG_JRC_IONO_F2_e_DENSITY_GRAD_CONST_3,
+            NEQUICKG_JRC_IONO_F2_e_DENSITY_GRAD_CONST_2),
+          NeQuickG_dual_linear(
+            NeQuickG_dual_log(pF2->trans_factor),
+            NEQUICKG_JRC_IONO_F2_e_DENSITY_GRAD_CONST_4,
+            0.0))),
+      NEQUICKG_JRC_IONO_F2_e_DENSITY_GRAD_CONST_1,
+      0.0);
+
+  pF2->layer.peak.thickness.bottom_km =
+    NeQuickG_dual_div(
+      NeQuickG_dual_linear(
+        pF2->layer.peak.electron_density,
+        NEQUICK_G_JRC_IONO_F2_LAYER_THICKNESS_BOTTOM_FACTOR,
+        0.0),
+      grad);
+}
+
 void F2_layer_get_peak_amplitude(F2_layer_t* const pF2) {
   pF2->layer.peak.amplitude =
     NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(
       pF2->layer.peak.electron_density);
 }
 
+void F2_layer_get_peak_amplitude_dual(F2_layer_dual_t* const pF2) {
+  pF2->layer.peak.amplitude =
+    NeQuickG_dual_linear(
+      pF2->layer.peak.electron_density,
+      NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(1.0),
+      0.0);
+}
+
 static double_t F2_layer_get_shape_factor(
   const F2_layer_t* const pF2,
   const NeQuickG_time_t* const pTime,
@@ -508,6 +843,99 @@ void F2_layer_exosphere_adjust(
   pF2->layer.peak.electron_density = NAN;
 }
 
+static NeQuickG_dual_t F2_layer_get_shape_factor_dual(
+  const F2_layer_dual_t* const pF2,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_dual_t* const pSolar_activity) {
+
+  NeQuickG_dual_t shape_factor;
+
+  if ((pTime->month > NEQUICK_G_JRC_MONTH_MARCH) &&
+      (pTime->month < NEQUICK_G_JRC_MONTH_OCTOBER)) {
+
+    shape_factor =
+      NeQuickG_dual_add(
+        NeQuickG_dual_linear(
+          pSolar_activity->effective_sun_spot_count,
+          NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_2,
+          NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_1),
+        NeQuickG_dual_linear(
+          pF2->layer.peak.height_km,
+          NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_3,
+          0.0));
+
+  } else {
+
+    shape_factor =
+      NeQuickG_dual_add(
+        NeQuickG_dual_linear(
+          NeQuickG_dual_square(
+            NeQuickG_dual_div(
+              pF2->layer.peak.height_km,
+              pF2->layer.peak.thickness.bottom_km)),
+          NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_5,
+          NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_4),
+        NeQuickG_dual_linear(
+          pF2->layer.peak.electron_density,
+          NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_6,
+          0.0));
+  }
+
+  shape_factor =
+    NeQuickG_dual_func_join(
+      shape_factor,
+      NeQuickG_dual_constant(NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_7),
+      NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_TRANSITION_REGION,
+      NeQuickG_dual_linear(
+        shape_factor, 1.0, -NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_7));
+
+  shape_factor =
+    NeQuickG_dual_func_join(
+      NeQuickG_dual_constant(NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_8),
+      shape_factor,
+      NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_TRANSITION_REGION,
+      NeQuickG_dual_linear(
+        shape_factor, 1.0, -NEQUICKG_JRC_IONO_F2_SHAPE_FACTOR_CONST_8));
+
+  return shape_factor;
+}
+
+void F2_layer_exosphere_adjust_dual(
+  F2_layer_dual_t* const pF2,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_dual_t* const pSolar_activity) {
+
+  NeQuickG_dual_t shape_factor =
+    F2_layer_get_shape_factor_dual(pF2, pTime, pSolar_activity);
+
+  NeQuickG_dual_t thickness_top_km =
+    NeQuickG_dual_mul(shape_factor, pF2->layer.peak.thickness.bottom_km);
+
+  NeQuickG_dual_t auxiliary_param_x =
+    NeQuickG_dual_linear(
+      thickness_top_km,
+      1.0 / NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_2,
+      -NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_1 /
+        NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_2);
+
+  NeQuickG_dual_t auxiliary_param_v =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_mul(
+        NeQuickG_dual_linear(
+          auxiliary_param_x,
+          NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_3,
+          -NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_4),
+        auxiliary_param_x),
+      1.0,
+      NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_5);
+
+  pF2->layer.peak.thickness.top_km =
+    NeQuickG_dual_div(thickness_top_km, auxiliary_param_v);
+
+  // recalculated by the electron density module
+  pF2->layer.peak.electron_density = NeQuickG_dual_constant(NAN);
+}
+
 #undef NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_1
 #undef NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_2
 #undef NEQUICKG_JRC_IONO_F2_THICKNESS_TOP_CONST_3
@@ -20,9 +20,7 @@
 #ifdef FTR_MODIP_CCIR_AS_CONSTANTS
 #include "NeQuickG_JRC_CCIR.h"
 #endif
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
 #include "NeQuickG_JRC_error.h"
-#endif
 #include "NeQuickG_JRC_macros.h"
 #include "NeQuickG_JRC_solar.h"
 
@@ -167,62 +165,99 @@ static int32_t coefficients_load(
 
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
-int32_t F2_layer_fourier_coefficients_init(
+void F2_layer_fourier_coefficients_init(
   F2_layer_fourier_coeff_context_t* const pContext,
-  const char* const pCCIR_folder) {
+  const char* const pCCIR_folder,
+  const F2_layer_ionosonde_coefficients_t* const pCCIR_months) {
 
   NeQuickG_time_init(&pContext->time);
 
-  {
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-    // store a copy of the CCIR folder
-    {
-      pContext->ionosonde.pFolder = malloc(strlen(pCCIR_folder) + 1);
-      if (!pContext->ionosonde.pFolder) {
+  pContext->ionosonde.pFolder = pCCIR_folder;
+  pContext->ionosonde.pMonths = pCCIR_months;
+  pContext->ionosonde.month = 0;
+  pContext->ionosonde.pLoaded = NULL;
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+  pContext->projected.valid = false;
+  pContext->fourier.effective_sun_spot_count = 0.0;
+  pContext->fourier.valid = false;
+  pContext->cache.entry_count = 0;
+  pContext->cache.pEntry = NULL;
+  (void)F2_layer_fourier_coefficients_set_cache(pContext, 0);
+}
+
+void F2_layer_fourier_coefficients_close(
+  F2_layer_fourier_coeff_context_t* const pContext) {
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  free(pContext->ionosonde.pLoaded);
+  pContext->ionosonde.pLoaded = NULL;
+  pContext->ionosonde.month = 0;
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+  (void)F2_layer_fourier_coefficients_set_cache(pContext, 0);
+}
+
+int32_t F2_layer_fourier_coefficients_set_cache(
+  F2_layer_fourier_coeff_context_t* const pContext,
+  const size_t entry_count) {
+
+  if (entry_count > NEQUICKG_FOURIER_CACHE_ENTRY_COUNT_MAX) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_FOURIER_CACHE,
+      "Fourier coefficient cache. %zu entries, at most %d",
+      entry_count, NEQUICKG_FOURIER_CACHE_ENTRY_COUNT_MAX);
+  }
+
+  F2_fourier_cache_t* const pCache = &pContext->cache;
+
+  if (entry_count == pCache->entry_count) {
+    if (entry_count > 0) {
+      memset(pCache->pEntry, 0, entry_count*sizeof(F2_fourier_cache_entry_t));
+    }
+  } else {
+    // calloc: the entries are not valid
+    F2_fourier_cache_entry_t* pEntry = NULL;
+    if (entry_count > 0) {
+      pEntry = calloc(entry_count, sizeof(F2_fourier_cache_entry_t));
+      if (!pEntry) {
         NEQUICK_ERROR_RETURN(
-          NEQUICK_ERROR_SRC_F2_LAYER,
+          NEQUICK_ERROR_SRC_MEMORY,
           NEQUICK_ERROR_CODE_NO_RESOURCES,
-        "Not enough resources to copy CCIR directory on the heap");
+          "Not enough resources to allocate the Fourier coefficient cache");
       }
-      strcpy(pContext->ionosonde.pFolder, pCCIR_folder);
     }
-#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
-    pContext->interpolated.effective_sun_spot_count = 0.0;
-    pContext->interpolated.valid = false;
-    pContext->fourier.valid = false;
+    free(pCache->pEntry);
+    pCache->pEntry = pEntry;
   }
+
+  pCache->entry_count = entry_count;
+  pCache->clock = 0;
+  memset(&pCache->statistics, 0, sizeof(pCache->statistics));
   return NEQUICK_OK;
 }
 
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-void F2_layer_fourier_coefficients_close(
-  F2_layer_fourier_coeff_context_t* const pContext) {
-  if (pContext->ionosonde.pFolder) {
-    free(pContext->ionosonde.pFolder);
-    pContext->ionosonde.pFolder = NULL;
-  }
-}
-
-static int32_t load_ionosonde_coeff(
-  F2_layer_fourier_coeff_context_t* const pContext,
-  const NeQuickG_time_t* const pTime) {
+int32_t F2_layer_fourier_coefficients_load(
+  const char* const pCCIR_folder,
+  const uint8_t month,
+  F2_layer_ionosonde_coefficients_t* const pCoeff) {
 
   int32_t ret;
 
   char file_id[4 + 1];
-  ret = coefficients_file_get_id(pTime->month, file_id, sizeof(file_id));
+  ret = coefficients_file_get_id(month, file_id, sizeof(file_id));
   if (ret != NEQUICK_OK) {
     return ret;
   }
 
   FILE* pFile = NULL;
   ret = coefficients_file_open(
-    pContext->ionosonde.pFolder, file_id, strlen(file_id), &pFile);
+    pCCIR_folder, file_id, strlen(file_id), &pFile);
   if (ret != NEQUICK_OK) {
     return ret;
   }
 
-  ret = coefficients_load(pFile, &pContext->ionosonde);
+  ret = coefficients_load(pFile, pCoeff);
 
   if (pFile) {
     fclose(pFile);
@@ -231,162 +266,127 @@ static int32_t load_ionosonde_coeff(
 }
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
-static int32_t set_parameters(
-  F2_layer_fourier_coeff_context_t* const pContext,
-  const NeQuickG_time_t* const pTime,
-  const double_t Azr) {
-
-  bool ionosonde_coeff_valid =
-    NEQUICK_G_TIME_MONTH_EQUAL(
-      pTime->month,
-      pContext->time.month);
-
-  if (ionosonde_coeff_valid) {
-    pContext->interpolated.valid =
-      solar_activity_is_effective_ionisation_level_equal(
-        Azr,
-        pContext->interpolated.effective_sun_spot_count*100.0);
-    if (pContext->interpolated.valid) {
-      pContext->fourier.valid =
-        NeQuickG_time_utc_is_equal(
-          pTime->utc,
-          pContext->time.utc);
-    } else {
-      pContext->interpolated.effective_sun_spot_count = Azr / 100.0;
-      pContext->fourier.valid = false;
-    }
-    if (!pContext->fourier.valid) {
-      pContext->time.utc = pTime->utc;
-    }
-  } else {
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-    int32_t ret = load_ionosonde_coeff(pContext, pTime);
-    if (ret != NEQUICK_OK) {
-      return ret;
-    }
-#endif
-    pContext->time = *pTime;
-    pContext->interpolated.effective_sun_spot_count = Azr / 100.0;
-    pContext->interpolated.valid = false;
-    pContext->fourier.valid = false;
-  }
-  return NEQUICK_OK;
-}
-
-/**
- * AF2 elements are calculated by linear combination of the elements of F2.
+/** Gets the CCIR coefficients of the month of the context
+ * for the low and high solar activity conditions
  */
-static int32_t interpolate_F2(
-  F2_layer_fourier_coeff_context_t* const pContext) {
-
-  int32_t ret;
+static int32_t get_ionosonde_coeff(
+  F2_layer_fourier_coeff_context_t* const pContext,
+  const F2_coefficient_array_t** ppF2,
+  const Fm3_coefficient_array_t** ppFm3) {
 
 #ifdef FTR_MODIP_CCIR_AS_CONSTANTS
   F2_coefficient_array_t* pF2;
-  ret = CCIR_get_ionosonde_F2(pContext->time.month, &pF2);
+  int32_t ret = CCIR_get_ionosonde_F2(pContext->time.month, &pF2);
   if (ret != NEQUICK_OK) {
     return ret;
   }
-#else
-  ret = NEQUICK_OK;
-#endif // FTR_MODIP_CCIR_AS_CONSTANTS
-
-  size_t degree;
-  size_t order;
-  for (degree = 0; degree < ITU_F2_COEFF_MAX_DEGREE; degree++) {
-    for (order = 0; order < ITU_F2_COEFF_MAX_ORDER; order++) {
-      pContext->interpolated.F2[degree][order] =
-#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
-        pF2
-#else
-        pContext->ionosonde.F2
-#endif
-        [ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX]
-          [degree][order] * (1.0 - pContext->interpolated.effective_sun_spot_count) +
-#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
-        pF2
-#else
-        pContext->ionosonde.F2
-#endif
-        [ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX]
-          [degree][order] * pContext->interpolated.effective_sun_spot_count;
-    }
-  }
-  return ret;
-}
-
-/**
- * Am3 elements are calculated by linear combination of the elements of Fm3:
- */
-static int32_t interpolate_Fm3(
-  F2_layer_fourier_coeff_context_t* const pContext) {
-
-  int32_t ret;
-
-#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
   Fm3_coefficient_array_t* pFm3;
   ret = CCIR_get_ionosonde_Fm3(pContext->time.month, &pFm3);
   if (ret != NEQUICK_OK) {
     return ret;
   }
+  *ppF2 = (const F2_coefficient_array_t*)pF2;
+  *ppFm3 = (const Fm3_coefficient_array_t*)pFm3;
+  return NEQUICK_OK;
 #else
-  ret = NEQUICK_OK;
+  const uint8_t month = pContext->time.month;
+  F2_layer_ionosonde_context_t* const pIonosonde = &pContext->ionosonde;
+
+  const F2_layer_ionosonde_coefficients_t* pCoeff;
+  if (pIonosonde->pMonths) {
+    if ((month < NEQUICK_G_JRC_MONTH_JANUARY) ||
+        (month > NEQUICK_G_JRC_MONTH_DECEMBER)) {
+      NEQUICK_ERROR_RETURN(
+        NEQUICK_ERROR_SRC_F2_LAYER,
+        NEQUICK_ERROR_CODE_BAD_MONTH,
+        "Invalid month %u", month);
+    }
+    pCoeff = &pIonosonde->pMonths[month - NEQUICK_G_JRC_MONTH_JANUARY];
+  } else {
+    if (!pIonosonde->pLoaded) {
+      pIonosonde->pLoaded = malloc(sizeof(F2_layer_ionosonde_coefficients_t));
+      if (!pIonosonde->pLoaded) {
+        NEQUICK_ERROR_RETURN(
+          NEQUICK_ERROR_SRC_MEMORY,
+          NEQUICK_ERROR_CODE_NO_RESOURCES,
+          "Not enough resources to allocate the CCIR maps on the heap");
+      }
+    }
+    if (!NEQUICK_G_TIME_MONTH_EQUAL(pIonosonde->month, month)) {
+      // not valid until the file is completely loaded
+      pIonosonde->month = 0;
+      int32_t ret = F2_layer_fourier_coefficients_load(
+        pIonosonde->pFolder, month, pIonosonde->pLoaded);
+      if (ret != NEQUICK_OK) {
+        return ret;
+      }
+      pIonosonde->month = month;
+    }
+    pCoeff = pIonosonde->pLoaded;
+  }
+  *ppF2 = pCoeff->F2;
+  *ppFm3 = pCoeff->Fm3;
+  return NEQUICK_OK;
 #endif // FTR_MODIP_CCIR_AS_CONSTANTS
+}
 
-  size_t degree;
-  size_t order;
-  for (degree = 0; degree < ITU_FM3_COEFF_MAX_DEGREE; degree++) {
-    for (order = 0; order < ITU_FM3_COEFF_MAX_ORDER; order++) {
-      pContext->interpolated.Fm3[degree][order] =
-#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
-        pFm3
-#else
-        pContext->ionosonde.Fm3
-#endif
-
-        [ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX]
-          [degree][order] * (1.0 - pContext->interpolated.effective_sun_spot_count) +
-#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
-        pFm3
-#else
-        pContext->ionosonde.Fm3
-#endif
-        [ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX]
-          [degree][order] * pContext->interpolated.effective_sun_spot_count;
-    }
+/**
+ * Linear combination of the elements for the low and high solar activity
+ * conditions, for the coefficients of the CCIR maps (AF2 and Am3) as for
+ * their Fourier coefficients.
+ */
+static void interpolate(
+  const double_t* const pLow,
+  const double_t* const pHigh,
+  const size_t count,
+  const double_t effective_sun_spot_count,
+  double_t* const pResult) {
+  for (size_t i = 0; i < count; i++) {
+    pResult[i] =
+      pLow[i] * (1.0 - effective_sun_spot_count) +
+      pHigh[i] * effective_sun_spot_count;
   }
-  return ret;
 }
 
-#ifndef FTR_UNIT_TEST
-static
-#endif
+#ifdef FTR_UNIT_TEST
 int32_t F2_layer_fourier_coefficients_interpolate(
   F2_layer_fourier_coeff_context_t* const pContext,
   const NeQuickG_time_t * const pTime,
-  const double_t Azr) {
+  const double_t Azr,
+  F2_coefficient_array_t AF2,
+  Fm3_coefficient_array_t Am3) {
+
+  pContext->time = *pTime;
+  pContext->projected.valid = false;
+  pContext->fourier.valid = false;
 
-  int32_t ret = set_parameters(pContext, pTime, Azr);
+  const F2_coefficient_array_t* pF2;
+  const Fm3_coefficient_array_t* pFm3;
+  int32_t ret = get_ionosonde_coeff(pContext, &pF2, &pFm3);
   if (ret != NEQUICK_OK) {
     return ret;
   }
 
-  if (!pContext->interpolated.valid) {
-
-    ret = interpolate_F2(pContext);
-    if (ret != NEQUICK_OK) {
-      return ret;
-    }
-
-    ret = interpolate_Fm3(pContext);
-    if (ret != NEQUICK_OK) {
-      return ret;
-    }
-
-    pContext->interpolated.valid = true;
+  const double_t effective_sun_spot_count = Azr / 100.0;
+  for (size_t degree = 0; degree < ITU_F2_COEFF_MAX_DEGREE; degree++) {
+    interpolate(
+      pF2[ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX][degree],
+      pF2[ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX][degree],
+      ITU_F2_COEFF_MAX_ORDER,
+      effective_sun_spot_count,
+      AF2[degree]);
+  }
+  for (size_t degree = 0; degree < ITU_FM3_COEFF_MAX_DEGREE; degree++) {
+    interpolate(
+      pFm3[ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX][degree],
+      pFm3[ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX][degree],
+      ITU_FM3_COEFF_MAX_ORDER,
+      effective_sun_spot_count,
+      Am3[degree]);
   }
   return NEQUICK_OK;
 }
+#endif // FTR_UNIT_TEST
 
 static void get_harmonics(
   const NeQuickG_time_t * const pTime,
@@ -413,41 +413,51 @@ static void get_harmonics(
 }
 
 static void get_fourier_coefficients_CF2(
-  const F2_layer_fourier_coeff_context_t* const pContext,
+  const F2_coefficient_array_t F2,
   const double_t * const pSin,
   const double_t * const pCos,
   F2_fourier_coefficient_array_t CF2) {
   for (size_t i = 0x00; i < ITU_F2_COEFF_MAX_DEGREE; i++) {
-    CF2[i] = pContext->interpolated.F2[i][0];
+    CF2[i] = F2[i][0];
     for (size_t j = 0x00; j < ITU_F2_LAYER_MAX_HARMONICS_CF2; j++) {
       size_t order = 2 * (j + 1);
       CF2[i] +=
-        (pSin[j] * pContext->interpolated.F2[i][order - 1]) +
-        (pCos[j] * pContext->interpolated.F2[i][order]);
+        (pSin[j] * F2[i][order - 1]) +
+        (pCos[j] * F2[i][order]);
     }
   }
 }
 
 static void get_fourier_coefficients_Cm3(
-  const F2_layer_fourier_coeff_context_t* const pContext,
+  const Fm3_coefficient_array_t Fm3,
   const double_t * const pSin,
   const double_t * const pCos,
   Fm3_fourier_coefficient_array_t Cm3) {
   for (size_t i = 0x00; i < ITU_FM3_COEFF_MAX_DEGREE; i++) {
-    Cm3[i] = pContext->interpolated.Fm3[i][0];
+    Cm3[i] = Fm3[i][0];
     for (size_t j = 0x00; j < ITU_F2_LAYER_MAX_HARMONICS_CM3; j++) {
       size_t order = 2 * (j + 1);
       Cm3[i] +=
-        (pSin[j] * pContext->interpolated.Fm3[i][order - 1]) +
-        (pCos[j] * pContext->interpolated.Fm3[i][order]);
+        (pSin[j] * Fm3[i][order - 1]) +
+        (pCos[j] * Fm3[i][order]);
     }
   }
 }
 
-static
-void F2_layer_fourier_coefficients_get_impl(
+/**
+ * Fourier coefficients of the low and high solar activity conditions
+ * at the time of the context.
+ */
+static int32_t get_projected_coefficients(
   F2_layer_fourier_coeff_context_t* const pContext) {
 
+  const F2_coefficient_array_t* pF2;
+  const Fm3_coefficient_array_t* pFm3;
+  int32_t ret = get_ionosonde_coeff(pContext, &pF2, &pFm3);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
   //lint -e{506} ITU_F2_LAYER_MAX_HARMONICS_COEFF is not constant, as lint means
   double_t sinus_terms[ITU_F2_LAYER_MAX_HARMONICS_COEFF];
   //lint -e{506} ITU_F2_LAYER_MAX_HARMONICS_COEFF is not constant, as lint means
@@ -455,15 +465,87 @@ void F2_layer_fourier_coefficients_get_impl(
 
   get_harmonics(&pContext->time, sinus_terms, cosinus_terms);
 
-  get_fourier_coefficients_CF2(
-    pContext,
-    sinus_terms, cosinus_terms,
-    pContext->fourier.CF2);
+  for (size_t i = 0;
+       i < ITU_F2_LAYER_SOLAR_ACTIVITY_CONDITIONS_COUNT;
+       i++) {
+    get_fourier_coefficients_CF2(
+      pF2[i],
+      sinus_terms, cosinus_terms,
+      pContext->projected.CF2[i]);
+
+    get_fourier_coefficients_Cm3(
+      pFm3[i],
+      sinus_terms, cosinus_terms,
+      pContext->projected.Cm3[i]);
+  }
+  return NEQUICK_OK;
+}
 
-  get_fourier_coefficients_Cm3(
-    pContext,
-    sinus_terms, cosinus_terms,
-    pContext->fourier.Cm3);
+/** Is a time the one of the coefficients of the context or of an entry? */
+static bool is_same_time(
+  const NeQuickG_time_t * const pTime_1,
+  const NeQuickG_time_t * const pTime_2) {
+  return (
+    NEQUICK_G_TIME_MONTH_EQUAL(pTime_1->month, pTime_2->month) &&
+    NeQuickG_time_utc_is_equal(pTime_1->utc, pTime_2->utc));
+}
+
+/** Looks up the cache, on a hit the coefficients of the entry
+ * become the ones of the context.
+ *
+ * @return the coefficients were found?
+ */
+static bool cache_find(
+  F2_layer_fourier_coeff_context_t* const pContext,
+  const NeQuickG_time_t * const pTime) {
+
+  F2_fourier_cache_t* const pCache = &pContext->cache;
+  pCache->clock++;
+
+  for (size_t i = 0; i < pCache->entry_count; i++) {
+    F2_fourier_cache_entry_t* const pEntry = &pCache->pEntry[i];
+    if (pEntry->is_valid && is_same_time(&pEntry->time, pTime)) {
+      pEntry->last_use = pCache->clock;
+      pCache->statistics.hit_count++;
+
+      pContext->time = pEntry->time;
+      pContext->projected = pEntry->projected;
+      return true;
+    }
+  }
+
+  pCache->statistics.miss_count++;
+  return false;
+}
+
+/** Adds the coefficients of the context in place of the least
+ * recently used entry
+ */
+static void cache_add(
+  F2_layer_fourier_coeff_context_t* const pContext) {
+
+  F2_fourier_cache_t* const pCache = &pContext->cache;
+
+  F2_fourier_cache_entry_t* pLeast_recently_used = &pCache->pEntry[0];
+  for (size_t i = 0; i < pCache->entry_count; i++) {
+    F2_fourier_cache_entry_t* const pEntry = &pCache->pEntry[i];
+    if (!pEntry->is_valid) {
+      pLeast_recently_used = pEntry;
+      break;
+    }
+    if (pEntry->last_use < pLeast_recently_used->last_use) {
+      pLeast_recently_used = pEntry;
+    }
+  }
+
+  if (pLeast_recently_used->is_valid) {
+    pCache->statistics.eviction_count++;
+  }
+
+  pLeast_recently_used->is_valid = true;
+  pLeast_recently_used->last_use = pCache->clock;
+  pLeast_recently_used->time = pContext->time;
+  pLeast_recently_used->projected = pContext->projected;
 }
 
 int32_t F2_layer_fourier_coefficients_get(
@@ -471,14 +553,51 @@ int32_t F2_layer_fourier_coefficients_get(
   const NeQuickG_time_t * const pTime,
   const solar_activity_t* const pSolar_activity) {
 
-  int32_t ret = F2_layer_fourier_coefficients_interpolate(
-    pContext, pTime, pSolar_activity->effective_sun_spot_count);
-  if (ret != NEQUICK_OK) {
-    return ret;
+  if (!pContext->projected.valid ||
+      !is_same_time(&pContext->time, pTime)) {
+
+    pContext->fourier.valid = false;
+
+    bool is_cached = (pContext->cache.entry_count > 0);
+    if (!is_cached || !cache_find(pContext, pTime)) {
+      pContext->time = *pTime;
+      pContext->projected.valid = false;
+
+      int32_t ret = get_projected_coefficients(pContext);
+      if (ret != NEQUICK_OK) {
+        return ret;
+      }
+      pContext->projected.valid = true;
+
+      if (is_cached) {
+        cache_add(pContext);
+      }
+    }
   }
 
-  if (!pContext->fourier.valid) {
-    F2_layer_fourier_coefficients_get_impl(pContext);
+  const double_t Azr = pSolar_activity->effective_sun_spot_count;
+
+  if (!pContext->fourier.valid ||
+      !solar_activity_is_effective_ionisation_level_equal(
+        Azr,
+        pContext->fourier.effective_sun_spot_count*100.0)) {
+
+    pContext->fourier.effective_sun_spot_count = Azr / 100.0;
+
+    interpolate(
+      pContext->projected.CF2[ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX],
+      pContext->projected.CF2[ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX],
+      ITU_F2_COEFF_MAX_DEGREE,
+      pContext->fourier.effective_sun_spot_count,
+      pContext->fourier.CF2);
+
+    interpolate(
+      pContext->projected.Cm3[ITU_F2_LAYER_COEFF_LOW_SOLAR_ACTIVITY_IDX],
+      pContext->projected.Cm3[ITU_F2_LAYER_COEFF_HIGH_SOLAR_ACTIVITY_IDX],
+      ITU_FM3_COEFF_MAX_DEGREE,
+      pContext->fourier.effective_sun_spot_count,
+      pContext->fourier.Cm3);
+
     pContext->fourier.valid = true;
   }
 
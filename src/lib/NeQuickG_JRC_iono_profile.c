@@ -19,24 +19,24 @@
 
 #define NEQUICK_G_JRC_IONO_PEAK_AMPLITUDE_ITERATION_COUNT (5)
 
-int32_t iono_profile_init(
+void iono_profile_init(
   iono_profile_t * const pProfile,
-  const char* const pCCIR_folder) {
+  const char* const pCCIR_folder,
+  const F2_layer_ionosonde_coefficients_t* const pCCIR_months) {
 
   E_layer_init(&pProfile->E);
 
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
   assert(pCCIR_folder);
 #endif
-  return F2_layer_init(
-    &pProfile->F2, pCCIR_folder);
+  F2_layer_init(
+    &pProfile->F2, pCCIR_folder, pCCIR_months);
 }
 
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-void iono_profile_close(iono_profile_t * const pProfile) {
+void iono_profile_close(
+  iono_profile_t * const pProfile) {
   F2_layer_close(&pProfile->F2);
 }
-#endif
 
 static double_t iono_profile_get_amplitude_of_peak(
   const peak_t* const pPeak,
@@ -226,6 +226,21 @@ int32_t iono_profile_get(
 
   modip_get(pModip, pCurrent_position);
 
+  return iono_profile_get_at_modip(
+    pProfile,
+    pTime,
+    pModip,
+    pSolar_activity,
+    pCurrent_position);
+}
+
+int32_t iono_profile_get_at_modip(
+  iono_profile_t * const pProfile,
+  const NeQuickG_time_t* const pTime,
+  const modip_context_t* const pModip,
+  const solar_activity_t* const pSolar_activity,
+  const position_t * const pCurrent_position) {
+
   int32_t ret = iono_profile_get_critical_freqs(
     pProfile,
     pTime,
@@ -246,4 +261,185 @@ int32_t iono_profile_get(
   return NEQUICK_OK;
 }
 
+static NeQuickG_dual_t iono_profile_get_amplitude_of_peak_dual(
+  const peak_dual_t* const pPeak,
+  const NeQuickG_dual_t* const pHeight_km) {
+
+  const NeQuickG_dual_t* const pThickness_param =
+    (pPeak->height_km.value > pHeight_km->value) ?
+    &pPeak->thickness.bottom_km :
+    &pPeak->thickness.top_km;
+
+  NeQuickG_dual_t electron_density =
+    NeQuickG_dual_exp(
+      NeQuickG_dual_div(
+        NeQuickG_dual_sub(*pHeight_km, pPeak->height_km),
+        *pThickness_param));
+
+  electron_density =
+    NeQuickG_dual_div(
+      NeQuickG_dual_mul(pPeak->amplitude, electron_density),
+      NeQuickG_dual_square(
+        NeQuickG_dual_linear(electron_density, 1.0, 1.0)));
+
+  return NeQuickG_dual_linear(
+    electron_density,
+    NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(1.0),
+    0.0);
+}
+
+static NeQuickG_dual_t iono_profile_get_peak_amp_substracting_layer_dual(
+  const peak_dual_t * const pPeak,
+  const peak_dual_t * const pOther_layer_peak) {
+
+  return NeQuickG_dual_sub(
+    NeQuickG_dual_linear(
+      pPeak->electron_density,
+      NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(1.0),
+      0.0),
+    iono_profile_get_amplitude_of_peak_dual(
+      pOther_layer_peak, &pPeak->height_km));
+}
+
+/** #iono_profile_get_peak_amplitudes with the derivatives */
+static void iono_profile_get_peak_amplitudes_dual(
+  iono_profile_dual_t * const pProfile) {
+
+  F2_layer_get_peak_amplitude_dual(&pProfile->F2);
+
+  peak_dual_t* const pE_peak = &pProfile->E.peak;
+  peak_dual_t* const pF1_peak = &pProfile->F1.peak;
+  peak_dual_t* const pF2_peak = &pProfile->F2.layer.peak;
+
+  NeQuickG_dual_t E_peak_amplitude_substracting_F2 =
+    iono_profile_get_peak_amp_substracting_layer_dual(pE_peak, pF2_peak);
+
+  if (pProfile->F1.critical_frequency_MHz.value >=
+      NEQUICK_G_JRC_IONO_F1_LAYER_PEAK_PRESENT_MHZ) {
+
+    NeQuickG_dual_t F1_peak_amplitude_substracting_F2 =
+      iono_profile_get_peak_amp_substracting_layer_dual(pF1_peak, pF2_peak);
+
+    pE_peak->amplitude =
+      NeQuickG_dual_linear(
+        pE_peak->electron_density,
+        NEQUICKG_IONO_LAYER_GET_PEAK_AMPLITUDE(1.0),
+        0.0);
+
+    NeQuickG_dual_t F1_amplitude_floor =
+      NeQuickG_dual_linear(
+        pF1_peak->electron_density,
+        NEQUICK_G_JRC_IONO_F1_LAYER_AMPLITUDE_CONSTANT,
+        0.0);
+
+    for (
+      size_t i = 0; i < NEQUICK_G_JRC_IONO_PEAK_AMPLITUDE_ITERATION_COUNT; i++) {
+
+      // F1
+      pF1_peak->amplitude =
+        NeQuickG_dual_sub(
+          F1_peak_amplitude_substracting_F2,
+          iono_profile_get_amplitude_of_peak_dual(
+            pE_peak, &pF1_peak->height_km));
+
+      pF1_peak->amplitude =
+        NeQuickG_dual_func_join(
+          pF1_peak->amplitude,
+          F1_amplitude_floor,
+          1.0,
+          NeQuickG_dual_sub(pF1_peak->amplitude, F1_amplitude_floor));
+
+      // E
+      pE_peak->amplitude =
+        NeQuickG_dual_sub(
+          E_peak_amplitude_substracting_F2,
+          iono_profile_get_amplitude_of_peak_dual(
+            pF1_peak, &pE_peak->height_km));
+    }
+  } else {
+    pF1_peak->amplitude = NeQuickG_dual_constant(0.0);
+    pE_peak->amplitude = E_peak_amplitude_substracting_F2;
+  }
+
+  pE_peak->amplitude =
+    NeQuickG_dual_func_join(
+      pE_peak->amplitude,
+      NeQuickG_dual_constant(NEQUICK_G_JRC_IONO_E_LAYER_AMPLITUDE_CONSTANT_1),
+      NEQUICK_G_JRC_IONO_E_LAYER_AMPLITUDE_WITH_TRANSITION_REGION,
+      NeQuickG_dual_linear(
+        pE_peak->amplitude,
+        1.0,
+        -NEQUICK_G_JRC_IONO_E_LAYER_AMPLITUDE_CONSTANT_2));
+}
+
+int32_t iono_profile_get_dual(
+  iono_profile_t * const pContext,
+  const NeQuickG_time_t* const pTime,
+  const NeQuickG_dual_t* const pModip_degree,
+  const solar_activity_t* const pSolar_activity,
+  const position_t * const pCurrent_position,
+  iono_profile_dual_t* const pProfile) {
+
+  solar_activity_dual_t solar_activity;
+  solar_activity_get_dual(pSolar_activity, &solar_activity);
+
+  // critical frequencies
+  E_layer_get_critical_freq_MHz_dual(
+    &pContext->E,
+    pTime,
+    &solar_activity,
+    pCurrent_position,
+    &pProfile->E);
+
+  int32_t ret = F2_layer_get_critical_freq_MHz_dual(
+    &pContext->F2,
+    pTime,
+    pModip_degree,
+    pSolar_activity,
+    &solar_activity,
+    pCurrent_position,
+    &pProfile->F2);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  F1_layer_get_critical_freq_MHz_dual(
+    &pProfile->F1,
+    &pProfile->E.critical_frequency_MHz,
+    &pProfile->F2.layer.critical_frequency_MHz);
+
+  // peak heights
+  E_layer_get_peak_height_dual(&pProfile->E);
+
+  F2_layer_get_peak_height_dual(
+    &pProfile->F2,
+    &pProfile->E.critical_frequency_MHz);
+
+  F1_layer_get_peak_height_dual(
+    &pProfile->F1,
+    &pProfile->E.peak.height_km,
+    &pProfile->F2.layer.peak.height_km);
+
+  // peak thicknesses
+  F2_layer_get_peak_thickness_dual(&pProfile->F2);
+
+  F1_layer_get_peak_thickness_dual(
+    &pProfile->F1,
+    &pProfile->E.peak.height_km,
+    &pProfile->F2.layer.peak.height_km);
+
+  E_layer_get_peak_thickness_dual(
+    &pProfile->E,
+    &pProfile->F1.peak.thickness.bottom_km);
+
+  iono_profile_get_peak_amplitudes_dual(pProfile);
+
+  F2_layer_exosphere_adjust_dual(
+    &pProfile->F2,
+    pTime,
+    &solar_activity);
+
+  return NEQUICK_OK;
+}
+
 #undef NEQUICK_G_JRC_IONO_PEAK_AMPLITUDE_ITERATION_COUNT
@@ -71,6 +71,125 @@ double_t get_sin_from_cos(const double_t cos_rad) {
   return sqrt(1.0 - cos_rad * cos_rad);
 }
 
+/** Chain rule: f(a) with f'(a) = derivative */
+static NeQuickG_dual_t dual_chain(
+  double_t value,
+  double_t derivative,
+  const NeQuickG_dual_t* const pA) {
+
+  NeQuickG_dual_t result;
+  result.value = value;
+  for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+    result.d[i] = derivative * pA->d[i];
+  }
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_constant(double_t value) {
+  NeQuickG_dual_t result;
+  result.value = value;
+  for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+    result.d[i] = 0.0;
+  }
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_variable(
+  double_t value,
+  size_t partial) {
+  NeQuickG_dual_t result = NeQuickG_dual_constant(value);
+  result.d[partial] = 1.0;
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_add(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b) {
+  NeQuickG_dual_t result;
+  result.value = a.value + b.value;
+  for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+    result.d[i] = a.d[i] + b.d[i];
+  }
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_sub(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b) {
+  NeQuickG_dual_t result;
+  result.value = a.value - b.value;
+  for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+    result.d[i] = a.d[i] - b.d[i];
+  }
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_mul(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b) {
+  NeQuickG_dual_t result;
+  result.value = a.value * b.value;
+  for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+    result.d[i] = (a.d[i] * b.value) + (a.value * b.d[i]);
+  }
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_div(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b) {
+  NeQuickG_dual_t result;
+  result.value = a.value / b.value;
+  for (size_t i = 0; i < NEQUICKG_DUAL_PARTIAL_COUNT; i++) {
+    result.d[i] = (a.d[i] - (result.value * b.d[i])) / b.value;
+  }
+  return result;
+}
+
+NeQuickG_dual_t NeQuickG_dual_linear(
+  const NeQuickG_dual_t a,
+  double_t factor,
+  double_t offset) {
+  return dual_chain((factor * a.value) + offset, factor, &a);
+}
+
+NeQuickG_dual_t NeQuickG_dual_square(const NeQuickG_dual_t a) {
+  return dual_chain(NeQuickG_square(a.value), 2.0 * a.value, &a);
+}
+
+NeQuickG_dual_t NeQuickG_dual_sqrt(const NeQuickG_dual_t a) {
+  double_t value = sqrt(a.value);
+  return dual_chain(value, 0.5 / value, &a);
+}
+
+NeQuickG_dual_t NeQuickG_dual_log(const NeQuickG_dual_t a) {
+  return dual_chain(log(a.value), 1.0 / a.value, &a);
+}
+
+NeQuickG_dual_t NeQuickG_dual_cos(const NeQuickG_dual_t a) {
+  return dual_chain(cos(a.value), -sin(a.value), &a);
+}
+
+NeQuickG_dual_t NeQuickG_dual_exp(const NeQuickG_dual_t power) {
+  double_t value = NeQuickG_exp(power.value);
+  return dual_chain(
+    value,
+    (fabs(power.value) > NEQUICKG_EXP_MAX_ABS) ? 0.0 : value,
+    &power);
+}
+
+NeQuickG_dual_t NeQuickG_dual_func_join(
+  const NeQuickG_dual_t func1,
+  const NeQuickG_dual_t func2,
+  double_t alpha,
+  const NeQuickG_dual_t x) {
+
+  NeQuickG_dual_t temp = NeQuickG_dual_exp(NeQuickG_dual_linear(x, alpha, 0.0));
+  return NeQuickG_dual_div(
+    NeQuickG_dual_add(NeQuickG_dual_mul(func1, temp), func2),
+    NeQuickG_dual_linear(temp, 1.0, 1.0));
+}
+
 #undef NEQUICKG_EXP_MIN_VALUE
 #undef NEQUICKG_EXP_MAX_VALUE
 #undef NEQUICKG_EXP_MAX_ABS
@@ -0,0 +1,110 @@
+/** NeQuick G shared model.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_model.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_error.h"
+
+int32_t NeQuickG_model_init(
+  NeQuickG_model_t* const pModel,
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+
+  pModel->is_loaded = false;
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  pModel->pCCIR_folder = NULL;
+  pModel->pCCIR_months = NULL;
+
+  if (!pModip_file) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MODIP,
+      NEQUICK_ERROR_CODE_BAD_MODIP_GRID_FILE,
+      "Modip file. null pointer exception.");
+  }
+
+  if (!pCCIR_folder) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_F2_LAYER,
+      NEQUICK_ERROR_CODE_BAD_CCIR_FILE,
+      "CCIR folder. null pointer exception.");
+  }
+
+  int32_t ret = modip_grid_init(pModip_file, &pModel->modip_grid);
+  if (ret != NEQUICK_OK) {
+    return ret;
+  }
+
+  // store a copy of the CCIR folder
+  pModel->pCCIR_folder = malloc(strlen(pCCIR_folder) + 1);
+  if (!pModel->pCCIR_folder) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to copy CCIR directory on the heap");
+  }
+  strcpy(pModel->pCCIR_folder, pCCIR_folder);
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+
+  pModel->is_loaded = true;
+  return NEQUICK_OK;
+}
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+int32_t NeQuickG_model_load_CCIR_months(
+  NeQuickG_model_t* const pModel) {
+
+  F2_layer_ionosonde_coefficients_t* pCCIR_months = malloc(
+    (NEQUICK_G_JRC_MONTH_DECEMBER - NEQUICK_G_JRC_MONTH_JANUARY + 1) *
+    sizeof(F2_layer_ionosonde_coefficients_t));
+  if (!pCCIR_months) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to allocate the CCIR maps on the heap");
+  }
+
+  for (uint8_t month = NEQUICK_G_JRC_MONTH_JANUARY;
+       month <= NEQUICK_G_JRC_MONTH_DECEMBER;
+       month++) {
+    int32_t ret = F2_layer_fourier_coefficients_load(
+      pModel->pCCIR_folder,
+      month,
+      &pCCIR_months[month - NEQUICK_G_JRC_MONTH_JANUARY]);
+    if (ret != NEQUICK_OK) {
+      free(pCCIR_months);
+      return ret;
+    }
+  }
+
+  free(pModel->pCCIR_months);
+  pModel->pCCIR_months = pCCIR_months;
+  return NEQUICK_OK;
+}
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+
+void NeQuickG_model_close(
+  NeQuickG_model_t* const pModel) {
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  if (pModel->pCCIR_months) {
+    free(pModel->pCCIR_months);
+    pModel->pCCIR_months = NULL;
+  }
+  if (pModel->pCCIR_folder) {
+    free(pModel->pCCIR_folder);
+    pModel->pCCIR_folder = NULL;
+  }
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+  pModel->is_loaded = false;
+}
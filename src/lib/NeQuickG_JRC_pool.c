@@ -0,0 +1,138 @@
+/** NeQuickG pool of sessions.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_pool.h"
+
+#include <stdlib.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_error.h"
+
+static void pool_free(NeQuickG_pool_t* const pPool) {
+  free(pPool->pFree);
+  pPool->pFree = NULL;
+  free(pPool->pIs_acquired);
+  pPool->pIs_acquired = NULL;
+  free(pPool->pSessions);
+  pPool->pSessions = NULL;
+}
+
+int32_t NeQuickG_pool_init(
+  NeQuickG_pool_t* const pPool,
+  const NeQuickG_model_t* const pModel,
+  size_t session_count) {
+
+  if (session_count == 0) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_SESSION_COUNT,
+      "Pool. the session count must be at least 1");
+  }
+
+  pPool->pSessions = calloc(session_count, sizeof(NeQuickG_context_t));
+  pPool->pIs_acquired = calloc(session_count, sizeof(bool));
+  pPool->pFree = calloc(session_count, sizeof(size_t));
+  if (!pPool->pSessions || !pPool->pIs_acquired || !pPool->pFree) {
+    pool_free(pPool);
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_MEMORY,
+      NEQUICK_ERROR_CODE_NO_RESOURCES,
+      "Not enough resources to allocate the pool sessions on the heap");
+  }
+
+  pPool->session_count = session_count;
+  pPool->free_count = session_count;
+  for (size_t i = 0; i < session_count; i++) {
+    NeQuickG_context_init(&pPool->pSessions[i], pModel);
+    NeQuickG_context_reset(&pPool->pSessions[i]);
+    pPool->pSessions[i].is_pooled = true;
+    // the first sessions are on top of the stack
+    pPool->pFree[i] = session_count - 1 - i;
+  }
+
+  pthread_mutex_init(&pPool->lock, NULL);
+  return NEQUICK_OK;
+}
+
+void NeQuickG_pool_close(
+  NeQuickG_pool_t* const pPool) {
+  if (pPool->pSessions) {
+    pthread_mutex_destroy(&pPool->lock);
+    for (size_t i = 0; i < pPool->session_count; i++) {
+      NeQuickG_context_close(&pPool->pSessions[i]);
+    }
+    pool_free(pPool);
+  }
+}
+
+int32_t NeQuickG_pool_acquire(
+  NeQuickG_pool_t* const pPool,
+  NeQuickG_context_t** const ppContext) {
+
+  *ppContext = NULL;
+
+  pthread_mutex_lock(&pPool->lock);
+  if (pPool->free_count > 0) {
+    size_t index = pPool->pFree[--pPool->free_count];
+    pPool->pIs_acquired[index] = true;
+    *ppContext = &pPool->pSessions[index];
+  }
+  pthread_mutex_unlock(&pPool->lock);
+
+  if (!*ppContext) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_POOL_EXHAUSTED,
+      "Pool. all the %zu sessions are acquired",
+      pPool->session_count);
+  }
+  return NEQUICK_OK;
+}
+
+int32_t NeQuickG_pool_release(
+  NeQuickG_pool_t* const pPool,
+  NeQuickG_context_t* const pContext) {
+
+  uintptr_t first = (uintptr_t)pPool->pSessions;
+  uintptr_t session = (uintptr_t)pContext;
+  if ((session < first) ||
+      (((session - first) % sizeof(NeQuickG_context_t)) != 0) ||
+      (((session - first) / sizeof(NeQuickG_context_t)) >=
+        pPool->session_count)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_SESSION,
+      "Pool. the session does not belong to the pool");
+  }
+  size_t index = (session - first) / sizeof(NeQuickG_context_t);
+
+  bool is_acquired;
+  pthread_mutex_lock(&pPool->lock);
+  is_acquired = pPool->pIs_acquired[index];
+  pthread_mutex_unlock(&pPool->lock);
+
+  if (!is_acquired) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_SESSION,
+      "Pool. the session %zu is not acquired",
+      index);
+  }
+
+  // the session is still acquired: only the caller can touch it
+  NeQuickG_context_reset(pContext);
+
+  pthread_mutex_lock(&pPool->lock);
+  pPool->pIs_acquired[index] = false;
+  pPool->pFree[pPool->free_count++] = index;
+  pthread_mutex_unlock(&pPool->lock);
+
+  return NEQUICK_OK;
+}
@@ -0,0 +1,204 @@
+/** NeQuickG layer peaks interpolated along a slant ray.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_profile_anchors.h"
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "NeQuickG_JRC_geometry.h"
+#include "NeQuickG_JRC_macros.h"
+
+/** Scale of the interpolation coordinate (km): the anchors are evenly
+ * spread in slant distance below it and in its logarithm above it
+ */
+#define NEQUICK_G_JRC_PROFILE_ANCHORS_SCALE_KM (1000.0)
+
+/** Interpolation coordinate of a slant distance */
+static double_t get_coordinate(
+  const profile_anchors_t* const pAnchors,
+  const double_t point_km) {
+  return log1p(
+    (point_km - pAnchors->start_km) / NEQUICK_G_JRC_PROFILE_ANCHORS_SCALE_KM);
+}
+
+void profile_anchors_init(
+  profile_anchors_t* const pAnchors) {
+  pAnchors->count = 0;
+}
+
+void profile_anchors_set_points(
+  profile_anchors_t* const pAnchors,
+  const size_t count,
+  const double_t start_km,
+  const double_t end_km) {
+
+  assert(count >= NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN);
+  assert(count <= NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX);
+
+  pAnchors->count = count;
+  pAnchors->start_km = start_km;
+  pAnchors->end_km = end_km;
+
+  const double_t half_length = get_coordinate(pAnchors, end_km) / 2.0;
+  const double_t step_rad = NEQUICK_G_JRC_PI / (double_t)(count - 1);
+
+  // Chebyshev-Gauss-Lobatto points in ascending order,
+  // the weights alternate and are halved at both ends
+  for (size_t i = 0; i < count; i++) {
+    pAnchors->coordinate[i] =
+      half_length - (half_length * cos(step_rad * (double_t)i));
+    pAnchors->point_km[i] =
+      start_km +
+      (NEQUICK_G_JRC_PROFILE_ANCHORS_SCALE_KM *
+       expm1(pAnchors->coordinate[i]));
+    pAnchors->weight[i] = ((i % 2) == 0) ? 1.0 : -1.0;
+  }
+  pAnchors->coordinate[0] = 0.0;
+  pAnchors->point_km[0] = start_km;
+  pAnchors->point_km[count - 1] = end_km;
+  pAnchors->weight[0] /= 2.0;
+  pAnchors->weight[count - 1] /= 2.0;
+}
+
+/** Updates the extremes of the peak parameters of the anchors */
+static void set_extremes(
+  const peak_t* const pPeak,
+  const bool is_first,
+  peak_t* const pPeak_min,
+  peak_t* const pPeak_max) {
+
+  if (is_first) {
+    *pPeak_min = *pPeak;
+    *pPeak_max = *pPeak;
+    return;
+  }
+
+  pPeak_min->amplitude = min(pPeak_min->amplitude, pPeak->amplitude);
+  pPeak_max->amplitude = max(pPeak_max->amplitude, pPeak->amplitude);
+  pPeak_min->height_km = min(pPeak_min->height_km, pPeak->height_km);
+  pPeak_max->height_km = max(pPeak_max->height_km, pPeak->height_km);
+  pPeak_min->thickness.top_km =
+    min(pPeak_min->thickness.top_km, pPeak->thickness.top_km);
+  pPeak_max->thickness.top_km =
+    max(pPeak_max->thickness.top_km, pPeak->thickness.top_km);
+  pPeak_min->thickness.bottom_km =
+    min(pPeak_min->thickness.bottom_km, pPeak->thickness.bottom_km);
+  pPeak_max->thickness.bottom_km =
+    max(pPeak_max->thickness.bottom_km, pPeak->thickness.bottom_km);
+}
+
+void profile_anchors_set_peaks(
+  profile_anchors_t* const pAnchors,
+  const size_t index,
+  const peak_t* const pE_peak,
+  const peak_t* const pF1_peak,
+  const peak_t* const pF2_peak) {
+
+  assert(index < pAnchors->count);
+
+  pAnchors->E_peak[index] = *pE_peak;
+  pAnchors->F1_peak[index] = *pF1_peak;
+  pAnchors->F2_peak[index] = *pF2_peak;
+
+  const peak_t* const pPeak[NEQUICK_G_JRC_PROFILE_ANCHORS_LAYER_COUNT] = {
+    pE_peak, pF1_peak, pF2_peak
+  };
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_ANCHORS_LAYER_COUNT; i++) {
+    set_extremes(
+      pPeak[i],
+      (index == 0),
+      &pAnchors->peak_min[i],
+      &pAnchors->peak_max[i]);
+  }
+}
+
+/** Weighted sum of the peaks of the anchors, kept between their extremes:
+ * the polynomial overshoots where a peak changes fast (e.g. the F1 layer
+ * at sunset) and a thickness must not get close to 0
+ */
+static void interpolate_peak(
+  const peak_t* const pPeak,
+  const double_t* const pCoefficient,
+  const size_t count,
+  const peak_t* const pPeak_min,
+  const peak_t* const pPeak_max,
+  peak_t* const pResult) {
+
+  double_t amplitude = 0.0;
+  double_t height_km = 0.0;
+  double_t top_km = 0.0;
+  double_t bottom_km = 0.0;
+  double_t electron_density = 0.0;
+
+  for (size_t i = 0; i < count; i++) {
+    amplitude += pCoefficient[i]*pPeak[i].amplitude;
+    height_km += pCoefficient[i]*pPeak[i].height_km;
+    top_km += pCoefficient[i]*pPeak[i].thickness.top_km;
+    bottom_km += pCoefficient[i]*pPeak[i].thickness.bottom_km;
+    // not a number for the F2 peak, computed for the node
+    electron_density += pCoefficient[i]*pPeak[i].electron_density;
+  }
+
+  pResult->amplitude =
+    min(max(amplitude, pPeak_min->amplitude), pPeak_max->amplitude);
+  pResult->height_km =
+    min(max(height_km, pPeak_min->height_km), pPeak_max->height_km);
+  pResult->thickness.top_km = min(
+    max(top_km, pPeak_min->thickness.top_km), pPeak_max->thickness.top_km);
+  pResult->thickness.bottom_km = min(
+    max(bottom_km, pPeak_min->thickness.bottom_km),
+    pPeak_max->thickness.bottom_km);
+  pResult->electron_density = electron_density;
+}
+
+void profile_anchors_get_peaks(
+  const profile_anchors_t* const pAnchors,
+  const double_t point_km,
+  peak_t* const pE_peak,
+  peak_t* const pF1_peak,
+  peak_t* const pF2_peak) {
+
+  const size_t count = pAnchors->count;
+  const double_t coordinate = get_coordinate(
+    pAnchors, min(max(point_km, pAnchors->start_km), pAnchors->end_km));
+
+  double_t coefficient[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  double_t coefficient_sum = 0.0;
+
+  for (size_t i = 0; i < count; i++) {
+    double_t distance = coordinate - pAnchors->coordinate[i];
+    // the point is an anchor
+    if (!(fabs(distance) > 0.0)) {
+      *pE_peak = pAnchors->E_peak[i];
+      *pF1_peak = pAnchors->F1_peak[i];
+      *pF2_peak = pAnchors->F2_peak[i];
+      return;
+    }
+    coefficient[i] = pAnchors->weight[i] / distance;
+    coefficient_sum += coefficient[i];
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    coefficient[i] /= coefficient_sum;
+  }
+
+  interpolate_peak(
+    pAnchors->E_peak, coefficient, count,
+    &pAnchors->peak_min[0], &pAnchors->peak_max[0], pE_peak);
+  interpolate_peak(
+    pAnchors->F1_peak, coefficient, count,
+    &pAnchors->peak_min[1], &pAnchors->peak_max[1], pF1_peak);
+  interpolate_peak(
+    pAnchors->F2_peak, coefficient, count,
+    &pAnchors->peak_min[2], &pAnchors->peak_max[2], pF2_peak);
+}
+
+#undef NEQUICK_G_JRC_PROFILE_ANCHORS_SCALE_KM
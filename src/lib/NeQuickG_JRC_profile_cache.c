@@ -0,0 +1,328 @@
+/** NeQuickG profile cache of a session.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_profile_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_geometry.h"
+#include "NeQuickG_JRC_macros.h"
+
+/** Exact comparison, the peaks are reused only for identical inputs */
+#define NEQUICK_G_JRC_PROFILE_CACHE_IS_EQUAL(_d1, _d2) \
+  (memcmp(&(_d1), &(_d2), sizeof(double_t)) == 0)
+
+static uint64_t get_bits(const double_t value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+void profile_cache_init(
+  profile_cache_t* const pCache) {
+  pCache->is_enabled = false;
+  pCache->quantum_degree = 0.0;
+  pCache->clock = 0;
+  memset(&pCache->statistics, 0, sizeof(pCache->statistics));
+  pCache->set_count = 0;
+  pCache->pEntry = NULL;
+}
+
+int32_t profile_cache_set(
+  profile_cache_t* const pCache,
+  const bool is_enabled,
+  const double_t quantum_degree,
+  const size_t set_count) {
+
+  if (!(quantum_degree >= 0.0) ||
+      (quantum_degree > NEQUICKG_PROFILE_CACHE_QUANTUM_MAX_DEGREE)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_PROFILE_CACHE,
+      "Profile cache. quantum %lf (degrees) must be between 0 and %lf",
+      quantum_degree, NEQUICKG_PROFILE_CACHE_QUANTUM_MAX_DEGREE);
+  }
+
+  const size_t entry_count = is_enabled ?
+    set_count*NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT : 0;
+
+  if (!is_enabled) {
+    free(pCache->pEntry);
+    pCache->pEntry = NULL;
+  } else if (
+      (set_count == 0) ||
+      (set_count > NEQUICKG_PROFILE_CACHE_SET_COUNT_MAX)) {
+    NEQUICK_ERROR_RETURN(
+      NEQUICK_ERROR_SRC_INPUT_DATA,
+      NEQUICK_ERROR_CODE_BAD_PROFILE_CACHE,
+      "Profile cache. %zu sets, must be between 1 and %d",
+      set_count, NEQUICKG_PROFILE_CACHE_SET_COUNT_MAX);
+  } else if (set_count == pCache->set_count) {
+    memset(pCache->pEntry, 0, entry_count*sizeof(profile_cache_entry_t));
+  } else {
+    // calloc: the entries are not valid
+    profile_cache_entry_t* const pEntry =
+      calloc(entry_count, sizeof(profile_cache_entry_t));
+    if (!pEntry) {
+      NEQUICK_ERROR_RETURN(
+        NEQUICK_ERROR_SRC_MEMORY,
+        NEQUICK_ERROR_CODE_NO_RESOURCES,
+        "Not enough resources to allocate the profile cache");
+    }
+    free(pCache->pEntry);
+    pCache->pEntry = pEntry;
+  }
+
+  pCache->is_enabled = is_enabled;
+  pCache->quantum_degree = quantum_degree;
+  pCache->set_count = is_enabled ? set_count : 0;
+  pCache->clock = 0;
+  memset(&pCache->statistics, 0, sizeof(pCache->statistics));
+  return NEQUICK_OK;
+}
+
+/** Longitude in [0, 360) degrees */
+static double_t get_longitude_degree(const position_t* const pPosition) {
+  double_t longitude_degree =
+    fmod(pPosition->longitude.degree, NEQUICK_G_JRC_CIRCLE_DEGREES);
+  if (longitude_degree < 0.0) {
+    longitude_degree += NEQUICK_G_JRC_CIRCLE_DEGREES;
+  }
+  return longitude_degree;
+}
+
+static void set_key(
+  const uint64_t latitude,
+  const uint64_t longitude,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_t* const pSolar_activity,
+  profile_cache_key_t* const pKey) {
+  pKey->latitude = latitude;
+  pKey->longitude = longitude;
+  pKey->UTC = pTime->utc;
+  pKey->Az_sfu = pSolar_activity->effective_ionisation_level_sfu;
+  pKey->month = pTime->month;
+}
+
+void profile_cache_get_cell(
+  const profile_cache_t* const pCache,
+  const position_t* const pPosition,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_t* const pSolar_activity,
+  profile_cache_cell_t* const pCell) {
+
+  const double_t quantum_degree = pCache->quantum_degree;
+
+  if (!(quantum_degree > 0.0)) {
+    // the node position is set from them
+    set_key(
+      get_bits(pPosition->latitude.sin),
+      get_bits(pPosition->longitude.rad),
+      pTime,
+      pSolar_activity,
+      &pCell->key[0]);
+    pCell->key_count = 1;
+    pCell->latitude_fraction = 0.0;
+    pCell->longitude_fraction = 0.0;
+    return;
+  }
+
+  double_t latitude = pPosition->latitude.degree / quantum_degree;
+  double_t longitude = get_longitude_degree(pPosition) / quantum_degree;
+  double_t latitude_south = floor(latitude);
+  double_t longitude_west = floor(longitude);
+
+  pCell->latitude_fraction = latitude - latitude_south;
+  pCell->longitude_fraction = longitude - longitude_west;
+
+  uint64_t south = (uint64_t)(int64_t)latitude_south;
+  uint64_t west = (uint64_t)(int64_t)longitude_west;
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT; i++) {
+    set_key(
+      south + (uint64_t)(i & 1),
+      west + (uint64_t)(i >> 1),
+      pTime,
+      pSolar_activity,
+      &pCell->key[i]);
+  }
+  pCell->key_count = NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT;
+}
+
+void profile_cache_get_position(
+  const profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey,
+  const position_t* const pPosition,
+  position_t* const pKey_position) {
+
+  const double_t quantum_degree = pCache->quantum_degree;
+
+  if (!(quantum_degree > 0.0)) {
+    *pKey_position = *pPosition;
+    return;
+  }
+
+  double_t latitude_degree =
+    (double_t)(int64_t)pKey->latitude * quantum_degree;
+  latitude_degree = max(latitude_degree, NEQUICK_G_JRC_LAT_MIN_VALUE_DEGREE);
+  latitude_degree = min(latitude_degree, NEQUICK_G_JRC_LAT_MAX_VALUE_DEGREE);
+
+  // in range by construction
+  (void)position_set(
+    pKey_position,
+    (double_t)(int64_t)pKey->longitude * quantum_degree,
+    latitude_degree,
+    pPosition->height,
+    NEQUICK_G_JRC_HEIGHT_UNITS_KM);
+  pKey_position->radius_km = pPosition->radius_km;
+}
+
+static bool is_same_key(
+  const profile_cache_key_t* const pKey_1,
+  const profile_cache_key_t* const pKey_2) {
+  return (
+    (pKey_1->latitude == pKey_2->latitude) &&
+    (pKey_1->longitude == pKey_2->longitude) &&
+    (pKey_1->month == pKey_2->month) &&
+    NEQUICK_G_JRC_PROFILE_CACHE_IS_EQUAL(pKey_1->UTC, pKey_2->UTC) &&
+    NEQUICK_G_JRC_PROFILE_CACHE_IS_EQUAL(pKey_1->Az_sfu, pKey_2->Az_sfu));
+}
+
+/** Set of a key, from its location only:
+ * the time and the solar activity are the same along a ray
+ */
+static profile_cache_entry_t* get_set(
+  profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey) {
+
+  uint64_t hash =
+    (pKey->latitude * UINT64_C(0x9E3779B97F4A7C15)) ^
+    (pKey->longitude * UINT64_C(0xC2B2AE3D27D4EB4F));
+  hash ^= (hash >> 32);
+
+  return &pCache->pEntry[
+    (hash % pCache->set_count)*NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT];
+}
+
+const profile_cache_entry_t* profile_cache_find(
+  profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey) {
+
+  pCache->clock++;
+
+  profile_cache_entry_t* const pSet = get_set(pCache, pKey);
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT; i++) {
+    profile_cache_entry_t* const pEntry = &pSet[i];
+    if (pEntry->is_valid && is_same_key(&pEntry->key, pKey)) {
+      pEntry->last_use = pCache->clock;
+      pCache->statistics.hit_count++;
+      return pEntry;
+    }
+  }
+
+  pCache->statistics.miss_count++;
+  return NULL;
+}
+
+profile_cache_entry_t* profile_cache_add(
+  profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey) {
+
+  profile_cache_entry_t* const pSet = get_set(pCache, pKey);
+
+  profile_cache_entry_t* pLeast_recently_used = &pSet[0];
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT; i++) {
+    profile_cache_entry_t* const pEntry = &pSet[i];
+    if (!pEntry->is_valid) {
+      pLeast_recently_used = pEntry;
+      break;
+    }
+    if (pEntry->last_use < pLeast_recently_used->last_use) {
+      pLeast_recently_used = pEntry;
+    }
+  }
+
+  if (pLeast_recently_used->is_valid) {
+    pCache->statistics.eviction_count++;
+  }
+
+  pLeast_recently_used->is_valid = true;
+  pLeast_recently_used->last_use = pCache->clock;
+  pLeast_recently_used->key = *pKey;
+  return pLeast_recently_used;
+}
+
+/** Bilinear interpolation of a peak */
+static void interpolate_peak(
+  const peak_t* const pPeak[NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT],
+  const double_t* const pWeight,
+  peak_t* const pResult) {
+
+  pResult->amplitude = 0.0;
+  pResult->height_km = 0.0;
+  pResult->thickness.top_km = 0.0;
+  pResult->thickness.bottom_km = 0.0;
+  pResult->electron_density = 0.0;
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT; i++) {
+    pResult->amplitude += pWeight[i]*pPeak[i]->amplitude;
+    pResult->height_km += pWeight[i]*pPeak[i]->height_km;
+    pResult->thickness.top_km += pWeight[i]*pPeak[i]->thickness.top_km;
+    pResult->thickness.bottom_km += pWeight[i]*pPeak[i]->thickness.bottom_km;
+    // not a number for the F2 peak, computed for the node
+    pResult->electron_density += pWeight[i]*pPeak[i]->electron_density;
+  }
+}
+
+void profile_cache_get_peaks(
+  const profile_cache_cell_t* const pCell,
+  const profile_cache_entry_t* const * const pCorner,
+  peak_t* const pE_peak,
+  peak_t* const pF1_peak,
+  peak_t* const pF2_peak) {
+
+  if (pCell->key_count == 1) {
+    *pE_peak = pCorner[0]->E_peak;
+    *pF1_peak = pCorner[0]->F1_peak;
+    *pF2_peak = pCorner[0]->F2_peak;
+    return;
+  }
+
+  const double_t latitude_fraction = pCell->latitude_fraction;
+  const double_t longitude_fraction = pCell->longitude_fraction;
+
+  // same order as the corners
+  const double_t weight[NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT] = {
+    (1.0 - latitude_fraction)*(1.0 - longitude_fraction),
+    latitude_fraction*(1.0 - longitude_fraction),
+    (1.0 - latitude_fraction)*longitude_fraction,
+    latitude_fraction*longitude_fraction
+  };
+
+  const peak_t* pPeak[NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT];
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT; i++) {
+    pPeak[i] = &pCorner[i]->E_peak;
+  }
+  interpolate_peak(pPeak, weight, pE_peak);
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT; i++) {
+    pPeak[i] = &pCorner[i]->F1_peak;
+  }
+  interpolate_peak(pPeak, weight, pF1_peak);
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT; i++) {
+    pPeak[i] = &pCorner[i]->F2_peak;
+  }
+  interpolate_peak(pPeak, weight, pF2_peak);
+}
+
+#undef NEQUICK_G_JRC_PROFILE_CACHE_IS_EQUAL
@@ -287,25 +287,35 @@ double_t get_slant_distance(
   return sqrt(fabs(temp));
 }
 
-int32_t ray_get(
+void ray_get_vertical(
   ray_context_t* const pRay,
   const position_t * const pStation_position,
   const position_t * const pSatellite_position) {
 
   pRay->receiver_position = *pStation_position;
   pRay->satellite_position = *pSatellite_position;
+  pRay->is_vertical = true;
 
-  pRay->is_vertical =
-    position_is_above(pStation_position, pSatellite_position);
+  on_vertical_ray(pRay);
+}
+
+int32_t ray_get(
+  ray_context_t* const pRay,
+  const position_t * const pStation_position,
+  const position_t * const pSatellite_position) {
 
   // Check if ray is vertical
-  if (pRay->is_vertical) {
+  if (position_is_above(pStation_position, pSatellite_position)) {
 
-    on_vertical_ray(pRay);
+    ray_get_vertical(pRay, pStation_position, pSatellite_position);
     return NEQUICK_OK;
 
   } else {
 
+    pRay->receiver_position = *pStation_position;
+    pRay->satellite_position = *pSatellite_position;
+    pRay->is_vertical = false;
+
     return on_slant_ray(pRay);
 
   }
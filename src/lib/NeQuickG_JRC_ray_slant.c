@@ -10,23 +10,12 @@
  */
 #include "NeQuickG_JRC_ray_slant.h"
 
+#include <assert.h>
+
 #include "NeQuickG_JRC_electron_density.h"
 #include "NeQuickG_JRC_geometry.h"
 #include "NeQuickG_JRC_math_utils.h"
 
-static angle_restricted_t get_delta_angle(
-  const ray_context_t* const pRay,
-  const double_t height_km) {
-
-  angle_restricted_t delta;
-
-  double_t tangent_delta = height_km / pRay->slant.perigee_radius_km;
-  delta.cos = 1.0 / sqrt(1.0 + NeQuickG_square(tangent_delta));
-  delta.sin = tangent_delta * delta.cos;
-
-  return delta;
-}
-
 static angle_t get_lambda_s_p_angle(
   const ray_context_t* const pRay,
   const angle_restricted_t* pDelta,
@@ -51,42 +40,201 @@ static angle_t get_lambda_s_p_angle(
   return delta_lambda_s_p;
 }
 
-static position_t get_current_position(
+/** Stage 1: position of the nodes along the ray.
+ * The arithmetic part has no branches and runs on contiguous arrays,
+ * the angles are then completed node by node.
+ */
+static void get_node_positions(
   const ray_context_t* const pRay,
-  const double_t height_km) {
-  position_t current_position;
+  const double_t* const pHeight_km,
+  const size_t count,
+  position_t* const pPosition) {
 
-  current_position.radius_km =
-    sqrt(NeQuickG_square(height_km) + NeQuickG_square(pRay->slant.perigee_radius_km));
+  double_t delta_cos[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  double_t delta_sin[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  double_t radius_km[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  double_t latitude_sin[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
 
-  current_position.height =
-    get_height_from_radius(current_position.radius_km);
+  const double_t perigee_radius_km = pRay->slant.perigee_radius_km;
+  const double_t receiver_latitude_sin = pRay->receiver_position.latitude.sin;
+  const double_t receiver_latitude_cos = pRay->receiver_position.latitude.cos;
+  const double_t azimuth_cos = pRay->slant.azimuth.cos;
 
-  angle_restricted_t delta = get_delta_angle(pRay, height_km);
+  for (size_t i = 0; i < count; i++) {
+    double_t tangent_delta = pHeight_km[i] / perigee_radius_km;
+    delta_cos[i] = 1.0 / sqrt(1.0 + (tangent_delta * tangent_delta));
+    delta_sin[i] = tangent_delta * delta_cos[i];
 
-  // latitude
-  {
-    current_position.latitude.sin =
-      (pRay->receiver_position.latitude.sin * delta.cos) +
-      (pRay->receiver_position.latitude.cos * delta.sin * pRay->slant.azimuth.cos);
+    radius_km[i] = sqrt(
+      (pHeight_km[i] * pHeight_km[i]) +
+      (perigee_radius_km * perigee_radius_km));
 
-    angle_set_fom_sin(&current_position.latitude);
+    latitude_sin[i] =
+      (receiver_latitude_sin * delta_cos[i]) +
+      (receiver_latitude_cos * delta_sin[i] * azimuth_cos);
   }
 
-  // longitude
-  {
+  for (size_t i = 0; i < count; i++) {
+    position_t* const pCurrent_position = &pPosition[i];
+
+    pCurrent_position->radius_km = radius_km[i];
+    pCurrent_position->height = get_height_from_radius(radius_km[i]);
+
+    pCurrent_position->latitude.sin = latitude_sin[i];
+    angle_set_fom_sin(&pCurrent_position->latitude);
+
+    angle_restricted_t delta;
+    delta.cos = delta_cos[i];
+    delta.sin = delta_sin[i];
+
     angle_t delta_lambda_s_p =
       get_lambda_s_p_angle(
         pRay,
         &delta,
-        &current_position.latitude);
+        &pCurrent_position->latitude);
 
     angle_set_rad(
-      &current_position.longitude,
+      &pCurrent_position->longitude,
       delta_lambda_s_p.rad + pRay->longitude.rad);
   }
+}
+
+/** Stages 2 and 3 with the profile cache: the layer peaks at a location
+ * (MODIP and ionosphere information) are computed only if they are not
+ * in the cache
+ */
+static int32_t get_node_peaks_cached(
+  NeQuickG_context_t* const pContext,
+  const position_t* const pPosition,
+  const size_t count,
+  peak_t* const pE_peak,
+  peak_t* const pF1_peak,
+  peak_t* const pF2_peak) {
+
+  profile_cache_t* const pCache = &pContext->profile_cache;
+  iono_profile_t* const pProfile = &pContext->profile;
+
+  for (size_t i = 0; i < count; i++) {
+    profile_cache_cell_t cell;
+    profile_cache_get_cell(
+      pCache,
+      &pPosition[i],
+      &pContext->input_data.time,
+      &pContext->solar_activity,
+      &cell);
+
+    // the corners of the node are the most recently used entries,
+    // adding a corner does not replace another one
+    const profile_cache_entry_t* pCorner[
+      NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT];
+
+    for (size_t j = 0; j < cell.key_count; j++) {
+      pCorner[j] = profile_cache_find(pCache, &cell.key[j]);
+      if (pCorner[j]) {
+        continue;
+      }
+
+      position_t key_position;
+      profile_cache_get_position(
+        pCache, &cell.key[j], &pPosition[i], &key_position);
+
+      int32_t ret = iono_profile_get(
+        pProfile,
+        &pContext->input_data.time,
+        &pContext->modip,
+        &pContext->solar_activity,
+        &key_position);
+      if (ret != NEQUICK_OK) {
+        return ret;
+      }
+
+      profile_cache_entry_t* pEntry = profile_cache_add(pCache, &cell.key[j]);
+      pEntry->E_peak = pProfile->E.layer.peak;
+      pEntry->F1_peak = pProfile->F1.peak;
+      pEntry->F2_peak = pProfile->F2.layer.peak;
+      pCorner[j] = pEntry;
+    }
+
+    profile_cache_get_peaks(
+      &cell, pCorner, &pE_peak[i], &pF1_peak[i], &pF2_peak[i]);
+  }
+
+  return NEQUICK_OK;
+}
+
+int32_t ray_slant_get_electron_densities(
+  NeQuickG_context_t* const pContext,
+  const double_t* const pHeight_km,
+  const size_t count,
+  double_t* const pElectron_density) {
+
+  assert(count <= NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX);
+
+  position_t position[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  double_t modip_degree[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  peak_t E_peak[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  peak_t F1_peak[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+  peak_t F2_peak[NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX];
+
+  get_node_positions(&pContext->ray, pHeight_km, count, position);
+
+  iono_profile_t* const pProfile = &pContext->profile;
+
+  if (pContext->profile_anchors.count > 0) {
+    for (size_t i = 0; i < count; i++) {
+      profile_anchors_get_peaks(
+        &pContext->profile_anchors,
+        pHeight_km[i],
+        &E_peak[i],
+        &F1_peak[i],
+        &F2_peak[i]);
+    }
+  } else if (pContext->profile_cache.is_enabled) {
+    int32_t ret = get_node_peaks_cached(
+      pContext, position, count, E_peak, F1_peak, F2_peak);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+  } else {
+    // Stage 2: MODIP of the nodes
+    for (size_t i = 0; i < count; i++) {
+      modip_get(&pContext->modip, &position[i]);
+      modip_degree[i] = pContext->modip.modip_degree;
+    }
+
+    // Stage 3: ionosphere information of the nodes, only the layer peaks
+    // are kept for the electron density
+    for (size_t i = 0; i < count; i++) {
+      pContext->modip.modip_degree = modip_degree[i];
+
+      int32_t ret = iono_profile_get_at_modip(
+        pProfile,
+        &pContext->input_data.time,
+        &pContext->modip,
+        &pContext->solar_activity,
+        &position[i]);
+      if (ret != NEQUICK_OK) {
+        return ret;
+      }
+
+      E_peak[i] = pProfile->E.layer.peak;
+      F1_peak[i] = pProfile->F1.peak;
+      F2_peak[i] = pProfile->F2.layer.peak;
+    }
+  }
+
+  // Stage 4: electron density of the nodes
+  for (size_t i = 0; i < count; i++) {
+    pProfile->E.layer.peak = E_peak[i];
+    pProfile->F1.peak = F1_peak[i];
+    pProfile->F2.layer.peak = F2_peak[i];
+
+    pElectron_density[i] = electron_density_get(
+      pProfile,
+      position[i].height);
+  }
 
-  return current_position;
+  return NEQUICK_OK;
 }
 
 int32_t ray_slant_get_electron_density(
@@ -94,26 +242,91 @@ int32_t ray_slant_get_electron_density(
   const double_t height_km,
   double_t* const pElectron_density) {
 
-  // Adjust position information for current position along ray
-  position_t current_position =
-    get_current_position(&pContext->ray, height_km);
+  return ray_slant_get_electron_densities(
+    pContext, &height_km, (size_t)1, pElectron_density);
+}
 
-  // recalculate ionosphere information now that the latitude and longitude have
-  // changed
-  int32_t ret = iono_profile_get(
+int32_t ray_slant_get_electron_density_dual(
+  NeQuickG_context_t* const pContext,
+  const double_t height_km,
+  position_t* const pPosition,
+  NeQuickG_dual_t* const pElectron_density) {
+
+  get_node_positions(&pContext->ray, &height_km, (size_t)1, pPosition);
+
+  NeQuickG_dual_t modip_degree;
+  modip_get_dual(&pContext->modip, pPosition, &modip_degree);
+
+  iono_profile_dual_t profile;
+  int32_t ret = iono_profile_get_dual(
     &pContext->profile,
     &pContext->input_data.time,
-    &pContext->modip,
+    &modip_degree,
     &pContext->solar_activity,
-    &current_position);
-
+    pPosition,
+    &profile);
   if (ret != NEQUICK_OK) {
     return ret;
   }
 
-  *pElectron_density = electron_density_get(
-    &pContext->profile,
-    current_position.height);
+  NeQuickG_dual_t height = NeQuickG_dual_variable(
+    pPosition->height, NEQUICKG_DUAL_PARTIAL_HEIGHT);
+  *pElectron_density = electron_density_get_dual(&profile, &height);
+  return NEQUICK_OK;
+}
 
+int32_t ray_slant_set_profile_anchors(
+  NeQuickG_context_t* const pContext,
+  const size_t count,
+  const double_t start_km,
+  const double_t end_km) {
+
+  profile_anchors_t* const pAnchors = &pContext->profile_anchors;
+  iono_profile_t* const pProfile = &pContext->profile;
+
+  // the peaks of the anchors are computed at every node
+  pAnchors->count = 0;
+
+  profile_anchors_t anchors;
+  profile_anchors_set_points(&anchors, count, start_km, end_km);
+
+  position_t position[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  get_node_positions(&pContext->ray, anchors.point_km, count, position);
+
+  for (size_t i = 0; i < count; i++) {
+    int32_t ret = iono_profile_get(
+      pProfile,
+      &pContext->input_data.time,
+      &pContext->modip,
+      &pContext->solar_activity,
+      &position[i]);
+    if (ret != NEQUICK_OK) {
+      return ret;
+    }
+
+    profile_anchors_set_peaks(
+      &anchors,
+      i,
+      &pProfile->E.layer.peak,
+      &pProfile->F1.peak,
+      &pProfile->F2.layer.peak);
+  }
+
+  *pAnchors = anchors;
   return NEQUICK_OK;
 }
+
+int32_t ray_slant_get_profile(
+  NeQuickG_context_t* const pContext,
+  const double_t height_km) {
+
+  position_t position;
+  get_node_positions(&pContext->ray, &height_km, (size_t)1, &position);
+
+  return iono_profile_get(
+    &pContext->profile,
+    &pContext->input_data.time,
+    &pContext->modip,
+    &pContext->solar_activity,
+    &position);
+}
@@ -37,8 +37,39 @@ int32_t ray_vertical_get_profile(NeQuickG_context_t* const pContext) {
     &current_position);
 }
 
+int32_t ray_vertical_get_profile_dual(
+  NeQuickG_context_t* const pContext,
+  iono_profile_dual_t* const pProfile) {
+
+  position_t current_position = get_current_position(&pContext->ray);
+
+  NeQuickG_dual_t modip_degree;
+  modip_get_dual(&pContext->modip, &current_position, &modip_degree);
+
+  return iono_profile_get_dual(
+    &pContext->profile,
+    &pContext->input_data.time,
+    &modip_degree,
+    &pContext->solar_activity,
+    &current_position,
+    pProfile);
+}
+
 double_t ray_vertical_get_electron_density(
   NeQuickG_context_t* const pContext,
   const double_t height_km) {
   return electron_density_get(&pContext->profile, height_km);
 }
+
+double_t ray_vertical_get_integral(
+  NeQuickG_context_t* const pContext,
+  const double_t height_1_km,
+  const double_t height_2_km) {
+
+  size_t evaluation_count;
+  double_t integral = electron_density_get_integral(
+    &pContext->profile, height_1_km, height_2_km, &evaluation_count);
+
+  pContext->integration.evaluation_count += evaluation_count;
+  return integral;
+}
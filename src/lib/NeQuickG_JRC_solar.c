@@ -97,18 +97,24 @@ solar_get_declination(const NeQuickG_time_t * const pTime) {
  *  with the time before solar noon expressed as negative degrees,
  *  and the local time after solar noon expressed as positive degrees.
  */
-static double_t get_cosinus_hour_angle(
+static double_t get_hour_angle(
   const NeQuickG_time_t * const pTime,
   const position_t* const pPosition) {
 
   double_t local_time =
     NeQuickG_time_get_local(pTime, pPosition->longitude.degree);
 
-  return cos((NEQUICK_G_JRC_PI *
+  return ((NEQUICK_G_JRC_PI *
      (NEQUICK_G_JRC_TIME_HALF_DAY_IN_HOURS - local_time)) /
       NEQUICK_G_JRC_TIME_HALF_DAY_IN_HOURS);
 }
 
+static double_t get_cosinus_hour_angle(
+  const NeQuickG_time_t * const pTime,
+  const position_t* const pPosition) {
+  return cos(get_hour_angle(pTime, pPosition));
+}
+
 /** Compute solar zenith angle chi [deg] for the given location.
  * The solar zenith angle is the angle between the zenith and the centre
  * of the Sun's disc
@@ -130,6 +136,45 @@ static angle_t get_zenith_angle(
   return zenith;
 }
 
+/** Solar zenith angle in degrees with its derivatives
+ * with respect to the latitude and the longitude (degree):
+ * d(cos &chi;)/d&phi; = cos&phi;sin&delta; - sin&phi;cos&delta;cosH
+ * d(cos &chi;)/d&lambda; = cos&phi;cos&delta;sinH,
+ * as the hour angle H decreases one degree per degree of longitude
+ */
+static NeQuickG_dual_t get_zenith_angle_dual(
+  const position_t* const pPosition,
+  const NeQuickG_time_t* const pTime,
+  const angle_restricted_t* const pSolar_declination) {
+
+  double_t hour_angle_rad = get_hour_angle(pTime, pPosition);
+  double_t cos_hour_angle = cos(hour_angle_rad);
+
+  angle_t zenith;
+  zenith.cos =
+    (pPosition->latitude.sin * pSolar_declination->sin) +
+      (pPosition->latitude.cos * pSolar_declination->cos *
+        cos_hour_angle);
+  angle_set_fom_cos(&zenith);
+
+  NeQuickG_dual_t zenith_degree = NeQuickG_dual_constant(zenith.degree);
+  if (zenith.sin > 0.0) {
+    double_t dcos_dlatitude =
+      (pPosition->latitude.cos * pSolar_declination->sin) -
+      (pPosition->latitude.sin * pSolar_declination->cos *
+        cos_hour_angle);
+    double_t dcos_dlongitude =
+      pPosition->latitude.cos * pSolar_declination->cos *
+        sin(hour_angle_rad);
+    // d(cos)/d(degree) = -sin * d(rad)/d(degree), the pi/180 cancel out
+    zenith_degree.d[NEQUICKG_DUAL_PARTIAL_LATITUDE] =
+      -dcos_dlatitude / zenith.sin;
+    zenith_degree.d[NEQUICKG_DUAL_PARTIAL_LONGITUDE] =
+      -dcos_dlongitude / zenith.sin;
+  }
+  return zenith_degree;
+}
+
 double_t
   solar_get_effective_zenith_angle(
   const position_t* const pPosition,
@@ -154,6 +199,35 @@ double_t
       NEQUICK_G_JRC_SOLAR_ZENITH_ANGLE_AT_DAY_NIGHT_TRANSITION_DEGREE);
 }
 
+NeQuickG_dual_t
+  solar_get_effective_zenith_angle_dual(
+  const position_t* const pPosition,
+  const NeQuickG_time_t * const pTime,
+  const angle_restricted_t* const pSolar_declination) {
+
+  NeQuickG_dual_t zenith_angle =
+    get_zenith_angle_dual(pPosition, pTime, pSolar_declination);
+
+  NeQuickG_dual_t func1 =
+    NeQuickG_dual_linear(
+      NeQuickG_dual_exp(
+        NeQuickG_dual_linear(
+          zenith_angle,
+          -NEQUICK_G_JRC_SOLAR_EFFECTIVE_ZENITH_CONST4,
+          NEQUICK_G_JRC_SOLAR_EFFECTIVE_ZENITH_CONST3)),
+      -NEQUICK_G_JRC_SOLAR_EFFECTIVE_ZENITH_CONST2,
+      NEQUICK_G_JRC_SOLAR_EFFECTIVE_ZENITH_CONST1);
+
+  return NeQuickG_dual_func_join(
+    func1,
+    zenith_angle,
+    NEQUICK_G_JRC_SOLAR_EFFECTIVE_ZENITH_CONST5,
+    NeQuickG_dual_linear(
+      zenith_angle,
+      1.0,
+      -NEQUICK_G_JRC_SOLAR_ZENITH_ANGLE_AT_DAY_NIGHT_TRANSITION_DEGREE));
+}
+
 double_t solar_get_longitude(
   const NeQuickG_time_t* const pTime) {
   return (
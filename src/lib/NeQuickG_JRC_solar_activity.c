@@ -147,6 +147,60 @@ void solar_activity_get(
       pContext->effective_ionisation_level_sfu);
 }
 
+void solar_activity_get_dual(
+  const solar_activity_t* const pContext,
+  solar_activity_dual_t* const pDual) {
+
+  pDual->effective_ionisation_level_sfu =
+    NeQuickG_dual_variable(
+      pContext->effective_ionisation_level_sfu,
+      NEQUICKG_DUAL_PARTIAL_AZ);
+
+  pDual->effective_sun_spot_count =
+    NeQuickG_dual_constant(pContext->effective_sun_spot_count);
+  pDual->effective_sun_spot_count.d[NEQUICKG_DUAL_PARTIAL_AZ] =
+    get_solar_mean_spot_number_derivative(
+      pContext->effective_ionisation_level_sfu);
+}
+
+void solar_activity_get_effective_ionisation_level_gradient(
+  const solar_activity_t* const pContext,
+  double_t modip_degree,
+  double_t* const pGradient) {
+
+  const AZ_coefficients_t* const pCoeff =
+    &pContext->effective_ionisation_level_coeff;
+
+  double_t Az = Az_calc(pCoeff, modip_degree);
+  bool is_Az_in_range =
+    (Az > NEQUICK_G_AZ_MIN_VALUE_SFU) && (Az < NEQUICK_G_AZ_MAX_VALUE_SFU);
+
+  double_t term = (are_valid(pCoeff) && is_Az_in_range) ? 1.0 : 0.0;
+  for (size_t i = 0; i < NEQUICKG_AZ_COEFFICIENTS_COUNT; i++) {
+    pGradient[i] = term;
+    term *= modip_degree;
+  }
+}
+
+double_t solar_activity_get_effective_ionisation_level_modip_derivative(
+  const solar_activity_t* const pContext,
+  double_t modip_degree) {
+
+  double_t gradient[NEQUICKG_AZ_COEFFICIENTS_COUNT];
+  solar_activity_get_effective_ionisation_level_gradient(
+    pContext, modip_degree, gradient);
+
+  // dAz/dMODIP = ai1 + 2*ai2*MODIP
+  double_t derivative = 0.0;
+  for (size_t i = 1; i < NEQUICKG_AZ_COEFFICIENTS_COUNT; i++) {
+    derivative +=
+      (double_t)i *
+      pContext->effective_ionisation_level_coeff.a_sfu[i] *
+      gradient[i - 1];
+  }
+  return derivative;
+}
+
 #undef NEQUICK_G_AZ_EQUALITY_EPSILON
 #undef NEQUICK_G_AZ_DEFAULT_VALUE_SFU
 #undef NEQUICK_G_IONO_COEFF_IS_ZERO
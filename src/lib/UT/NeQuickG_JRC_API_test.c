@@ -11,7 +11,10 @@
  */
 #include "NeQuickG_JRC_API_test.h"
 
+#include <float.h>
+
 #include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_error.h"
 #include "NeQuickG_JRC_macros.h"
 
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
@@ -58,6 +61,14 @@ static bool test_bad_month(
   if (NeQuickG.set_time(nequick, 13, 0.0) == NEQUICK_OK) {
     ret = false;
   }
+
+  // the error is recorded as the last error of this thread
+  int32_t error_code;
+  if ((NeQuickG.get_last_error(&error_code) !=
+       NEQUICK_ERROR_SRC_INPUT_DATA) ||
+      (error_code != NEQUICK_ERROR_CODE_BAD_MONTH)) {
+    ret = false;
+  }
   NeQuickG.close(nequick);
 
   return ret;
@@ -277,51 +288,1477 @@ static bool test_bad_ray(
 }
 
 
-#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wmissing-prototypes"
+/** Expected STEC for the first link of benchmarkMid */
+#define NEQUICK_G_JRC_API_TEST_BENCHMARK_MID_STEC (18.26001)
+#define NEQUICK_G_JRC_API_TEST_STEC_EPSILON (1.0e-5)
+
+// first link of benchmarkMid
+static bool set_benchmark_link(NeQuickG_handle nequick) {
+
+  double_t az[NEQUICKG_AZ_COEFFICIENTS_COUNT] =
+    {121.129893, 0.351254133, 0.0134635348};
+  if (NeQuickG.set_solar_activity_coefficients(
+    nequick, az, (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT) != NEQUICK_OK) {
+    return false;
+  }
+
+  if (NeQuickG.set_time(nequick, 4, 0.0) != NEQUICK_OK) {
+    return false;
+  }
+
+  if (NeQuickG.set_receiver_position(
+      nequick, 40.19, -3.00, -23.32) != NEQUICK_OK) {
+    return false;
+  }
+
+  return (
+    NeQuickG.set_satellite_position(
+      nequick, 76.65, -41.43, 20157673.93) == NEQUICK_OK);
+}
+
+static bool get_benchmark_STEC(
+  NeQuickG_handle nequick,
+  double_t* const pTEC) {
+  return (
+    set_benchmark_link(nequick) &&
+    (NeQuickG.get_total_electron_content(nequick, pTEC) == NEQUICK_OK));
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_shared_model(pModip_file, pCCIR_directory) \
+  test_shared_model()
 #endif
-bool NeQuickG_API_test(
+
+// sessions opened on a shared model give the same STEC
+// as a handle owning its model
+static bool test_shared_model(
   const char* const pModip_file,
-  const char* const pCCIR_folder) {
-  bool ret = true;
+  const char* const pCCIR_directory) {
 
-#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-  if (!test_NULL_modip_file(pCCIR_folder)) {
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  double_t TEC_expected;
+  bool ret = get_benchmark_STEC(nequick, &TEC_expected);
+  NeQuickG.close(nequick);
+  if (!ret) {
+    return false;
+  }
+
+  if (!THRESHOLD_COMPARE(
+        TEC_expected,
+        NEQUICK_G_JRC_API_TEST_BENCHMARK_MID_STEC,
+        NEQUICK_G_JRC_API_TEST_STEC_EPSILON)) {
+    return false;
+  }
+
+  NeQuickG_model_handle model;
+  if (NeQuickG.model_init(pModip_file, pCCIR_directory, &model) != NEQUICK_OK) {
+    return false;
+  }
+
+  NeQuickG_handle session_1;
+  if (NeQuickG.session_init(model, &session_1) != NEQUICK_OK) {
+    NeQuickG.model_close(model);
+    return false;
+  }
+
+  NeQuickG_handle session_2;
+  if (NeQuickG.session_init(model, &session_2) != NEQUICK_OK) {
+    NeQuickG.close(session_1);
+    NeQuickG.model_close(model);
+    return false;
+  }
+
+  double_t TEC_1;
+  double_t TEC_2;
+  if (!get_benchmark_STEC(session_1, &TEC_1) ||
+      !get_benchmark_STEC(session_2, &TEC_2)) {
+    ret = false;
+  } else if (
+    !THRESHOLD_COMPARE(TEC_1, TEC_expected, DBL_EPSILON) ||
+    !THRESHOLD_COMPARE(TEC_2, TEC_expected, DBL_EPSILON)) {
     ret = false;
   }
 
-  if (!test_NULL_CCIR_dir(pModip_file)) {
+  NeQuickG.close(session_1);
+  NeQuickG.close(session_2);
+  NeQuickG.model_close(model);
+
+  // a session cannot be opened without a model
+  NeQuickG_handle session_3;
+  if (NeQuickG.session_init(NEQUICKG_INVALID_HANDLE, &session_3) == NEQUICK_OK) {
+    NeQuickG.close(session_3);
+    ret = false;
+  }
+
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_preloaded_model(pModip_file, pCCIR_directory) \
+  test_preloaded_model()
+#endif
+
+/** Number of epochs of #test_preloaded_model */
+#define NEQUICK_G_JRC_API_TEST_PRELOADED_EPOCH_COUNT (4)
+
+// a session on a model with the 12 months preloaded gives the same STEC as
+// a handle loading the month, also when the months alternate
+static bool test_preloaded_model(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  const uint8_t month[NEQUICK_G_JRC_API_TEST_PRELOADED_EPOCH_COUNT] =
+    {4, 7, 4, 12};
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  NeQuickG_model_handle model;
+  if (NeQuickG.model_init(
+        pModip_file, pCCIR_directory, &model) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  NeQuickG_handle session;
+  if (NeQuickG.session_init(model, &session) != NEQUICK_OK) {
+    NeQuickG.model_close(model);
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  bool ret = set_benchmark_link(nequick) && set_benchmark_link(session);
+
+  for (size_t i = 0;
+       ret && (i < NEQUICK_G_JRC_API_TEST_PRELOADED_EPOCH_COUNT);
+       i++) {
+    double_t TEC_expected;
+    double_t TEC;
+    if ((NeQuickG.set_time(nequick, month[i], 12.0) != NEQUICK_OK) ||
+        (NeQuickG.set_time(session, month[i], 12.0) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+           nequick, &TEC_expected) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+           session, &TEC) != NEQUICK_OK)) {
+      ret = false;
+    } else if (!THRESHOLD_COMPARE(TEC, TEC_expected, DBL_EPSILON)) {
+      LOG_ERROR("STEC with the preloaded CCIR maps is not the expected.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.close(session);
+  NeQuickG.model_close(model);
+  NeQuickG.close(nequick);
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  // the CCIR maps are read at initialization
+  if (NeQuickG.model_init(
+        pModip_file, "./no_such_folder/", &model) == NEQUICK_OK) {
+    NeQuickG.model_close(model);
+    ret = false;
+  } else if (model != NEQUICKG_INVALID_HANDLE) {
     ret = false;
   }
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
-  if (!test_bad_month(pModip_file, pCCIR_folder)) {
+  return ret;
+}
+
+/** The global adaptive and Patterson STEC must be within the largest tolerance
+ * of the G7-K15 integration (above 1000 km)
+ */
+#define NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON (0.01)
+/** The navigation preset STEC must be within its largest tolerance */
+#define NEQUICK_G_JRC_API_TEST_NAVIGATION_RELATIVE_EPSILON (0.05)
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_integration_method(pModip_file, pCCIR_directory) \
+  test_integration_method()
+#endif
+
+// the global adaptive and Patterson integrations need fewer evaluations
+// for about the same STEC, reset goes back to the recursive integration
+static bool test_integration_method(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  static const uint8_t method[] = {
+    NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE,
+    NEQUICKG_INTEGRATION_PATTERSON
+  };
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC_recursive;
+  size_t evaluation_count_recursive;
+  if (!get_benchmark_STEC(nequick, &TEC_recursive) ||
+      (NeQuickG.get_evaluation_count(
+         nequick, &evaluation_count_recursive) != NEQUICK_OK)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  for (size_t i = 0; i < (sizeof(method)/sizeof(method[0])); i++) {
+    double_t TEC;
+    size_t evaluation_count;
+    if ((NeQuickG.set_integration_method(nequick, method[i]) != NEQUICK_OK) ||
+        !get_benchmark_STEC(nequick, &TEC) ||
+        (NeQuickG.get_evaluation_count(
+           nequick, &evaluation_count) != NEQUICK_OK)) {
+      NeQuickG.close(nequick);
+      return false;
+    }
+
+    if ((evaluation_count == 0) ||
+        (evaluation_count > evaluation_count_recursive)) {
+      LOG_ERROR("integration evaluation count is not the expected.");
+      ret = false;
+    }
+
+    if (!THRESHOLD_COMPARE(
+          TEC,
+          TEC_recursive,
+          NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC_recursive)) {
+      LOG_ERROR("integration STEC is not the expected.");
+      ret = false;
+    }
+  }
+
+  if (NeQuickG.set_integration_method(nequick, UINT8_MAX) == NEQUICK_OK) {
     ret = false;
   }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_INTEGRATION_METHOD)) {
+      ret = false;
+    }
+  }
 
-  if (!test_bad_UTC(pModip_file, pCCIR_folder)) {
+  double_t TEC_reset;
+  if ((NeQuickG.reset(nequick) != NEQUICK_OK) ||
+      !get_benchmark_STEC(nequick, &TEC_reset) ||
+      !THRESHOLD_COMPARE(TEC_reset, TEC_recursive, DBL_EPSILON)) {
+    LOG_ERROR("reset must set the recursive integration back.");
     ret = false;
   }
 
-  if (!test_bad_latitude(pModip_file, pCCIR_folder)) {
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_integration_settings(pModip_file, pCCIR_directory) \
+  test_integration_settings()
+#endif
+
+static bool get_preset_STEC(
+  NeQuickG_handle nequick,
+  uint8_t preset,
+  double_t* const pTEC,
+  size_t* const pEvaluation_count) {
+
+  NeQuickG_integration_settings_t settings;
+  return (
+    (NeQuickG.get_integration_preset(preset, &settings) == NEQUICK_OK) &&
+    (NeQuickG.set_integration_settings(nequick, &settings) == NEQUICK_OK) &&
+    get_benchmark_STEC(nequick, pTEC) &&
+    (NeQuickG.get_evaluation_count(nequick, pEvaluation_count) == NEQUICK_OK));
+}
+
+// vertical ray above the receiver of the first link of benchmarkMid,
+// the time and the solar activity are the ones of get_benchmark_STEC
+static bool get_vertical_TEC(
+  NeQuickG_handle nequick,
+  const NeQuickG_integration_settings_t* const pSettings,
+  double_t* const pTEC,
+  size_t* const pEvaluation_count) {
+  return (
+    (NeQuickG.set_integration_settings(nequick, pSettings) == NEQUICK_OK) &&
+    (NeQuickG.get_vertical_total_electron_content(
+       nequick, 40.19, -3.00, 0.0, 20000000.0, pTEC) == NEQUICK_OK) &&
+    (NeQuickG.get_evaluation_count(nequick, pEvaluation_count) == NEQUICK_OK));
+}
+
+static bool is_same_integration_settings(
+  const NeQuickG_integration_settings_t* const pSettings_1,
+  const NeQuickG_integration_settings_t* const pSettings_2) {
+  return (
+    (pSettings_1->method == pSettings_2->method) &&
+    THRESHOLD_COMPARE(
+      pSettings_1->first_point_height_km,
+      pSettings_2->first_point_height_km,
+      DBL_EPSILON) &&
+    THRESHOLD_COMPARE(
+      pSettings_1->second_point_height_km,
+      pSettings_2->second_point_height_km,
+      DBL_EPSILON) &&
+    THRESHOLD_COMPARE(
+      pSettings_1->tolerance_below_first_point,
+      pSettings_2->tolerance_below_first_point,
+      DBL_EPSILON) &&
+    THRESHOLD_COMPARE(
+      pSettings_1->tolerance_above_first_point,
+      pSettings_2->tolerance_above_first_point,
+      DBL_EPSILON) &&
+    (pSettings_1->recursion_max == pSettings_2->recursion_max) &&
+    (pSettings_1->split_at_layer_peaks == pSettings_2->split_at_layer_peaks) &&
+    (pSettings_1->semi_analytic_vertical ==
+     pSettings_2->semi_analytic_vertical) &&
+    (pSettings_1->evaluation_max == pSettings_2->evaluation_max) &&
+    (pSettings_1->profile_anchor_count ==
+     pSettings_2->profile_anchor_count));
+}
+
+// a new handle uses the specification preset, the navigation preset needs
+// fewer evaluations and the reference preset more, bad settings are refused
+static bool test_integration_settings(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  NeQuickG_integration_settings_t specification;
+  NeQuickG_integration_settings_t settings;
+  if ((NeQuickG.get_integration_preset(
+         NEQUICKG_INTEGRATION_PRESET_SPECIFICATION,
+         &specification) != NEQUICK_OK) ||
+      (NeQuickG.get_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+      !is_same_integration_settings(&settings, &specification)) {
+    LOG_ERROR("the default integration settings must be the specification preset.");
     ret = false;
   }
 
-  if (!test_bad_coefficients(pModip_file, pCCIR_folder)) {
+  double_t TEC_default;
+  double_t TEC_specification;
+  double_t TEC_navigation;
+  double_t TEC_reference;
+  size_t evaluation_count_specification;
+  size_t evaluation_count_navigation;
+  size_t evaluation_count_reference;
+  if (!get_benchmark_STEC(nequick, &TEC_default) ||
+      !get_preset_STEC(
+        nequick,
+        NEQUICKG_INTEGRATION_PRESET_SPECIFICATION,
+        &TEC_specification,
+        &evaluation_count_specification) ||
+      !get_preset_STEC(
+        nequick,
+        NEQUICKG_INTEGRATION_PRESET_NAVIGATION,
+        &TEC_navigation,
+        &evaluation_count_navigation) ||
+      !get_preset_STEC(
+        nequick,
+        NEQUICKG_INTEGRATION_PRESET_REFERENCE,
+        &TEC_reference,
+        &evaluation_count_reference)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  if (!THRESHOLD_COMPARE(TEC_specification, TEC_default, DBL_EPSILON)) {
+    LOG_ERROR("the specification preset STEC is not the default one.");
     ret = false;
   }
 
-  if (!test_receiver_satellite_same_position(pModip_file, pCCIR_folder)) {
+  if (!(evaluation_count_navigation < evaluation_count_specification) ||
+      !(evaluation_count_reference > evaluation_count_specification)) {
+    LOG_ERROR("integration preset evaluation count is not the expected.");
     ret = false;
   }
 
-  if (!test_bad_ray(pModip_file, pCCIR_folder)) {
+  if (!THRESHOLD_COMPARE(
+        TEC_specification,
+        TEC_reference,
+        NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC_reference) ||
+      !THRESHOLD_COMPARE(
+        TEC_navigation,
+        TEC_reference,
+        NEQUICK_G_JRC_API_TEST_NAVIGATION_RELATIVE_EPSILON*TEC_reference)) {
+    LOG_ERROR("integration preset STEC is not the expected.");
+    ret = false;
+  }
+
+  // the semi-analytic vertical integral needs fewer evaluations
+  // for about the same VTEC
+  {
+    NeQuickG_integration_settings_t reference;
+    double_t VTEC_specification;
+    double_t VTEC_semi_analytic;
+    double_t VTEC_reference;
+    size_t vertical_evaluation_count_specification;
+    size_t vertical_evaluation_count_reference;
+    size_t vertical_evaluation_count_semi_analytic;
+    settings = specification;
+    settings.semi_analytic_vertical = true;
+    if ((NeQuickG.get_integration_preset(
+           NEQUICKG_INTEGRATION_PRESET_REFERENCE,
+           &reference) != NEQUICK_OK) ||
+        !get_vertical_TEC(
+          nequick,
+          &specification,
+          &VTEC_specification,
+          &vertical_evaluation_count_specification) ||
+        !get_vertical_TEC(
+          nequick,
+          &reference,
+          &VTEC_reference,
+          &vertical_evaluation_count_reference) ||
+        !get_vertical_TEC(
+          nequick,
+          &settings,
+          &VTEC_semi_analytic,
+          &vertical_evaluation_count_semi_analytic) ||
+        !(vertical_evaluation_count_semi_analytic <
+          vertical_evaluation_count_specification) ||
+        !THRESHOLD_COMPARE(
+          VTEC_semi_analytic,
+          VTEC_reference,
+          NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*VTEC_reference)) {
+      LOG_ERROR("semi-analytic vertical integration is not the expected.");
+      ret = false;
+    }
+  }
+
+  // splitting at the layer peaks needs fewer evaluations
+  // for about the same STEC
+  {
+    double_t TEC_peaks;
+    size_t evaluation_count_peaks;
+    settings = specification;
+    settings.split_at_layer_peaks = true;
+    if ((NeQuickG.set_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+        !get_benchmark_STEC(nequick, &TEC_peaks) ||
+        (NeQuickG.get_evaluation_count(
+           nequick, &evaluation_count_peaks) != NEQUICK_OK) ||
+        !(evaluation_count_peaks < evaluation_count_specification) ||
+        !THRESHOLD_COMPARE(
+          TEC_peaks,
+          TEC_reference,
+          NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC_reference)) {
+      LOG_ERROR("layer peak split integration is not the expected.");
+      ret = false;
+    }
+  }
+
+  // the breakpoints are not ordered, the last settings are kept
+  settings = specification;
+  settings.second_point_height_km = settings.first_point_height_km;
+  if (NeQuickG.set_integration_settings(nequick, &settings) == NEQUICK_OK) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS)) {
+      ret = false;
+    }
+  }
+  // deeper than the recursion limit
+  settings = specification;
+  settings.recursion_max = NEQUICK_G_JRC_RECURSION_LIMIT_MAX + 1;
+  if (NeQuickG.set_integration_settings(nequick, &settings) == NEQUICK_OK) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS)) {
+      ret = false;
+    }
+  }
+  if ((NeQuickG.get_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+      !settings.split_at_layer_peaks) {
+    LOG_ERROR("bad integration settings must not be applied.");
+    ret = false;
+  }
+
+  if (NeQuickG.get_integration_preset(UINT8_MAX, &settings) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  if ((NeQuickG.reset(nequick) != NEQUICK_OK) ||
+      (NeQuickG.get_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+      !is_same_integration_settings(&settings, &specification)) {
+    LOG_ERROR("reset must set the specification preset back.");
     ret = false;
   }
 
+  NeQuickG.close(nequick);
   return ret;
 }
-#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
-  #pragma GCC diagnostic pop
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_link_mesh(pModip_file, pCCIR_directory) \
+  test_link_mesh()
+#endif
+
+/** Epochs of the satellite arc of #test_link_mesh */
+#define NEQUICK_G_JRC_API_TEST_ARC_EPOCH_COUNT (20)
+
+/** STEC of the first link of benchmarkMid, with the satellite moved along
+ * its arc (about 0.25 degrees every 30 s)
+ */
+static bool get_arc_STEC(
+  NeQuickG_handle nequick,
+  const int32_t link_id,
+  const size_t epoch,
+  double_t* const pTEC,
+  size_t* const pEvaluation_count) {
+
+  if (!set_benchmark_link(nequick)) {
+    return false;
+  }
+
+  double_t arc_degree = 0.25*(double_t)epoch;
+  if (NeQuickG.set_satellite_position(
+      nequick, 76.65 - arc_degree, -41.43 + arc_degree,
+      20157673.93) != NEQUICK_OK) {
+    return false;
+  }
+
+  int32_t ret = (link_id < 0) ?
+    NeQuickG.get_total_electron_content(nequick, pTEC) :
+    NeQuickG.get_total_electron_content_link(
+      nequick, (uint32_t)link_id, pTEC);
+
+  return (
+    (ret == NEQUICK_OK) &&
+    (NeQuickG.get_evaluation_count(nequick, pEvaluation_count) == NEQUICK_OK));
+}
+
+// the epochs of a link start from the mesh of the previous one:
+// fewer evaluations for the same STEC within the tolerance,
+// the first epoch and a jump of the geometry start from scratch
+static bool test_link_mesh(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  size_t evaluation_count_cold = 0;
+  size_t evaluation_count_warm = 0;
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_API_TEST_ARC_EPOCH_COUNT; i++) {
+    double_t TEC_cold;
+    double_t TEC_warm;
+    size_t evaluation_count;
+    if (!get_arc_STEC(nequick, -1, i, &TEC_cold, &evaluation_count)) {
+      ret = false;
+      break;
+    }
+    evaluation_count_cold += evaluation_count;
+
+    if (!get_arc_STEC(nequick, 7, i, &TEC_warm, &evaluation_count)) {
+      ret = false;
+      break;
+    }
+    evaluation_count_warm += evaluation_count;
+
+    // the first epoch has no mesh yet
+    double_t threshold = (i == 0) ?
+      DBL_EPSILON :
+      NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC_cold;
+    if (!THRESHOLD_COMPARE(TEC_warm, TEC_cold, threshold)) {
+      LOG_ERROR("link STEC is not the expected.");
+      ret = false;
+    }
+  }
+
+  if (!(evaluation_count_warm < evaluation_count_cold)) {
+    LOG_ERROR("link evaluation count is not the expected.");
+    ret = false;
+  }
+
+  // the link ID is reused for a satellite at the zenith of the receiver
+  {
+    double_t TEC_cold;
+    double_t TEC_warm;
+    if ((NeQuickG.set_satellite_position(
+           nequick, 40.19, -3.00, 20157673.93) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+           nequick, &TEC_cold) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content_link(
+           nequick, 7, &TEC_warm) != NEQUICK_OK) ||
+        !THRESHOLD_COMPARE(TEC_warm, TEC_cold, DBL_EPSILON)) {
+      LOG_ERROR("link geometry jump must start from scratch.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_evaluation_budget(pModip_file, pCCIR_directory) \
+  test_evaluation_budget()
 #endif
+
+/** Evaluation budget of #test_evaluation_budget,
+ * below the evaluations of the benchmark link with every method
+ */
+#define NEQUICK_G_JRC_API_TEST_EVALUATION_BUDGET (120)
+
+// the evaluation budget is never exceeded, the result stays close
+// to the one without budget and the statistics count the hits
+static bool test_evaluation_budget(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  NeQuickG_integration_settings_t settings;
+  if (NeQuickG.get_integration_preset(
+        NEQUICKG_INTEGRATION_PRESET_SPECIFICATION,
+        &settings) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  settings.evaluation_max = NEQUICKG_INTEGRATION_EVALUATION_BUDGET_MIN - 1;
+  if (NeQuickG.set_integration_settings(nequick, &settings) == NEQUICK_OK) {
+    LOG_ERROR("evaluation budget below the minimum must be refused.");
+    ret = false;
+  }
+
+  const uint8_t method[] = {
+    NEQUICKG_INTEGRATION_RECURSIVE,
+    NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE,
+    NEQUICKG_INTEGRATION_PATTERSON
+  };
+  const size_t method_count = sizeof(method)/sizeof(method[0]);
+
+  for (size_t i = 0; i < method_count; i++) {
+    settings.method = method[i];
+
+    double_t TEC;
+    NeQuickG_integration_status_t status;
+    settings.evaluation_max = 0;
+    if ((NeQuickG.set_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+        !get_benchmark_STEC(nequick, &TEC) ||
+        (NeQuickG.get_integration_status(nequick, &status) != NEQUICK_OK)) {
+      ret = false;
+      break;
+    }
+    if (status.is_budget_exhausted ||
+        !(status.evaluation_count > NEQUICK_G_JRC_API_TEST_EVALUATION_BUDGET)) {
+      LOG_ERROR("integration status without budget is not the expected.");
+      ret = false;
+    }
+
+    double_t TEC_budget;
+    NeQuickG_integration_status_t status_budget;
+    settings.evaluation_max = NEQUICK_G_JRC_API_TEST_EVALUATION_BUDGET;
+    if ((NeQuickG.set_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+        !get_benchmark_STEC(nequick, &TEC_budget) ||
+        (NeQuickG.get_integration_status(
+           nequick, &status_budget) != NEQUICK_OK)) {
+      ret = false;
+      break;
+    }
+    double_t threshold =
+      NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC;
+    if (!status_budget.is_budget_exhausted ||
+        (status_budget.evaluation_count >
+         NEQUICK_G_JRC_API_TEST_EVALUATION_BUDGET) ||
+        !(status_budget.error_estimate_TECU > status.error_estimate_TECU) ||
+        !THRESHOLD_COMPARE(TEC_budget, TEC, threshold)) {
+      LOG_ERROR("integration status with budget is not the expected.");
+      ret = false;
+    }
+  }
+
+  NeQuickG_integration_statistics_t statistics;
+  if ((NeQuickG.get_integration_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.integration_count != (2 * method_count)) ||
+      (statistics.budget_exhausted_count != method_count) ||
+      !(statistics.evaluation_count_max >
+        NEQUICK_G_JRC_API_TEST_EVALUATION_BUDGET) ||
+      !(statistics.evaluation_count > statistics.evaluation_count_max)) {
+    LOG_ERROR("integration statistics are not the expected.");
+    ret = false;
+  }
+
+  if ((NeQuickG.reset(nequick) != NEQUICK_OK) ||
+      (NeQuickG.get_integration_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.integration_count != 0)) {
+    LOG_ERROR("reset must clear the integration statistics.");
+    ret = false;
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_TEC_gradient(pModip_file, pCCIR_directory) \
+  test_TEC_gradient()
+#endif
+
+/** STEC of the first link of benchmarkMid with the receiver moved
+ * and the solar activity coefficients changed
+ */
+static bool get_moved_STEC(
+  NeQuickG_handle nequick,
+  const double_t* const pReceiver_step,
+  const double_t Az_coefficient_step,
+  double_t* const pTEC) {
+
+  double_t az[NEQUICKG_AZ_COEFFICIENTS_COUNT] =
+    {121.129893 + Az_coefficient_step, 0.351254133, 0.0134635348};
+
+  return (
+    set_benchmark_link(nequick) &&
+    (NeQuickG.set_solar_activity_coefficients(
+       nequick, az, (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT) == NEQUICK_OK) &&
+    (NeQuickG.set_receiver_position(
+       nequick,
+       40.19 + pReceiver_step[1],
+       -3.00 + pReceiver_step[0],
+       -23.32 + pReceiver_step[2]) == NEQUICK_OK) &&
+    (NeQuickG.get_total_electron_content(nequick, pTEC) == NEQUICK_OK));
+}
+
+// the gradient matches the central differences of the STEC
+// with wide steps and the reference preset, for about twice the cost
+// of an integration, counted as a single integration
+static bool test_TEC_gradient(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  NeQuickG_integration_settings_t settings;
+  double_t TEC;
+  size_t evaluation_count;
+  if ((NeQuickG.get_integration_preset(
+         NEQUICKG_INTEGRATION_PRESET_REFERENCE, &settings) != NEQUICK_OK) ||
+      (NeQuickG.set_integration_settings(nequick, &settings) != NEQUICK_OK) ||
+      !get_benchmark_STEC(nequick, &TEC) ||
+      (NeQuickG.get_evaluation_count(nequick, &evaluation_count) != NEQUICK_OK)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  double_t TEC_gradient;
+  NeQuickG_TEC_gradient_t gradient;
+  size_t evaluation_count_gradient;
+  NeQuickG_integration_statistics_t statistics;
+  NeQuickG_integration_statistics_t statistics_gradient;
+  if ((NeQuickG.get_integration_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (NeQuickG.get_total_electron_content_gradient(
+         nequick, &TEC_gradient, &gradient) != NEQUICK_OK) ||
+      (NeQuickG.get_evaluation_count(
+         nequick, &evaluation_count_gradient) != NEQUICK_OK) ||
+      (NeQuickG.get_integration_statistics(
+         nequick, &statistics_gradient) != NEQUICK_OK)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  if (!THRESHOLD_COMPARE(TEC_gradient, TEC, DBL_EPSILON)) {
+    LOG_ERROR("gradient STEC is not the expected.");
+    ret = false;
+  }
+
+  // the final sub-intervals once more, and the start of the path
+  if (!(evaluation_count_gradient <= ((2*evaluation_count) + 1))) {
+    LOG_ERROR("gradient evaluation count is not the expected.");
+    ret = false;
+  }
+
+  if (statistics_gradient.integration_count !=
+      (statistics.integration_count + 1)) {
+    LOG_ERROR("gradient integration count is not the expected.");
+    ret = false;
+  }
+
+  // latitude and longitude in degrees, height in meters
+  const double_t receiver_step[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT] =
+    {0.05, 0.05, 100.0};
+  for (size_t i = 0; i < NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT; i++) {
+    double_t step_plus[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT] =
+      {0.0, 0.0, 0.0};
+    double_t step_minus[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT] =
+      {0.0, 0.0, 0.0};
+    step_plus[i] = receiver_step[i];
+    step_minus[i] = -receiver_step[i];
+
+    double_t TEC_plus;
+    double_t TEC_minus;
+    if (!get_moved_STEC(nequick, step_plus, 0.0, &TEC_plus) ||
+        !get_moved_STEC(nequick, step_minus, 0.0, &TEC_minus)) {
+      ret = false;
+      break;
+    }
+    double_t derivative = (TEC_plus - TEC_minus) / (2.0*receiver_step[i]);
+    double_t threshold =
+      NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*fabs(derivative);
+    if (!THRESHOLD_COMPARE(gradient.receiver[i], derivative, threshold)) {
+      LOG_ERROR("gradient receiver derivative is not the expected.");
+      ret = false;
+    }
+  }
+
+  {
+    const double_t no_step[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT] =
+      {0.0, 0.0, 0.0};
+    double_t TEC_plus;
+    double_t TEC_minus;
+    if (!get_moved_STEC(nequick, no_step, 1.0, &TEC_plus) ||
+        !get_moved_STEC(nequick, no_step, -1.0, &TEC_minus)) {
+      ret = false;
+    } else {
+      double_t derivative = (TEC_plus - TEC_minus) / 2.0;
+      double_t threshold =
+        NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*fabs(derivative);
+      if (!THRESHOLD_COMPARE(
+            gradient.Az_coefficients[0], derivative, threshold)) {
+        LOG_ERROR("gradient Az coefficient derivative is not the expected.");
+        ret = false;
+      }
+    }
+  }
+
+  // Az = ai0 + ai1*MODIP + ai2*MODIP^2
+  double_t modip_degree = NeQuickG.get_modip(nequick);
+  double_t threshold =
+    NEQUICK_G_JRC_API_TEST_STEC_EPSILON*fabs(gradient.Az_coefficients[2]);
+  if (!THRESHOLD_COMPARE(
+        gradient.Az_coefficients[2],
+        gradient.Az_coefficients[0]*modip_degree*modip_degree,
+        threshold)) {
+    LOG_ERROR("gradient Az coefficient derivatives are not the expected.");
+    ret = false;
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_TEC_partial(pModip_file, pCCIR_directory) \
+  test_TEC_partial()
+#endif
+
+/** Shell boundaries of #test_TEC_partial (m): the integration breakpoints */
+#define NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT (2)
+/** Points of the cumulative profile of #test_TEC_partial */
+#define NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT (6)
+
+// the shells add up to the STEC, with the shell boundaries at the
+// breakpoints it is the same, the cumulative profile goes from 0 at the
+// receiver to the STEC beyond the satellite
+static bool test_TEC_partial(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC;
+  if (!get_benchmark_STEC(nequick, &TEC)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  const double_t shell_boundary_height_meters[
+    NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT] = {1000.0e3, 2000.0e3};
+  double_t shell_TEC[NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT + 1];
+
+  NeQuickG_TEC_partial_t partial = {
+    .shell_boundary_count = NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT,
+    .pShell_boundary_height_meters = shell_boundary_height_meters,
+    .pShell_TEC = shell_TEC,
+    .cumulative_point_count = 0,
+    .pCumulative_distance_meters = NULL,
+    .pCumulative_TEC = NULL
+  };
+
+  double_t TEC_partial;
+  if (NeQuickG.get_total_electron_content_partial(
+        nequick, &partial, &TEC_partial) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  if (!THRESHOLD_COMPARE(TEC_partial, TEC, DBL_EPSILON)) {
+    LOG_ERROR("partial STEC is not the expected.");
+    ret = false;
+  }
+
+  double_t shell_TEC_sum = 0.0;
+  for (size_t i = 0; i <= NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT; i++) {
+    if (!(shell_TEC[i] > 0.0)) {
+      LOG_ERROR("shell STEC is not the expected.");
+      ret = false;
+    }
+    shell_TEC_sum += shell_TEC[i];
+  }
+  if (!THRESHOLD_COMPARE(
+        shell_TEC_sum, TEC, NEQUICK_G_JRC_API_TEST_STEC_EPSILON)) {
+    LOG_ERROR("shell STECs do not add up to the STEC.");
+    ret = false;
+  }
+
+  // along the ray up to beyond the satellite, the path is split at the
+  // layer peaks too
+  NeQuickG_integration_settings_t settings;
+  if ((NeQuickG.get_integration_preset(
+         NEQUICKG_INTEGRATION_PRESET_NAVIGATION, &settings) != NEQUICK_OK) ||
+      (NeQuickG.set_integration_settings(nequick, &settings) != NEQUICK_OK)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  const double_t cumulative_distance_meters[
+    NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT] =
+      {0.0, 250.0e3, 500.0e3, 1000.0e3, 5000.0e3, 30000.0e3};
+  double_t cumulative_TEC[NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT];
+  partial.cumulative_point_count = NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT;
+  partial.pCumulative_distance_meters = cumulative_distance_meters;
+  partial.pCumulative_TEC = cumulative_TEC;
+
+  if (NeQuickG.get_total_electron_content_partial(
+        nequick, &partial, &TEC_partial) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  double_t threshold =
+    NEQUICK_G_JRC_API_TEST_NAVIGATION_RELATIVE_EPSILON*TEC;
+  if (!THRESHOLD_COMPARE(TEC_partial, TEC, threshold)) {
+    LOG_ERROR("partial STEC is not the expected.");
+    ret = false;
+  }
+
+  // the receiver is below the ground, where the integration starts
+  if (!THRESHOLD_COMPARE(cumulative_TEC[0], 0.0, DBL_EPSILON)) {
+    LOG_ERROR("cumulative STEC at the receiver is not the expected.");
+    ret = false;
+  }
+  for (size_t i = 1; i < NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT; i++) {
+    if (!(cumulative_TEC[i] > cumulative_TEC[i - 1])) {
+      LOG_ERROR("cumulative STEC is not increasing.");
+      ret = false;
+    }
+  }
+  if (!THRESHOLD_COMPARE(
+        cumulative_TEC[NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT - 1],
+        TEC_partial,
+        NEQUICK_G_JRC_API_TEST_STEC_EPSILON)) {
+    LOG_ERROR("cumulative STEC beyond the satellite is not the expected.");
+    ret = false;
+  }
+
+  // the shell boundaries are not in ascending order
+  const double_t bad_shell_boundary_height_meters[
+    NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT] = {2000.0e3, 1000.0e3};
+  partial.pShell_boundary_height_meters = bad_shell_boundary_height_meters;
+  if (NeQuickG.get_total_electron_content_partial(
+        nequick, &partial, &TEC_partial) == NEQUICK_OK) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_TEC_PARTIAL)) {
+      LOG_ERROR("bad shell boundaries must be rejected.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_profile_cache(pModip_file, pCCIR_directory) \
+  test_profile_cache()
+#endif
+
+/** Cell size of #test_profile_cache (degrees), about 1 km */
+#define NEQUICK_G_JRC_API_TEST_PROFILE_CACHE_QUANTUM_DEGREE (0.01)
+
+// with exact positions the STEC is the same and a link queried again hits
+// the cache, with a grid the STEC is close and the nodes share corners
+static bool test_profile_cache(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC;
+  if (!get_benchmark_STEC(nequick, &TEC)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  NeQuickG_profile_cache_statistics_t statistics;
+
+  if (NeQuickG.set_profile_cache(
+        nequick,
+        true,
+        0.0,
+        NEQUICKG_PROFILE_CACHE_SET_COUNT_DEFAULT) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  for (size_t i = 0; i < 2; i++) {
+    double_t TEC_cache;
+    if (NeQuickG.get_total_electron_content(
+          nequick, &TEC_cache) != NEQUICK_OK) {
+      NeQuickG.close(nequick);
+      return false;
+    }
+    if (!THRESHOLD_COMPARE(TEC_cache, TEC, DBL_EPSILON)) {
+      LOG_ERROR("STEC with the exact profile cache is not the expected.");
+      ret = false;
+    }
+  }
+
+  if ((NeQuickG.get_profile_cache_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.hit_count == 0) ||
+      (statistics.miss_count == 0)) {
+    LOG_ERROR("exact profile cache statistics are not the expected.");
+    ret = false;
+  }
+
+  if (NeQuickG.set_profile_cache(
+        nequick,
+        true,
+        NEQUICK_G_JRC_API_TEST_PROFILE_CACHE_QUANTUM_DEGREE,
+        NEQUICKG_PROFILE_CACHE_SET_COUNT_DEFAULT) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  {
+    double_t TEC_cache;
+    if (NeQuickG.get_total_electron_content(
+          nequick, &TEC_cache) != NEQUICK_OK) {
+      NeQuickG.close(nequick);
+      return false;
+    }
+    double_t threshold =
+      NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC;
+    if (!THRESHOLD_COMPARE(TEC_cache, TEC, threshold)) {
+      LOG_ERROR("STEC with the profile cache grid is not the expected.");
+      ret = false;
+    }
+  }
+
+  if ((NeQuickG.get_profile_cache_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.hit_count == 0)) {
+    LOG_ERROR("profile cache grid statistics are not the expected.");
+    ret = false;
+  }
+
+  // the cell size is out of range
+  if (NeQuickG.set_profile_cache(
+        nequick,
+        true,
+        2.0*NEQUICKG_PROFILE_CACHE_QUANTUM_MAX_DEGREE,
+        NEQUICKG_PROFILE_CACHE_SET_COUNT_DEFAULT) == NEQUICK_OK) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_PROFILE_CACHE)) {
+      LOG_ERROR("bad profile cache quantum must be rejected.");
+      ret = false;
+    }
+  }
+
+  // the set count is out of range, the cache in use is kept
+  if ((NeQuickG.set_profile_cache(nequick, true, 0.0, 0) == NEQUICK_OK) ||
+      (NeQuickG.set_profile_cache(
+         nequick,
+         true,
+         0.0,
+         NEQUICKG_PROFILE_CACHE_SET_COUNT_MAX + 1) == NEQUICK_OK)) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_PROFILE_CACHE)) {
+      LOG_ERROR("bad profile cache set count must be rejected.");
+      ret = false;
+    }
+  }
+
+  // reset empties the cache, it is still enabled
+  if ((NeQuickG.reset(nequick) != NEQUICK_OK) ||
+      (NeQuickG.get_profile_cache_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.hit_count != 0) ||
+      (statistics.miss_count != 0) ||
+      !get_benchmark_STEC(nequick, &TEC) ||
+      (NeQuickG.get_profile_cache_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.miss_count == 0)) {
+    LOG_ERROR("reset must empty the profile cache and keep it enabled.");
+    ret = false;
+  }
+
+  // disabling frees the cache, the set count does not matter
+  if (NeQuickG.set_profile_cache(nequick, false, 0.0, 0) != NEQUICK_OK) {
+    LOG_ERROR("profile cache must be disabled.");
+    ret = false;
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_profile_anchors(pModip_file, pCCIR_directory) \
+  test_profile_anchors()
+#endif
+
+/** Number of anchors of #test_profile_anchors */
+#define NEQUICK_G_JRC_API_TEST_PROFILE_ANCHOR_COUNT (16)
+
+// the layer peaks interpolated between the anchors give a STEC close to
+// the exact profile, too few anchors are rejected
+static bool test_profile_anchors(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC;
+  if (!get_benchmark_STEC(nequick, &TEC)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  NeQuickG_integration_settings_t settings;
+  if (NeQuickG.get_integration_settings(nequick, &settings) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  settings.profile_anchor_count = NEQUICK_G_JRC_API_TEST_PROFILE_ANCHOR_COUNT;
+  if (NeQuickG.set_integration_settings(nequick, &settings) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  {
+    double_t TEC_anchors;
+    if (NeQuickG.get_total_electron_content(
+          nequick, &TEC_anchors) != NEQUICK_OK) {
+      NeQuickG.close(nequick);
+      return false;
+    }
+    double_t threshold =
+      NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON*TEC;
+    if (!THRESHOLD_COMPARE(TEC_anchors, TEC, threshold)) {
+      LOG_ERROR("STEC with the profile anchors is not the expected.");
+      ret = false;
+    }
+  }
+
+  settings.profile_anchor_count =
+    NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN - 1;
+  if (NeQuickG.set_integration_settings(nequick, &settings) == NEQUICK_OK) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS)) {
+      LOG_ERROR("bad profile anchor count must be rejected.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define test_fourier_cache(pModip_file, pCCIR_directory) \
+  test_fourier_cache()
+#endif
+
+/** Number of epochs of #test_fourier_cache */
+#define NEQUICK_G_JRC_API_TEST_FOURIER_CACHE_EPOCH_COUNT (3)
+
+// epochs interleaved with the Fourier coefficient cache give the same STEC
+// as without it, too many entries are rejected
+static bool test_fourier_cache(
+  const char* const pModip_file,
+  const char* const pCCIR_directory) {
+
+  const size_t epoch_count = NEQUICK_G_JRC_API_TEST_FOURIER_CACHE_EPOCH_COUNT;
+  const uint8_t month[NEQUICK_G_JRC_API_TEST_FOURIER_CACHE_EPOCH_COUNT] =
+    {4, 4, 7};
+  const double_t UTC[NEQUICK_G_JRC_API_TEST_FOURIER_CACHE_EPOCH_COUNT] =
+    {0.0, 12.0, 6.0};
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_directory, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  if (!set_benchmark_link(nequick)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  double_t TEC[NEQUICK_G_JRC_API_TEST_FOURIER_CACHE_EPOCH_COUNT];
+  for (size_t i = 0; i < epoch_count; i++) {
+    if ((NeQuickG.set_time(nequick, month[i], UTC[i]) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+           nequick, &TEC[i]) != NEQUICK_OK)) {
+      NeQuickG.close(nequick);
+      return false;
+    }
+  }
+
+  if (NeQuickG.set_fourier_cache(nequick, epoch_count) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  bool ret = true;
+
+  for (size_t j = 0; j < 2; j++) {
+    for (size_t i = 0; i < epoch_count; i++) {
+      double_t TEC_cache;
+      if ((NeQuickG.set_time(nequick, month[i], UTC[i]) != NEQUICK_OK) ||
+          (NeQuickG.get_total_electron_content(
+             nequick, &TEC_cache) != NEQUICK_OK)) {
+        NeQuickG.close(nequick);
+        return false;
+      }
+      if (!THRESHOLD_COMPARE(TEC_cache, TEC[i], DBL_EPSILON)) {
+        LOG_ERROR("STEC with the Fourier cache is not the expected.");
+        ret = false;
+      }
+    }
+  }
+
+  // each epoch is computed once, then found
+  NeQuickG_fourier_cache_statistics_t statistics;
+  if ((NeQuickG.get_fourier_cache_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.hit_count != epoch_count) ||
+      (statistics.miss_count != epoch_count) ||
+      (statistics.eviction_count != 0)) {
+    LOG_ERROR("Fourier cache statistics are not the expected.");
+    ret = false;
+  }
+
+  // reset empties the cache, its entries are kept
+  if ((NeQuickG.reset(nequick) != NEQUICK_OK) ||
+      !set_benchmark_link(nequick)) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+  for (size_t i = 0; i < epoch_count; i++) {
+    double_t TEC_cache;
+    if ((NeQuickG.set_time(nequick, month[i], UTC[i]) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+           nequick, &TEC_cache) != NEQUICK_OK)) {
+      NeQuickG.close(nequick);
+      return false;
+    }
+  }
+  if ((NeQuickG.get_fourier_cache_statistics(
+         nequick, &statistics) != NEQUICK_OK) ||
+      (statistics.hit_count != 0) ||
+      (statistics.miss_count != epoch_count)) {
+    LOG_ERROR("reset must empty the Fourier cache and keep its entries.");
+    ret = false;
+  }
+
+  // too many entries
+  if (NeQuickG.set_fourier_cache(
+        nequick,
+        NEQUICKG_FOURIER_CACHE_ENTRY_COUNT_MAX + 1) == NEQUICK_OK) {
+    ret = false;
+  }
+  {
+    int32_t error_code;
+    if ((NeQuickG.get_last_error(&error_code) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_FOURIER_CACHE)) {
+      LOG_ERROR("bad Fourier cache size must be rejected.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmissing-prototypes"
+#endif
+bool NeQuickG_API_test(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+  bool ret = true;
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  if (!test_NULL_modip_file(pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_NULL_CCIR_dir(pModip_file)) {
+    ret = false;
+  }
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+
+  if (!test_bad_month(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_bad_UTC(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_bad_latitude(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_bad_coefficients(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_receiver_satellite_same_position(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_bad_ray(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_shared_model(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_preloaded_model(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_integration_method(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_integration_settings(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_link_mesh(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_evaluation_budget(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_TEC_gradient(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_TEC_partial(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_profile_cache(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_profile_anchors(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  if (!test_fourier_cache(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+
+  return ret;
+}
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic pop
+#endif
+
+#undef NEQUICK_G_JRC_API_TEST_EVALUATION_BUDGET
+#undef NEQUICK_G_JRC_API_TEST_PROFILE_CACHE_QUANTUM_DEGREE
+#undef NEQUICK_G_JRC_API_TEST_PROFILE_ANCHOR_COUNT
+#undef NEQUICK_G_JRC_API_TEST_FOURIER_CACHE_EPOCH_COUNT
+#undef NEQUICK_G_JRC_API_TEST_PRELOADED_EPOCH_COUNT
+#undef NEQUICK_G_JRC_API_TEST_SHELL_BOUNDARY_COUNT
+#undef NEQUICK_G_JRC_API_TEST_CUMULATIVE_POINT_COUNT
+#undef NEQUICK_G_JRC_API_TEST_ARC_EPOCH_COUNT
+#undef NEQUICK_G_JRC_API_TEST_NAVIGATION_RELATIVE_EPSILON
+#undef NEQUICK_G_JRC_API_TEST_INTEGRATION_RELATIVE_EPSILON
+#undef NEQUICK_G_JRC_API_TEST_STEC_EPSILON
+#undef NEQUICK_G_JRC_API_TEST_BENCHMARK_MID_STEC
@@ -81,9 +81,11 @@ static bool NeQuickG_modip_test_new(void) {
 
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
   char modip_grid_file[] = "./../../modip/modip2001_wrapped.asc";
-  if (modip_init(&context, modip_grid_file) != NEQUICK_OK) {
+  modip_grid_t grid;
+  if (modip_grid_init(modip_grid_file, &grid) != NEQUICK_OK) {
     return false;
   }
+  modip_init(&context, &grid);
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
   for (size_t i = 0x00; i < NEQUICK_G_JRC_MODIP_TEST_VECTORS_COUNT; i++) {
@@ -13,6 +13,10 @@
 
 #include "NeQuickG_JRC_API_test.h"
 #include "NeQuickG_JRC_Az_test.h"
+#include "NeQuickG_JRC_batch_test.h"
+#if !defined(_MSC_VER)
+#include "NeQuickG_JRC_executor_test.h"
+#endif
 #include "NeQuickG_JRC_iono_E_layer_test.h"
 #include "NeQuickG_JRC_iono_F1_layer_test.h"
 #include "NeQuickG_JRC_iono_F2_layer_fourier_coefficients_test.h"
@@ -20,6 +24,9 @@
 #include "NeQuickG_JRC_iono_layer_amplitudes_test.h"
 #include "NeQuickG_JRC_iono_layer_thickness_test.h"
 #include "NeQuickG_JRC_MODIP_test.h"
+#if !defined(_MSC_VER)
+#include "NeQuickG_JRC_pool_test.h"
+#endif
 #include "NeQuickG_JRC_ray_test.h"
 #include "NeQuickG_JRC_solar_test.h"
 
@@ -66,6 +73,19 @@ bool NeQuickG_unit_test(
   if (!NeQuickG_ray_test()) {
     ret = false;
   }
+  if (!NeQuickG_batch_test(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+#if !defined(_MSC_VER)
+  if (!NeQuickG_executor_test(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+#endif
+#if !defined(_MSC_VER)
+  if (!NeQuickG_pool_test(pModip_file, pCCIR_folder)) {
+    ret = false;
+  }
+#endif
   return ret;
 }
 #if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
@@ -0,0 +1,743 @@
+/**
+ * NeQuickG batch of links Unit test
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC_UT
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_batch_test.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_coordinates.h"
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_macros.h"
+
+#define NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT (9)
+#define NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX (4)
+#define NEQUICK_G_JRC_BATCH_TEST_STEC_EPSILON (1.0e-5)
+
+// benchmarkMid solar activity coefficients
+static const double_t
+  NeQuickG_batch_test_az[NEQUICKG_AZ_COEFFICIENTS_COUNT] =
+  {121.129893, 0.351254133, 0.0134635348};
+
+// links from benchmarkMid, link 4 has a bad satellite latitude
+static const uint8_t
+  NeQuickG_batch_test_month[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {4, 4, 4, 4, 4, 4, 4, 4, 4};
+
+static const double_t
+  NeQuickG_batch_test_UTC[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {0.0, 0.0, 0.0, 4.0, 4.0, 4.0, 12.0, 16.0, 16.0};
+
+static const double_t
+  NeQuickG_batch_test_receiver_longitude[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {40.19, 40.19, 40.19, 40.19, 40.19, 40.19, 115.89, 115.89, 115.89};
+
+static const double_t
+  NeQuickG_batch_test_receiver_latitude[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {-3.00, -3.00, -3.00, -3.00, -3.00, -3.00, -31.80, -31.80, -31.80};
+
+static const double_t
+  NeQuickG_batch_test_receiver_height[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {-23.32, -23.32, -23.32, -23.32, -23.32, -23.32, 12.78, 12.78, 12.78};
+
+static const double_t
+  NeQuickG_batch_test_satellite_longitude[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {76.65, -13.11, 26.31, 79.33, 107.19, 56.35, 133.47, 124.09, 154.31};
+
+static const double_t
+  NeQuickG_batch_test_satellite_latitude[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {-41.43, -4.67, -39.04, -55.34, 100.0, 47.54, -24.87, -14.31, -45.19};
+
+static const double_t
+  NeQuickG_batch_test_satellite_height[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {20157673.93, 20194168.22, 20671871.64, 20679595.44, 19943686.06,
+   20322471.38, 19975574.41, 20100697.90, 20116286.17};
+
+static const double_t
+  NeQuickG_batch_test_STEC[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT] =
+  {18.26001, 35.83117, 17.16868, 35.98300, 0.0,
+   38.00238, 13.63080, 6.95943, 7.47918};
+
+static void get_links(NeQuickG_links_t* const pLinks) {
+  pLinks->count = NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT;
+  pLinks->pMonth = NeQuickG_batch_test_month;
+  pLinks->pUTC = NeQuickG_batch_test_UTC;
+  pLinks->pReceiver_longitude_degree = NeQuickG_batch_test_receiver_longitude;
+  pLinks->pReceiver_latitude_degree = NeQuickG_batch_test_receiver_latitude;
+  pLinks->pReceiver_height_meters = NeQuickG_batch_test_receiver_height;
+  pLinks->pSatellite_longitude_degree = NeQuickG_batch_test_satellite_longitude;
+  pLinks->pSatellite_latitude_degree = NeQuickG_batch_test_satellite_latitude;
+  pLinks->pSatellite_height_meters = NeQuickG_batch_test_satellite_height;
+}
+
+// one call per link using the single link interface
+static bool get_STEC_per_link(
+  NeQuickG_handle nequick,
+  double_t* const pTEC) {
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT; i++) {
+    pTEC[i] = 0.0;
+    if (i == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX) {
+      continue;
+    }
+    if ((NeQuickG.set_time(
+          nequick,
+          NeQuickG_batch_test_month[i],
+          NeQuickG_batch_test_UTC[i]) != NEQUICK_OK) ||
+        (NeQuickG.set_receiver_position(
+          nequick,
+          NeQuickG_batch_test_receiver_longitude[i],
+          NeQuickG_batch_test_receiver_latitude[i],
+          NeQuickG_batch_test_receiver_height[i]) != NEQUICK_OK) ||
+        (NeQuickG.set_satellite_position(
+          nequick,
+          NeQuickG_batch_test_satellite_longitude[i],
+          NeQuickG_batch_test_satellite_latitude[i],
+          NeQuickG_batch_test_satellite_height[i]) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+          nequick, &pTEC[i]) != NEQUICK_OK)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// one receiver, many satellites: links 0 to 2 plus the bad link
+static bool NeQuickG_batch_test_epoch(
+  NeQuickG_handle nequick,
+  const double_t* const pTEC_per_link) {
+
+  static const size_t link_index[] =
+    {0, 1, NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX, 2};
+  #define NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT \
+    (sizeof(link_index)/sizeof(link_index[0]))
+
+  double_t longitude[NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT];
+  double_t latitude[NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT];
+  double_t height[NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT; i++) {
+    longitude[i] = NeQuickG_batch_test_satellite_longitude[link_index[i]];
+    latitude[i] = NeQuickG_batch_test_satellite_latitude[link_index[i]];
+    height[i] = NeQuickG_batch_test_satellite_height[link_index[i]];
+  }
+
+  NeQuickG_satellites_t satellites = {
+    .count = NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT,
+    .pLongitude_degree = longitude,
+    .pLatitude_degree = latitude,
+    .pHeight_meters = height
+  };
+
+  if ((NeQuickG.set_time(
+        nequick,
+        NeQuickG_batch_test_month[0],
+        NeQuickG_batch_test_UTC[0]) != NEQUICK_OK) ||
+      (NeQuickG.set_receiver_position(
+        nequick,
+        NeQuickG_batch_test_receiver_longitude[0],
+        NeQuickG_batch_test_receiver_latitude[0],
+        NeQuickG_batch_test_receiver_height[0]) != NEQUICK_OK)) {
+    return false;
+  }
+
+  double_t TEC[NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT];
+  int32_t status[NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT];
+
+  bool ret = true;
+
+  if (NeQuickG.get_total_electron_content_epoch(
+      nequick, &satellites, TEC, status) == NEQUICK_OK) {
+    LOG_ERROR("epoch with a bad satellite must fail.");
+    ret = false;
+  }
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT; i++) {
+    size_t link = link_index[i];
+    bool is_bad_link = (link == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX);
+    if ((status[i] == NEQUICK_OK) == is_bad_link) {
+      LOG_ERROR("epoch satellite status is not the expected.");
+      ret = false;
+    }
+    if (memcmp(&TEC[i], &pTEC_per_link[link], sizeof(double_t)) != 0) {
+      LOG_ERROR("epoch STEC differs from single link STEC.");
+      ret = false;
+    }
+  }
+
+  if (NeQuickG.get_total_electron_content_epoch(
+      nequick, NULL, TEC, status) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  #undef NEQUICK_G_JRC_BATCH_TEST_SATELLITES_COUNT
+  return ret;
+}
+
+// WGS-84 geodetic to ECEF
+static void get_ECEF(
+  double_t longitude_degree,
+  double_t latitude_degree,
+  double_t height_meters,
+  double_t* const pX,
+  double_t* const pY,
+  double_t* const pZ) {
+
+  const double_t a = 6378137.0;
+  const double_t f = 1.0/298.257223563;
+  const double_t e2 = f*(2.0 - f);
+
+  angle_t longitude;
+  angle_t latitude;
+  angle_set(&longitude, longitude_degree);
+  angle_set(&latitude, latitude_degree);
+
+  double_t N = a/sqrt(1.0 - e2*latitude.sin*latitude.sin);
+  *pX = (N + height_meters)*latitude.cos*longitude.cos;
+  *pY = (N + height_meters)*latitude.cos*longitude.sin;
+  *pZ = (N*(1.0 - e2) + height_meters)*latitude.sin;
+}
+
+// the links in ECEF coordinates, the bad latitude of link 4 maps to
+// a valid ECEF position
+static bool NeQuickG_batch_test_ECEF(
+  NeQuickG_handle nequick,
+  const double_t* const pTEC_per_link) {
+
+  #define NEQUICK_G_JRC_BATCH_TEST_ECEF_DEGREE_EPSILON (1.0e-9)
+  #define NEQUICK_G_JRC_BATCH_TEST_ECEF_HEIGHT_EPSILON (1.0e-4)
+  #define NEQUICK_G_JRC_BATCH_TEST_ECEF_STEC_EPSILON (1.0e-6)
+
+  double_t receiver[3][NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  double_t satellite[3][NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT; i++) {
+    get_ECEF(
+      NeQuickG_batch_test_receiver_longitude[i],
+      NeQuickG_batch_test_receiver_latitude[i],
+      NeQuickG_batch_test_receiver_height[i],
+      &receiver[0][i], &receiver[1][i], &receiver[2][i]);
+    get_ECEF(
+      NeQuickG_batch_test_satellite_longitude[i],
+      NeQuickG_batch_test_satellite_latitude[i],
+      NeQuickG_batch_test_satellite_height[i],
+      &satellite[0][i], &satellite[1][i], &satellite[2][i]);
+  }
+
+  bool ret = true;
+
+  // round trip of the receivers
+  position_t positions[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  int32_t position_status[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  if (positions_set_from_ECEF(
+        positions, receiver[0], receiver[1], receiver[2],
+        NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT,
+        position_status) != NEQUICK_OK) {
+    LOG_ERROR("ECEF to geodetic conversion failed.");
+    ret = false;
+  }
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT; i++) {
+    if (!THRESHOLD_COMPARE(
+          positions[i].longitude_org,
+          NeQuickG_batch_test_receiver_longitude[i],
+          NEQUICK_G_JRC_BATCH_TEST_ECEF_DEGREE_EPSILON) ||
+        !THRESHOLD_COMPARE(
+          positions[i].latitude.degree,
+          NeQuickG_batch_test_receiver_latitude[i],
+          NEQUICK_G_JRC_BATCH_TEST_ECEF_DEGREE_EPSILON) ||
+        !THRESHOLD_COMPARE(
+          positions[i].height,
+          NeQuickG_batch_test_receiver_height[i],
+          NEQUICK_G_JRC_BATCH_TEST_ECEF_HEIGHT_EPSILON) ||
+        !THRESHOLD_COMPARE(
+          positions[i].latitude.sin,
+          sin(positions[i].latitude.rad),
+          NEQUICK_G_JRC_BATCH_TEST_ECEF_DEGREE_EPSILON) ||
+        !THRESHOLD_COMPARE(
+          positions[i].longitude.cos,
+          cos(positions[i].longitude.rad),
+          NEQUICK_G_JRC_BATCH_TEST_ECEF_DEGREE_EPSILON)) {
+      LOG_ERROR("ECEF to geodetic conversion is not the expected.");
+      ret = false;
+    }
+  }
+
+  {
+    const double_t origin = 0.0;
+    int32_t error_code;
+    if ((positions_set_from_ECEF(
+           positions, &origin, &origin, &origin, 1, position_status) !=
+         NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (NeQuickG.get_last_error(&error_code) != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_POSITION) ||
+        (position_status[0] != NEQUICK_ERROR_CODE_BAD_POSITION)) {
+      LOG_ERROR("ECEF position at the centre of the Earth must be rejected.");
+      ret = false;
+    }
+  }
+
+  NeQuickG_links_ECEF_t links = {
+    .count = NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT,
+    .pMonth = NeQuickG_batch_test_month,
+    .pUTC = NeQuickG_batch_test_UTC,
+    .pReceiver_x_meters = receiver[0],
+    .pReceiver_y_meters = receiver[1],
+    .pReceiver_z_meters = receiver[2],
+    .pSatellite_x_meters = satellite[0],
+    .pSatellite_y_meters = satellite[1],
+    .pSatellite_z_meters = satellite[2]
+  };
+  double_t TEC[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  int32_t status[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+
+  // the ray of the bad link may fail or not, it is ignored
+  (void)NeQuickG.get_total_electron_content_batch_ECEF(
+    nequick, &links, TEC, status);
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT; i++) {
+    if (i == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX) {
+      continue;
+    }
+    if (status[i] != NEQUICK_OK) {
+      LOG_ERROR("ECEF batch link failed.");
+      ret = false;
+    }
+    if (!THRESHOLD_COMPARE(
+          TEC[i],
+          pTEC_per_link[i],
+          NEQUICK_G_JRC_BATCH_TEST_ECEF_STEC_EPSILON)) {
+      LOG_ERROR("ECEF batch STEC differs from single link STEC.");
+      ret = false;
+    }
+  }
+
+  // the centre of the Earth, a point under the surface and a NaN
+  // only fail their own link
+  {
+    receiver[0][0] = 0.0;
+    receiver[1][0] = 0.0;
+    receiver[2][0] = 0.0;
+    receiver[0][1] *= 0.5;
+    receiver[1][1] *= 0.5;
+    receiver[2][1] *= 0.5;
+    satellite[0][2] = NAN;
+    int32_t error_code;
+    if ((NeQuickG.get_total_electron_content_batch_ECEF(
+           nequick, &links, TEC, status) != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (NeQuickG.get_last_error(&error_code) != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_POSITION)) {
+      LOG_ERROR("ECEF batch with a rejected position must fail.");
+      ret = false;
+    }
+    for (size_t i = 0; i < 3; i++) {
+      if ((status[i] != NEQUICK_ERROR_CODE_BAD_POSITION) || (TEC[i] > 0.0)) {
+        LOG_ERROR("ECEF position not above the Earth surface must be rejected.");
+        ret = false;
+      }
+    }
+    if (status[3] != NEQUICK_OK) {
+      LOG_ERROR("ECEF batch link after a rejected position failed.");
+      ret = false;
+    }
+  }
+
+  links.pSatellite_z_meters = NULL;
+  if (NeQuickG.get_total_electron_content_batch_ECEF(
+      nequick, &links, TEC, status) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  #undef NEQUICK_G_JRC_BATCH_TEST_ECEF_STEC_EPSILON
+  #undef NEQUICK_G_JRC_BATCH_TEST_ECEF_HEIGHT_EPSILON
+  #undef NEQUICK_G_JRC_BATCH_TEST_ECEF_DEGREE_EPSILON
+  return ret;
+}
+
+// group delays at the Galileo frequencies, from the single link STEC
+static bool NeQuickG_batch_test_group_delay(
+  NeQuickG_handle nequick,
+  const double_t* const pTEC_per_link) {
+
+  static const double_t frequency_Hz[] = {
+    NEQUICKG_FREQUENCY_E1_HZ,
+    NEQUICKG_FREQUENCY_E5A_HZ,
+    NEQUICKG_FREQUENCY_E5B_HZ,
+    NEQUICKG_FREQUENCY_E6_HZ};
+  #define NEQUICK_G_JRC_BATCH_TEST_FREQUENCIES_COUNT \
+    (sizeof(frequency_Hz)/sizeof(frequency_Hz[0]))
+  #define NEQUICK_G_JRC_BATCH_TEST_DELAY_EPSILON (1.0e-9)
+
+  NeQuickG_frequencies_t frequencies = {
+    .count = NEQUICK_G_JRC_BATCH_TEST_FREQUENCIES_COUNT,
+    .pFrequency_Hz = frequency_Hz
+  };
+
+  NeQuickG_links_t links;
+  get_links(&links);
+  double_t delay[
+    NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT*
+    NEQUICK_G_JRC_BATCH_TEST_FREQUENCIES_COUNT];
+  int32_t status[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+
+  bool ret = true;
+
+  if (NeQuickG.get_group_delay_batch(
+      nequick, &links, &frequencies, delay, status) == NEQUICK_OK) {
+    LOG_ERROR("group delay with a bad link must fail.");
+    ret = false;
+  }
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT; i++) {
+    bool is_bad_link = (i == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX);
+    if ((status[i] == NEQUICK_OK) == is_bad_link) {
+      LOG_ERROR("group delay link status is not the expected.");
+      ret = false;
+    }
+    for (size_t j = 0; j < NEQUICK_G_JRC_BATCH_TEST_FREQUENCIES_COUNT; j++) {
+      double_t expected_delay =
+        40.3e16*pTEC_per_link[i]/(frequency_Hz[j]*frequency_Hz[j]);
+      if (!THRESHOLD_COMPARE(
+            delay[i*NEQUICK_G_JRC_BATCH_TEST_FREQUENCIES_COUNT + j],
+            expected_delay,
+            NEQUICK_G_JRC_BATCH_TEST_DELAY_EPSILON)) {
+        LOG_ERROR("group delay is not the expected.");
+        ret = false;
+      }
+    }
+  }
+
+  // the frequencies must be positive
+  double_t bad_frequency_Hz = 0.0;
+  frequencies.count = 1;
+  frequencies.pFrequency_Hz = &bad_frequency_Hz;
+  if (NeQuickG.get_group_delay_batch(
+      nequick, &links, &frequencies, delay, status) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  if (NeQuickG.get_group_delay_batch(
+      nequick, &links, NULL, delay, status) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  #undef NEQUICK_G_JRC_BATCH_TEST_DELAY_EPSILON
+  #undef NEQUICK_G_JRC_BATCH_TEST_FREQUENCIES_COUNT
+  return ret;
+}
+
+// vertical rays above the receivers: links 0 to 2 plus the bad link
+static bool NeQuickG_batch_test_vertical(NeQuickG_handle nequick) {
+
+  static const size_t link_index[] =
+    {0, 1, NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX, 2};
+  #define NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT \
+    (sizeof(link_index)/sizeof(link_index[0]))
+  static const double_t bottom_height = 0.0;
+  static const double_t top_height = 20000000.0;
+
+  double_t longitude[NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT];
+  double_t latitude[NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT; i++) {
+    longitude[i] = NeQuickG_batch_test_receiver_longitude[link_index[i]];
+    latitude[i] = NeQuickG_batch_test_receiver_latitude[link_index[i]];
+    if (link_index[i] == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX) {
+      latitude[i] = NeQuickG_batch_test_satellite_latitude[link_index[i]];
+    }
+  }
+
+  NeQuickG_locations_t locations = {
+    .count = NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT,
+    .pLongitude_degree = longitude,
+    .pLatitude_degree = latitude
+  };
+
+  if (NeQuickG.set_time(
+        nequick,
+        NeQuickG_batch_test_month[0],
+        NeQuickG_batch_test_UTC[0]) != NEQUICK_OK) {
+    return false;
+  }
+
+  double_t TEC[NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT];
+  int32_t status[NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT];
+
+  bool ret = true;
+
+  if (NeQuickG.get_vertical_total_electron_content_batch(
+      nequick, &locations, bottom_height, top_height,
+      TEC, status) == NEQUICK_OK) {
+    LOG_ERROR("vertical batch with a bad location must fail.");
+    ret = false;
+  }
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT; i++) {
+    bool is_bad_location =
+      (link_index[i] == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX);
+    if ((status[i] == NEQUICK_OK) == is_bad_location) {
+      LOG_ERROR("vertical location status is not the expected.");
+      ret = false;
+    }
+    if (is_bad_location) {
+      continue;
+    }
+
+    // a slant link with the satellite above the receiver takes the same path
+    double_t VTEC;
+    if ((NeQuickG.set_receiver_position(
+          nequick, longitude[i], latitude[i], bottom_height) != NEQUICK_OK) ||
+        (NeQuickG.set_satellite_position(
+          nequick, longitude[i], latitude[i], top_height) != NEQUICK_OK) ||
+        (NeQuickG.get_total_electron_content(
+          nequick, &VTEC) != NEQUICK_OK)) {
+      LOG_ERROR("vertical link STEC failed.");
+      ret = false;
+      continue;
+    }
+    if (memcmp(&TEC[i], &VTEC, sizeof(double_t)) != 0) {
+      LOG_ERROR("vertical TEC differs from single link STEC.");
+      ret = false;
+    }
+    if (!(VTEC > 0.0)) {
+      ret = false;
+    }
+  }
+
+  // the top of the ray must be above its bottom
+  double_t VTEC;
+  if (NeQuickG.get_vertical_total_electron_content(
+      nequick, longitude[0], latitude[0], top_height, bottom_height,
+      &VTEC) == NEQUICK_OK) {
+    LOG_ERROR("vertical TEC with bad heights must fail.");
+    ret = false;
+  }
+
+  if (NeQuickG.get_vertical_total_electron_content_batch(
+      nequick, NULL, bottom_height, top_height,
+      TEC, status) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  #undef NEQUICK_G_JRC_BATCH_TEST_LOCATIONS_COUNT
+  return ret;
+}
+
+// electron density profile above receiver 0, integrated with the trapezoidal
+// rule up to 1000 km it must match the vertical TEC
+static bool NeQuickG_batch_test_profile(NeQuickG_handle nequick) {
+
+  #define NEQUICK_G_JRC_BATCH_TEST_PROFILE_STEP_METERS (1000.0)
+  #define NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT (1001)
+  #define NEQUICK_G_JRC_BATCH_TEST_PROFILE_VTEC_RATIO (0.01)
+
+  static double_t height[NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT];
+  static double_t electron_density[NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT; i++) {
+    height[i] = (double_t)i*NEQUICK_G_JRC_BATCH_TEST_PROFILE_STEP_METERS;
+  }
+  double_t top_height =
+    height[NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT - 1];
+
+  if ((NeQuickG.set_time(
+        nequick,
+        NeQuickG_batch_test_month[0],
+        NeQuickG_batch_test_UTC[0]) != NEQUICK_OK) ||
+      (NeQuickG.get_electron_density_profile(
+        nequick,
+        NeQuickG_batch_test_receiver_longitude[0],
+        NeQuickG_batch_test_receiver_latitude[0],
+        height,
+        (size_t)NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT,
+        electron_density) != NEQUICK_OK)) {
+    LOG_ERROR("electron density profile failed.");
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC = 0.0;
+  size_t peak_index = 0;
+  for (size_t i = 1; i < NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT; i++) {
+    TEC += 0.5*(electron_density[i - 1] + electron_density[i])*
+      NEQUICK_G_JRC_BATCH_TEST_PROFILE_STEP_METERS;
+    if (electron_density[i] > electron_density[peak_index]) {
+      peak_index = i;
+    }
+  }
+  // electrons/m^2 to TECU
+  TEC /= 1.0e16;
+
+  // the F2 peak is above the E and below the topside
+  if ((height[peak_index] < 200000.0) || (height[peak_index] > 500000.0)) {
+    LOG_ERROR("electron density profile peak is not in the F2 region.");
+    ret = false;
+  }
+
+  double_t VTEC;
+  if (NeQuickG.get_vertical_total_electron_content(
+      nequick,
+      NeQuickG_batch_test_receiver_longitude[0],
+      NeQuickG_batch_test_receiver_latitude[0],
+      height[0],
+      top_height,
+      &VTEC) != NEQUICK_OK) {
+    ret = false;
+  } else if (!THRESHOLD_COMPARE(
+      TEC, VTEC, VTEC*NEQUICK_G_JRC_BATCH_TEST_PROFILE_VTEC_RATIO)) {
+    LOG_ERROR("electron density profile does not match the vertical TEC.");
+    ret = false;
+  }
+
+  // bad location
+  if (NeQuickG.get_electron_density_profile(
+      nequick,
+      NeQuickG_batch_test_receiver_longitude[0],
+      NeQuickG_batch_test_satellite_latitude[NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX],
+      height,
+      (size_t)NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT,
+      electron_density) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  if (NeQuickG.get_electron_density_profile(
+      nequick,
+      NeQuickG_batch_test_receiver_longitude[0],
+      NeQuickG_batch_test_receiver_latitude[0],
+      height,
+      (size_t)NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT,
+      NULL) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  #undef NEQUICK_G_JRC_BATCH_TEST_PROFILE_VTEC_RATIO
+  #undef NEQUICK_G_JRC_BATCH_TEST_PROFILE_HEIGHTS_COUNT
+  #undef NEQUICK_G_JRC_BATCH_TEST_PROFILE_STEP_METERS
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define NeQuickG_batch_test_impl(pModip_file, pCCIR_folder) \
+  NeQuickG_batch_test_impl()
+#endif
+
+static bool NeQuickG_batch_test_impl(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.init(pModip_file, pCCIR_folder, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  if (NeQuickG.set_solar_activity_coefficients(
+      nequick,
+      NeQuickG_batch_test_az,
+      (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT) != NEQUICK_OK) {
+    NeQuickG.close(nequick);
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC_per_link[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  if (!get_STEC_per_link(nequick, TEC_per_link)) {
+    LOG_ERROR("single link STEC failed.");
+    ret = false;
+  }
+
+  NeQuickG_links_t links;
+  get_links(&links);
+  double_t TEC[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+  int32_t status[NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT];
+
+  {
+    int32_t batch_ret = NeQuickG.get_total_electron_content_batch(
+      nequick, &links, TEC, status);
+    int32_t error_code;
+    if ((batch_ret != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+        (NeQuickG.get_last_error(&error_code) != batch_ret) ||
+        (error_code != NEQUICK_ERROR_CODE_BAD_LATITUDE)) {
+      LOG_ERROR("batch with a bad link must fail.");
+      ret = false;
+    }
+  }
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT; i++) {
+    bool is_bad_link = (i == NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX);
+    if (status[i] !=
+        (is_bad_link ? NEQUICK_ERROR_CODE_BAD_LATITUDE : NEQUICK_OK)) {
+      LOG_ERROR("batch link status is not the expected.");
+      ret = false;
+    }
+    // the batch must be bit identical to the single link interface
+    if (memcmp(&TEC[i], &TEC_per_link[i], sizeof(double_t)) != 0) {
+      LOG_ERROR("batch STEC differs from single link STEC.");
+      ret = false;
+    }
+    if (!THRESHOLD_COMPARE(
+          TEC[i],
+          NeQuickG_batch_test_STEC[i],
+          NEQUICK_G_JRC_BATCH_TEST_STEC_EPSILON)) {
+      LOG_ERROR("batch STEC is not the expected.");
+      ret = false;
+    }
+  }
+
+  if (!NeQuickG_batch_test_epoch(nequick, TEC_per_link)) {
+    ret = false;
+  }
+
+  if (!NeQuickG_batch_test_ECEF(nequick, TEC_per_link)) {
+    ret = false;
+  }
+
+  if (!NeQuickG_batch_test_group_delay(nequick, TEC_per_link)) {
+    ret = false;
+  }
+
+  if (!NeQuickG_batch_test_vertical(nequick)) {
+    ret = false;
+  }
+
+  if (!NeQuickG_batch_test_profile(nequick)) {
+    ret = false;
+  }
+
+  // empty batch
+  links.count = 0;
+  if (NeQuickG.get_total_electron_content_batch(
+      nequick, &links, TEC, status) != NEQUICK_OK) {
+    ret = false;
+  }
+
+  // null output
+  if (NeQuickG.get_total_electron_content_batch(
+      nequick, &links, NULL, status) == NEQUICK_OK) {
+    ret = false;
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmissing-prototypes"
+#endif
+bool NeQuickG_batch_test(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+  return NeQuickG_batch_test_impl(pModip_file, pCCIR_folder);
+}
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic pop
+#endif
+
+#undef NEQUICK_G_JRC_BATCH_TEST_STEC_EPSILON
+#undef NEQUICK_G_JRC_BATCH_TEST_BAD_LINK_INDEX
+#undef NEQUICK_G_JRC_BATCH_TEST_LINKS_COUNT
@@ -0,0 +1,252 @@
+/**
+ * NeQuickG parallel executor Unit test
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC_UT
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_executor_test.h"
+
+#include <string.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_macros.h"
+
+#define NEQUICK_G_JRC_EXECUTOR_TEST_RECORDS_COUNT (6)
+#define NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT (240)
+#define NEQUICK_G_JRC_EXECUTOR_TEST_BAD_LINK_1 (100)
+#define NEQUICK_G_JRC_EXECUTOR_TEST_BAD_LINK_2 (201)
+
+// benchmarkMid solar activity coefficients
+static const double_t
+  NeQuickG_executor_test_az[NEQUICKG_AZ_COEFFICIENTS_COUNT] =
+  {121.129893, 0.351254133, 0.0134635348};
+
+// benchmarkMid links:
+// UTC, receiver longitude, latitude, height,
+// satellite longitude, latitude, height
+static const double_t NeQuickG_executor_test_records
+  [NEQUICK_G_JRC_EXECUTOR_TEST_RECORDS_COUNT][7] = {
+  {0.0, 40.19, -3.00, -23.32, 76.65, -41.43, 20157673.93},
+  {0.0, 40.19, -3.00, -23.32, -13.11, -4.67, 20194168.22},
+  {0.0, 40.19, -3.00, -23.32, 26.31, -39.04, 20671871.64},
+  {4.0, 40.19, -3.00, -23.32, 79.33, -55.34, 20679595.44},
+  {12.0, 115.89, -31.80, 12.78, 133.47, -24.87, 19975574.41},
+  {16.0, 115.89, -31.80, 12.78, 154.31, -45.19, 20116286.17}
+};
+
+typedef struct NeQuickG_executor_test_links_st {
+  uint8_t month[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t UTC[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t receiver_longitude[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t receiver_latitude[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t receiver_height[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t satellite_longitude[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t satellite_latitude[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t satellite_height[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  double_t TEC[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  int32_t status[NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT];
+  NeQuickG_links_t links;
+} NeQuickG_executor_test_links_t;
+
+// the records are repeated with a stride that mixes the costly
+// low elevation links with the cheap ones
+static void get_links(NeQuickG_executor_test_links_t* const pLinks) {
+  for (size_t i = 0; i < NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT; i++) {
+    const double_t* pRecord = NeQuickG_executor_test_records[
+      ((i*5) + (i/NEQUICK_G_JRC_EXECUTOR_TEST_RECORDS_COUNT)) %
+        NEQUICK_G_JRC_EXECUTOR_TEST_RECORDS_COUNT];
+    pLinks->month[i] = 4;
+    pLinks->UTC[i] = pRecord[0];
+    pLinks->receiver_longitude[i] = pRecord[1];
+    pLinks->receiver_latitude[i] = pRecord[2];
+    pLinks->receiver_height[i] = pRecord[3];
+    pLinks->satellite_longitude[i] = pRecord[4];
+    pLinks->satellite_latitude[i] = pRecord[5];
+    pLinks->satellite_height[i] = pRecord[6];
+  }
+  pLinks->satellite_latitude[NEQUICK_G_JRC_EXECUTOR_TEST_BAD_LINK_1] = 100.0;
+  pLinks->receiver_latitude[NEQUICK_G_JRC_EXECUTOR_TEST_BAD_LINK_2] = -91.0;
+
+  pLinks->links.count = NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT;
+  pLinks->links.pMonth = pLinks->month;
+  pLinks->links.pUTC = pLinks->UTC;
+  pLinks->links.pReceiver_longitude_degree = pLinks->receiver_longitude;
+  pLinks->links.pReceiver_latitude_degree = pLinks->receiver_latitude;
+  pLinks->links.pReceiver_height_meters = pLinks->receiver_height;
+  pLinks->links.pSatellite_longitude_degree = pLinks->satellite_longitude;
+  pLinks->links.pSatellite_latitude_degree = pLinks->satellite_latitude;
+  pLinks->links.pSatellite_height_meters = pLinks->satellite_height;
+}
+
+// single session reference
+static bool get_reference(
+  NeQuickG_model_chandle model,
+  NeQuickG_executor_test_links_t* const pLinks,
+  int32_t* const pRet) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.session_init(model, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+  bool ret =
+    (NeQuickG.set_solar_activity_coefficients(
+      nequick,
+      NeQuickG_executor_test_az,
+      (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT) == NEQUICK_OK);
+  if (ret) {
+    *pRet = NeQuickG.get_total_electron_content_batch(
+      nequick, &pLinks->links, pLinks->TEC, pLinks->status);
+  }
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+static bool test_executor(
+  NeQuickG_model_chandle model,
+  size_t thread_count,
+  size_t links_count,
+  const NeQuickG_executor_test_links_t* const pReference,
+  int32_t reference_ret,
+  NeQuickG_executor_test_links_t* const pLinks) {
+
+  NeQuickG_executor_handle executor;
+  if (NeQuickG.executor_init(model, thread_count, &executor) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  pLinks->links.count = links_count;
+
+  // the pool is reused from one batch to the next
+  for (size_t j = 0; j < 2; j++) {
+    memset(pLinks->TEC, 0xFF, sizeof(pLinks->TEC));
+    // leaves another last error in the calling thread
+    (void)NeQuickG.executor_get_total_electron_content_batch(
+      executor,
+      NeQuickG_executor_test_az,
+      (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT,
+      NULL,
+      pLinks->TEC,
+      pLinks->status);
+    int32_t executor_ret = NeQuickG.executor_get_total_electron_content_batch(
+      executor,
+      NeQuickG_executor_test_az,
+      (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT,
+      &pLinks->links,
+      pLinks->TEC,
+      pLinks->status);
+
+    if ((links_count == NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT) &&
+        (executor_ret != reference_ret)) {
+      LOG_ERROR("executor returned an unexpected error.");
+      ret = false;
+    }
+
+    // the error raised in a worker thread is the last error of the caller
+    int32_t error_code;
+    if ((links_count == NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT) &&
+        ((NeQuickG.get_last_error(&error_code) != reference_ret) ||
+         (error_code != NEQUICK_ERROR_CODE_BAD_LATITUDE))) {
+      LOG_ERROR("executor last error is not the one of the first link that failed.");
+      ret = false;
+    }
+
+    // results in input order, bit identical to a single session
+    if ((memcmp(
+          pLinks->TEC, pReference->TEC,
+          links_count*sizeof(double_t)) != 0) ||
+        (memcmp(
+          pLinks->status, pReference->status,
+          links_count*sizeof(int32_t)) != 0)) {
+      LOG_ERROR("executor results differ from single session results.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.executor_close(executor);
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define NeQuickG_executor_test_impl(pModip_file, pCCIR_folder) \
+  NeQuickG_executor_test_impl()
+#endif
+
+static bool NeQuickG_executor_test_impl(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+
+  NeQuickG_model_handle model;
+  if (NeQuickG.model_init(pModip_file, pCCIR_folder, &model) != NEQUICK_OK) {
+    return false;
+  }
+
+  static NeQuickG_executor_test_links_t reference;
+  static NeQuickG_executor_test_links_t links;
+  get_links(&reference);
+  get_links(&links);
+
+  bool ret = true;
+
+  int32_t reference_ret = NEQUICK_OK;
+  if (!get_reference(model, &reference, &reference_ret) ||
+      (reference_ret == NEQUICK_OK)) {
+    ret = false;
+  }
+
+  static const size_t thread_counts[] = {1, 3, 8};
+  for (size_t i = 0; i < sizeof(thread_counts)/sizeof(thread_counts[0]); i++) {
+    if (!test_executor(
+          model, thread_counts[i],
+          NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT,
+          &reference, reference_ret, &links)) {
+      ret = false;
+    }
+  }
+
+  // less links than threads
+  if (!test_executor(model, 4, 2, &reference, reference_ret, &links)) {
+    ret = false;
+  }
+
+  {
+    NeQuickG_executor_handle executor;
+    if (NeQuickG.executor_init(model, 0, &executor) == NEQUICK_OK) {
+      NeQuickG.executor_close(executor);
+      ret = false;
+    }
+    if (NeQuickG.executor_init(
+          NEQUICKG_INVALID_HANDLE, 1, &executor) == NEQUICK_OK) {
+      NeQuickG.executor_close(executor);
+      ret = false;
+    }
+  }
+
+  NeQuickG.model_close(model);
+  return ret;
+}
+
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmissing-prototypes"
+#endif
+bool NeQuickG_executor_test(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+  return NeQuickG_executor_test_impl(pModip_file, pCCIR_folder);
+}
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic pop
+#endif
+
+#undef NEQUICK_G_JRC_EXECUTOR_TEST_BAD_LINK_2
+#undef NEQUICK_G_JRC_EXECUTOR_TEST_BAD_LINK_1
+#undef NEQUICK_G_JRC_EXECUTOR_TEST_LINKS_COUNT
+#undef NEQUICK_G_JRC_EXECUTOR_TEST_RECORDS_COUNT
@@ -213,8 +213,10 @@ static bool ITU_F2_layer_coefficients_test_new_AZr(
   const NeQuickG_time_t * const pTime,
   double_t Azr,
   size_t solar_activity_index) {;
+  F2_coefficient_array_t AF2;
+  Fm3_coefficient_array_t Am3;
   if (F2_layer_fourier_coefficients_interpolate(
-    pContext, pTime, Azr) != NEQUICK_OK) {
+    pContext, pTime, Azr, AF2, Am3) != NEQUICK_OK) {
     return false;
   }
 
@@ -234,12 +236,12 @@ static bool ITU_F2_layer_coefficients_test_new_AZr(
   size_t order;
   for (degree = 0; degree < ITU_F2_COEFF_MAX_DEGREE; degree++) {
     for (order = 0; order < ITU_F2_COEFF_MAX_ORDER; order++) {
-      double_t coef = pContext->interpolated.F2[degree][order];
+      double_t coef = AF2[degree][order];
       double_t coef_expected =
 #ifdef FTR_MODIP_CCIR_AS_CONSTANTS
         pF2
 #else
-        pContext->ionosonde.F2
+        pContext->ionosonde.pLoaded->F2
 #endif
         [solar_activity_index][degree][order];
       if (!THRESHOLD_COMPARE(
@@ -254,12 +256,12 @@ static bool ITU_F2_layer_coefficients_test_new_AZr(
 
   for (degree = 0; degree < ITU_FM3_COEFF_MAX_DEGREE; degree++) {
     for (order = 0; order < ITU_FM3_COEFF_MAX_ORDER; order++) {
-      double_t coef = pContext->interpolated.Fm3[degree][order];
+      double_t coef = Am3[degree][order];
       double_t coef_expected =
 #ifdef FTR_MODIP_CCIR_AS_CONSTANTS
         pFm3
 #else
-        pContext->ionosonde.Fm3
+        pContext->ionosonde.pLoaded->Fm3
 #endif
         [solar_activity_index][degree][order];
       if (!THRESHOLD_COMPARE(
@@ -304,17 +306,21 @@ static bool ITU_F2_layer_coefficients_test_new_AZr_interpolated(
   for (size_t test_case_index = 0;
       test_case_index < ITU_F2_LAYER_INTERPOLATED_COEFF_TEST_VECTORS_COUNT;
     test_case_index++) {
+    F2_coefficient_array_t AF2;
+    Fm3_coefficient_array_t Am3;
     if (F2_layer_fourier_coefficients_interpolate(
       pContext,
       pTime,
-      ITU_F2_layer_coefficients_test_vector[test_case_index].Azr) != NEQUICK_OK) {
+      ITU_F2_layer_coefficients_test_vector[test_case_index].Azr,
+      AF2,
+      Am3) != NEQUICK_OK) {
       return false;
     }
     size_t degree;
     size_t order;
     for (degree = 0; degree < ITU_F2_COEFF_MAX_DEGREE; degree++) {
       for (order = 0; order < ITU_F2_COEFF_MAX_ORDER; order++) {
-        double_t coef = pContext->interpolated.F2[degree][order];
+        double_t coef = AF2[degree][order];
         double_t coef_expected =
           ITU_F2_layer_coefficients_test_vector[test_case_index].AF2[degree][order];
         if (!THRESHOLD_COMPARE(
@@ -329,7 +335,7 @@ static bool ITU_F2_layer_coefficients_test_new_AZr_interpolated(
 
     for (degree = 0; degree < ITU_FM3_COEFF_MAX_DEGREE; degree++) {
       for (order = 0; order < ITU_FM3_COEFF_MAX_ORDER; order++) {
-        double_t coef = pContext->interpolated.Fm3[degree][order];
+        double_t coef = Am3[degree][order];
         double_t coef_expected =
           ITU_F2_layer_coefficients_test_vector[test_case_index].Am3[degree][order];
         if (!THRESHOLD_COMPARE(
@@ -355,11 +361,10 @@ static bool ITU_F2_layer_coefficients_interpolated_test(
   bool ret = true;
   F2_layer_fourier_coeff_context_t context;
 
-  if (F2_layer_fourier_coefficients_init(
-      &context,
-      pCCIR_folder) != NEQUICK_OK) {
-    return false;
-  }
+  F2_layer_fourier_coefficients_init(
+    &context,
+    pCCIR_folder,
+    NULL);
 
   NeQuickG_time_t time;
   time.month = 4;
@@ -389,11 +394,10 @@ static bool ITU_F2_layer_coefficients_fourier_test(
   bool ret = true;
   F2_layer_fourier_coeff_context_t context;
 
-  if (F2_layer_fourier_coefficients_init(
-      &context,
-      pCCIR_folder) != NEQUICK_OK) {
-    return false;
-  }
+  F2_layer_fourier_coefficients_init(
+    &context,
+    pCCIR_folder,
+    NULL);
 
   for (size_t i = 0; i < ITU_F2_LAYER_INTERPOLATED_COEFF_FOURIER_TEST_VECTORS_COUNT; i++) {
     solar_activity_t solar_activity;
@@ -404,6 +408,7 @@ static bool ITU_F2_layer_coefficients_fourier_test(
       &context,
       &ITU_F2_layer_coefficients_fourier_test_vector[i].time,
       &solar_activity) != NEQUICK_OK) {
+      F2_layer_fourier_coefficients_close(&context);
       return false;
     }
 
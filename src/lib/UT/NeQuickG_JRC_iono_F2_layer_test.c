@@ -103,9 +103,16 @@ static bool NeQuickG_iono_F2_layer_test_freq(void) {
   const char CCIR_folder[] = {"./../../ccir/"};
 #endif
 
-  if (F2_layer_init(&F2, CCIR_folder) != NEQUICK_OK) {
+  F2_layer_init(&F2, CCIR_folder, NULL);
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  char modip_grid_file[] = "./../../modip/modip2001_wrapped.asc";
+  modip_grid_t modip_grid;
+  if (modip_grid_init(modip_grid_file, &modip_grid) != NEQUICK_OK) {
+    F2_layer_close(&F2);
     return false;
   }
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
   for (
     size_t i = 0;
@@ -122,15 +129,13 @@ static bool NeQuickG_iono_F2_layer_test_freq(void) {
       NeQuickG_F2_layer_test_vector[i].longitude_degree,
       NeQuickG_F2_layer_test_vector[i].latitude_degree,
       0.0, NEQUICK_G_JRC_HEIGHT_UNITS_KM) != NEQUICK_OK) {
+      F2_layer_close(&F2);
       return false;
     }
 
     modip_context_t modip;
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-    char modip_grid_file[] = "./../../modip/modip2001_wrapped.asc";
-    if (modip_init(&modip, modip_grid_file) != NEQUICK_OK) {
-      return false;
-    }
+    modip_init(&modip, &modip_grid);
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
     modip_get(&modip, &current_position);
 
@@ -140,6 +145,7 @@ static bool NeQuickG_iono_F2_layer_test_freq(void) {
         &modip,
         &solar_activity,
         &current_position) != NEQUICK_OK) {
+      F2_layer_close(&F2);
       return false;
     }
 
@@ -0,0 +1,260 @@
+/**
+ * NeQuickG pool of sessions Unit test
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC_UT
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#include "NeQuickG_JRC_pool_test.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_error.h"
+#include "NeQuickG_JRC_macros.h"
+
+#define NEQUICK_G_JRC_POOL_TEST_SESSIONS_COUNT (4)
+#define NEQUICK_G_JRC_POOL_TEST_THREADS_COUNT (4)
+#define NEQUICK_G_JRC_POOL_TEST_REQUESTS_COUNT (8)
+
+// benchmarkMid solar activity coefficients
+static const double_t
+  NeQuickG_pool_test_az[NEQUICKG_AZ_COEFFICIENTS_COUNT] =
+  {121.129893, 0.351254133, 0.0134635348};
+
+// benchmarkMid link: month, UTC, receiver longitude, latitude, height,
+// satellite longitude, latitude, height
+static const double_t NeQuickG_pool_test_link[8] =
+  {4.0, 0.0, 40.19, -3.00, -23.32, 76.65, -41.43, 20157673.93};
+
+// a request as served by a service: every input is set
+static int32_t get_STEC(NeQuickG_handle nequick, double_t* const pTEC) {
+
+  int32_t ret = NeQuickG.set_solar_activity_coefficients(
+    nequick,
+    NeQuickG_pool_test_az,
+    (size_t)NEQUICKG_AZ_COEFFICIENTS_COUNT);
+  if (ret == NEQUICK_OK) {
+    ret = NeQuickG.set_time(
+      nequick,
+      (uint8_t)NeQuickG_pool_test_link[0],
+      NeQuickG_pool_test_link[1]);
+  }
+  if (ret == NEQUICK_OK) {
+    ret = NeQuickG.set_receiver_position(
+      nequick,
+      NeQuickG_pool_test_link[2],
+      NeQuickG_pool_test_link[3],
+      NeQuickG_pool_test_link[4]);
+  }
+  if (ret == NEQUICK_OK) {
+    ret = NeQuickG.set_satellite_position(
+      nequick,
+      NeQuickG_pool_test_link[5],
+      NeQuickG_pool_test_link[6],
+      NeQuickG_pool_test_link[7]);
+  }
+  if (ret == NEQUICK_OK) {
+    ret = NeQuickG.get_total_electron_content(nequick, pTEC);
+  }
+  return ret;
+}
+
+typedef struct NeQuickG_pool_test_thread_st {
+  pthread_t thread;
+  NeQuickG_pool_handle pool;
+  double_t reference_TEC;
+  bool is_ok;
+} NeQuickG_pool_test_thread_t;
+
+static void* run_requests(void* pArg) {
+  NeQuickG_pool_test_thread_t* pThread = (NeQuickG_pool_test_thread_t*)pArg;
+  for (size_t i = 0; i < NEQUICK_G_JRC_POOL_TEST_REQUESTS_COUNT; i++) {
+    NeQuickG_handle nequick;
+    double_t TEC;
+    if ((NeQuickG.pool_acquire(pThread->pool, &nequick) != NEQUICK_OK) ||
+        (get_STEC(nequick, &TEC) != NEQUICK_OK) ||
+        (memcmp(&TEC, &pThread->reference_TEC, sizeof(double_t)) != 0) ||
+        (NeQuickG.pool_release(pThread->pool, nequick) != NEQUICK_OK)) {
+      pThread->is_ok = false;
+    }
+  }
+  return NULL;
+}
+
+static bool test_reset(
+  NeQuickG_model_chandle model,
+  double_t reference_TEC) {
+
+  NeQuickG_handle nequick;
+  if (NeQuickG.session_init(model, &nequick) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  double_t TEC;
+  for (size_t i = 0; i < 2; i++) {
+    if ((get_STEC(nequick, &TEC) != NEQUICK_OK) ||
+        (memcmp(&TEC, &reference_TEC, sizeof(double_t)) != 0)) {
+      LOG_ERROR("STEC after reset differs from a new session STEC.");
+      ret = false;
+    }
+    if (NeQuickG.reset(nequick) != NEQUICK_OK) {
+      ret = false;
+    }
+  }
+
+  NeQuickG.close(nequick);
+  return ret;
+}
+
+static bool test_pool(
+  NeQuickG_model_chandle model,
+  NeQuickG_handle foreign_session,
+  double_t reference_TEC) {
+
+  NeQuickG_pool_handle pool;
+  if (NeQuickG.pool_init(
+        model, NEQUICK_G_JRC_POOL_TEST_SESSIONS_COUNT, &pool) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  NeQuickG_handle sessions[NEQUICK_G_JRC_POOL_TEST_SESSIONS_COUNT];
+  for (size_t i = 0; i < NEQUICK_G_JRC_POOL_TEST_SESSIONS_COUNT; i++) {
+    if (NeQuickG.pool_acquire(pool, &sessions[i]) != NEQUICK_OK) {
+      ret = false;
+    }
+  }
+
+  // no session left
+  NeQuickG_handle nequick;
+  int32_t error_code;
+  if ((NeQuickG.pool_acquire(pool, &nequick) == NEQUICK_OK) ||
+      (nequick != NEQUICKG_INVALID_HANDLE) ||
+      (NeQuickG.get_last_error(&error_code) != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+      (error_code != NEQUICK_ERROR_CODE_POOL_EXHAUSTED)) {
+    LOG_ERROR("acquire from an exhausted pool must fail.");
+    ret = false;
+  }
+
+  // the session memory belongs to the pool, close must leave it alone
+  NeQuickG.close(sessions[0]);
+  if ((NeQuickG.get_last_error(&error_code) != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+      (error_code != NEQUICK_ERROR_CODE_BAD_SESSION)) {
+    LOG_ERROR("close of a pool session must be rejected.");
+    ret = false;
+  }
+
+  for (size_t i = 0; i < NEQUICK_G_JRC_POOL_TEST_SESSIONS_COUNT; i++) {
+    if (NeQuickG.pool_release(pool, sessions[i]) != NEQUICK_OK) {
+      ret = false;
+    }
+  }
+
+  // released twice, or not from the pool
+  if ((NeQuickG.pool_release(pool, sessions[0]) == NEQUICK_OK) ||
+      (NeQuickG.pool_release(pool, foreign_session) == NEQUICK_OK)) {
+    LOG_ERROR("release of a session not acquired must fail.");
+    ret = false;
+  }
+
+  // the sessions are shared by threads serving requests
+  NeQuickG_pool_test_thread_t threads[NEQUICK_G_JRC_POOL_TEST_THREADS_COUNT];
+  size_t started_count = 0;
+  for (size_t i = 0; i < NEQUICK_G_JRC_POOL_TEST_THREADS_COUNT; i++) {
+    threads[i].pool = pool;
+    threads[i].reference_TEC = reference_TEC;
+    threads[i].is_ok = true;
+    if (pthread_create(
+          &threads[i].thread, NULL, run_requests, &threads[i]) != 0) {
+      ret = false;
+      break;
+    }
+    started_count++;
+  }
+  for (size_t i = 0; i < started_count; i++) {
+    pthread_join(threads[i].thread, NULL);
+    if (!threads[i].is_ok) {
+      LOG_ERROR("pool request STEC differs from a new session STEC.");
+      ret = false;
+    }
+  }
+
+  NeQuickG.pool_close(pool);
+
+  if (NeQuickG.pool_init(model, 0, &pool) == NEQUICK_OK) {
+    NeQuickG.pool_close(pool);
+    ret = false;
+  }
+  if ((pool != NEQUICKG_INVALID_HANDLE) ||
+      (NeQuickG.get_last_error(&error_code) != NEQUICK_ERROR_SRC_INPUT_DATA) ||
+      (error_code != NEQUICK_ERROR_CODE_BAD_SESSION_COUNT)) {
+    LOG_ERROR("pool without sessions must be rejected as a bad argument.");
+    ret = false;
+  }
+  return ret;
+}
+
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define NeQuickG_pool_test_impl(pModip_file, pCCIR_folder) \
+  NeQuickG_pool_test_impl()
+#endif
+
+static bool NeQuickG_pool_test_impl(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+
+  NeQuickG_model_handle model;
+  if (NeQuickG.model_init(pModip_file, pCCIR_folder, &model) != NEQUICK_OK) {
+    return false;
+  }
+
+  bool ret = true;
+
+  NeQuickG_handle nequick;
+  double_t reference_TEC = 0.0;
+  if (NeQuickG.session_init(model, &nequick) != NEQUICK_OK) {
+    NeQuickG.model_close(model);
+    return false;
+  }
+  if (get_STEC(nequick, &reference_TEC) != NEQUICK_OK) {
+    ret = false;
+  }
+
+  if (!test_reset(model, reference_TEC)) {
+    ret = false;
+  }
+
+  if (!test_pool(model, nequick, reference_TEC)) {
+    ret = false;
+  }
+
+  NeQuickG.close(nequick);
+  NeQuickG.model_close(model);
+  return ret;
+}
+
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmissing-prototypes"
+#endif
+bool NeQuickG_pool_test(
+  const char* const pModip_file,
+  const char* const pCCIR_folder) {
+  return NeQuickG_pool_test_impl(pModip_file, pCCIR_folder);
+}
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && (defined(__GNUC__) || defined(__GNUG__))
+  #pragma GCC diagnostic pop
+#endif
+
+#undef NEQUICK_G_JRC_POOL_TEST_REQUESTS_COUNT
+#undef NEQUICK_G_JRC_POOL_TEST_THREADS_COUNT
+#undef NEQUICK_G_JRC_POOL_TEST_SESSIONS_COUNT
@@ -19,11 +19,16 @@ H_SEARCH_PATH += $(NEQUICK_LIB_DIRECTORY)/private
 SOURCEFILES += \
   ITU_R_P_371_8 \
   NeQuickG_JRC \
+  NeQuickG_JRC_batch \
+  NeQuickG_JRC_context \
   NeQuickG_JRC_coordinates \
   NeQuickG_JRC_electron_density \
+  NeQuickG_JRC_error \
+  NeQuickG_JRC_executor \
   NeQuickG_JRC_Gauss_Kronrod_integration \
   NeQuickG_JRC_geometry \
   NeQuickG_JRC_input_data \
+  NeQuickG_JRC_integration_mesh \
   NeQuickG_JRC_interpolate \
   NeQuickG_JRC_iono_E_layer \
   NeQuickG_JRC_iono_F1_layer \
@@ -31,14 +36,20 @@ SOURCEFILES += \
   NeQuickG_JRC_iono_F2_layer_fourier_coefficients \
   NeQuickG_JRC_iono_profile \
   NeQuickG_JRC_math_utils \
+  NeQuickG_JRC_model \
   NeQuickG_JRC_MODIP \
   NeQuickG_JRC_MODIP_grid \
+  NeQuickG_JRC_pool \
+  NeQuickG_JRC_profile_anchors \
+  NeQuickG_JRC_profile_cache \
   NeQuickG_JRC_ray \
   NeQuickG_JRC_ray_slant \
   NeQuickG_JRC_ray_vertical \
   NeQuickG_JRC_solar \
   NeQuickG_JRC_solar_activity \
+  NeQuickG_JRC_TEC_gradient \
   NeQuickG_JRC_TEC_integration \
+  NeQuickG_JRC_TEC_partial \
   NeQuickG_JRC_time
 
 ifeq ($(FTR_MODIP_CCIR_AS_CONSTANTS),1)
@@ -74,6 +85,8 @@ ifneq (, $(IS_DEBUG_TARGET_IF_NON_EMPTY))
   SOURCEFILES += \
     NeQuickG_JRC_API_test \
     NeQuickG_JRC_Az_test \
+    NeQuickG_JRC_batch_test \
+    NeQuickG_JRC_executor_test \
     NeQuickG_JRC_iono_E_layer_test \
     NeQuickG_JRC_iono_F1_layer_test \
     NeQuickG_JRC_iono_F2_layer_fourier_coefficients_test \
@@ -81,10 +94,11 @@ ifneq (, $(IS_DEBUG_TARGET_IF_NON_EMPTY))
     NeQuickG_JRC_iono_layer_amplitudes_test \
     NeQuickG_JRC_iono_layer_thickness_test \
     NeQuickG_JRC_MODIP_test \
+    NeQuickG_JRC_pool_test \
     NeQuickG_JRC_ray_test \
     NeQuickG_JRC_solar_test \
     NeQuickG_JRC_UT
 endif
 
-#libraries: the math lib
-LIBS += -lm
+#libraries: the math lib and POSIX threads (executor, pool)
+LIBS += -lm -lpthread
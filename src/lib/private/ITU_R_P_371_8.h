@@ -41,4 +41,15 @@
 extern double_t get_solar_mean_spot_number
   (double_t solar_12_month_running_mean_of_2800_MHZ_noise_flux_in_sfu);
 
+/** Derivative of #get_solar_mean_spot_number with respect to the solar flux:
+ * dR12/dF10.7 = 561.8 / (1672.73 + (F10.7 − 63.7)1123.6)<SUP>0.5</SUP>
+ *
+ * @param[in] solar_12_month_running_mean_of_2800_MHZ_noise_flux_in_sfu solar flux
+ *        expressed in units of  10<SUP>-22</SUP> W/(m<SUP>2</SUP>*Hz).
+ *
+ * @return derivative of the solar 12 month mean spot number, per sfu
+ */
+extern double_t get_solar_mean_spot_number_derivative
+  (double_t solar_12_month_running_mean_of_2800_MHZ_noise_flux_in_sfu);
+
 #endif // ITU_R_P_371_8_H
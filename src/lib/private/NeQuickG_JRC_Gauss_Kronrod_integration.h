@@ -18,6 +18,18 @@
 #include <math.h>
 
 #include "NeQuickG_JRC_context.h"
+#include "NeQuickG_JRC_integration_mesh.h"
+
+/** Size of the interval pool of the global adaptive integration,
+ * see #Gauss_Kronrod_integrate_global
+ */
+#define NEQUICK_G_JRC_KRONROD_INTERVAL_COUNT_MAX (256)
+
+/** Electron density evaluations of the first rule of a segment,
+ * set aside for the segments still to be integrated when there is an
+ * evaluation budget (NeQuickG_integration_settings_t.evaluation_max)
+ */
+#define NEQUICK_G_JRC_KRONROD_SEGMENT_EVALUATION_COUNT (15)
 
 /** Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> context */
 typedef struct NeQuickG_gauss_kronrod_context_st {
@@ -29,6 +41,10 @@ typedef struct NeQuickG_gauss_kronrod_context_st {
   size_t recursion_level;
   /** recursion limit */
   size_t recursion_max;
+  /** mesh where the accepted sub-intervals of #Gauss_Kronrod_integrate
+   * are appended, NULL if they are not recorded
+   */
+  integration_mesh_t* pMesh;
 } gauss_kronrod_context_t;
 
 /** Integration function for calculating TEC along rays using
@@ -41,7 +57,10 @@ typedef struct NeQuickG_gauss_kronrod_context_st {
  * or to split the portion into two and try again in order to improve accuracy.
  * Note that this method is recursive but has appropriate safeguards in the form of the
  * recursion limit passed in from configuration.
- * See F.2.6.1.
+ * See F.2.6.1.<br>
+ * With an evaluation budget a portion is not split if the two halves
+ * would not fit in the evaluations left after the reserved ones
+ * (NeQuickG_integration_t.evaluation_reserved), as at the recursion limit.
  *
  * Default integration tolerance for Kronrod G7-K15 integration method below 1000 km is
  *  #NEQUICK_G_JRC_INTEGRATION_KRONROD_TOLERANCE_BELOW_FIRST_POINT
@@ -64,4 +83,109 @@ extern int32_t Gauss_Kronrod_integrate(
   const double_t point_2_height_km,
   double_t* const pTEC);
 
+/** Variant of #Gauss_Kronrod_integrate that refines a segment with the
+ * nested Patterson rules before splitting it.
+ * When the G<SUB>7</SUB>-K<SUB>15</SUB> error is not acceptable, 16 points
+ * are added to the 15 already evaluated (31 points rule) and the error is
+ * estimated against K<SUB>15</SUB>; if it is still not acceptable, 32 more
+ * points are added (63 points rule). Only then the segment is split in two.
+ * No density evaluation is discarded on the way up to 63 points.
+ *
+ * @param[in, out] pGauss_kronrod Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> context
+ * @param[in, out] pContext NeQuick-G context
+ * @param[in] point_1_height_km Height of point 1 in km
+ * @param[in] point_2_height_km Height of point 2 in km
+ * @param[out] pTEC TEC value, to get TECU divide by 10<SUP>13</SUP>
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t Gauss_Kronrod_Patterson_integrate(
+  gauss_kronrod_context_t* const pGauss_kronrod,
+  NeQuickG_context_t* const pContext,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pTEC);
+
+/** Variant of #Gauss_Kronrod_integrate that starts from the sub-intervals
+ * of the previous integration of the same segment of a link
+ * (see NeQuickG_JRC_integration_mesh.h) instead of from the whole segment.<br>
+ * The sub-intervals are scaled to the new segment and each one goes through
+ * #Gauss_Kronrod_integrate from its own recursion level: it is accepted if
+ * the error is within the tolerance, split otherwise.
+ * Two sibling sub-intervals whose error was far below the tolerance are
+ * merged first, so that the mesh also coarsens as the geometry changes.
+ * Every accepted sub-interval meets the same tolerance as with a cold start.
+ * Without previous sub-intervals this is #Gauss_Kronrod_integrate.
+ *
+ * @param[in, out] pGauss_kronrod Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> context
+ * @param[in, out] pContext NeQuick-G context
+ * @param[in] pInterval sub-intervals of the previous integration of the segment
+ * @param[in] interval_count number of sub-intervals, 0 for a cold start
+ * @param[in] point_1_height_km Height of point 1 in km
+ * @param[in] point_2_height_km Height of point 2 in km
+ * @param[out] pTEC TEC value, to get TECU divide by 10<SUP>13</SUP>
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t Gauss_Kronrod_integrate_mesh(
+  gauss_kronrod_context_t* const pGauss_kronrod,
+  NeQuickG_context_t* const pContext,
+  const integration_mesh_interval_t* const pInterval,
+  const size_t interval_count,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pTEC);
+
+/** Places the K<SUB>15</SUB> nodes on the sub-intervals of the previous
+ * integration of a segment (see NeQuickG_JRC_integration_mesh.h), scaled to
+ * the segment, without evaluating anything: the weighted sum of any integrand
+ * at these nodes is the K<SUB>15</SUB> integration on the same partition.
+ * Without previous sub-intervals the whole segment is one sub-interval.
+ *
+ * @param[in] pInterval sub-intervals of the previous integration of the segment
+ * @param[in] interval_count number of sub-intervals
+ * @param[in] point_1_height_km Height of point 1 in km
+ * @param[in] point_2_height_km Height of point 2 in km
+ * @param[out] pHeight_km nodes, room for
+ *  max(interval_count, 1) * #NEQUICK_G_JRC_KRONROD_SEGMENT_EVALUATION_COUNT
+ * @param[out] pWeight weights of the nodes, in km
+ *
+ * @return number of nodes
+ */
+extern size_t Gauss_Kronrod_get_fixed_nodes(
+  const integration_mesh_interval_t* const pInterval,
+  const size_t interval_count,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pHeight_km,
+  double_t* const pWeight);
+
+/** Global adaptive variant of #Gauss_Kronrod_integrate (QUADPACK QAG style).
+ * The sub-intervals are kept in a max-heap ordered by their error estimate
+ * |K15 - G7|: the worst one is split in two until the total error estimate
+ * meets the tolerance (relative to the total, or absolute, as in
+ * #Gauss_Kronrod_integrate).<br>
+ * The refinement goes where the error is, instead of requiring every
+ * sub-interval to meet the tolerance on its own, so it usually needs
+ * fewer electron density evaluations.
+ * There is no recursion: the sub-intervals live in a pool of
+ * #NEQUICK_G_JRC_KRONROD_INTERVAL_COUNT_MAX elements on the stack,
+ * when the pool is full the current total is returned.
+ *
+ * @param[in] pGauss_kronrod Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> context,
+ *  the recursion fields are not used
+ * @param[in, out] pContext NeQuick-G context
+ * @param[in] point_1_height_km Height of point 1 in km
+ * @param[in] point_2_height_km Height of point 2 in km
+ * @param[out] pTEC TEC value, to get TECU divide by 10<SUP>13</SUP>
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t Gauss_Kronrod_integrate_global(
+  const gauss_kronrod_context_t* const pGauss_kronrod,
+  NeQuickG_context_t* const pContext,
+  const double_t point_1_height_km,
+  const double_t point_2_height_km,
+  double_t* const pTEC);
+
 #endif // NEQUICK_G_JRC_GAUSS_KRONROD_INTEGRATION_H
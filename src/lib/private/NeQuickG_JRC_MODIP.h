@@ -34,8 +34,8 @@
 /** Modip context */
 typedef struct modip_context_st {
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
-  /** modip grid context */
-  modip_grid_t grid;
+  /** modip grid, owned by the shared model */
+  const modip_grid_t* pGrid;
 #endif //!FTR_MODIP_CCIR_AS_CONSTANTS
   /** calculated modip in degrees */
   double_t modip_degree;
@@ -44,13 +44,12 @@ typedef struct modip_context_st {
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
 /** Modip context initialization
  *
- * @param[in] pContext modip context
- * @param[in] pModip_file modip grid file
- * @return on success NEQUICK_OK
+ * @param[out] pContext modip context
+ * @param[in] pGrid modip grid already loaded, see #modip_grid_init
  */
-extern int32_t modip_init(
+extern void modip_init(
   modip_context_t* const pContext,
-  const char* const pModip_file);
+  const modip_grid_t* const pGrid);
 #endif //!FTR_MODIP_CCIR_AS_CONSTANTS
 
 /** Get receiver modip by grid interpolation, see 2.5.4.3.
@@ -62,4 +61,17 @@ extern void modip_get(
   modip_context_t* const pContext,
   const position_t* const pPosition);
 
+/** Get modip with its derivatives with respect to the latitude
+ * and the longitude (degree), see #modip_get.
+ * The context is not modified.
+ *
+ * @param[in] pContext modip context
+ * @param[in] pPosition location at which the modip is required
+ * @param[out] pModip_degree modip in degrees
+ */
+extern void modip_get_dual(
+  const modip_context_t* const pContext,
+  const position_t* const pPosition,
+  NeQuickG_dual_t* const pModip_degree);
+
 #endif // NEQUICK_G_JRC_MODIP_H
@@ -45,6 +45,7 @@
 #include <stdbool.h>
 
 #include "NeQuickG_JRC_coordinates.h"
+#include "NeQuickG_JRC_math_utils.h"
 
 /** Number of grid points for the latitude */
 #define NEQUICK_G_JRC_MODIP_GRID_LAT_POINTS_COUNT (39)
@@ -95,4 +96,21 @@ extern void modip_grid_interpolate(
   const position_t* const pPosition,
   double_t *pModip_degree);
 
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
+#define modip_grid_interpolate_dual(pGrid, pPosition, pModip_degree) \
+  modip_grid_interpolate_dual(pPosition, pModip_degree)
+#endif
+
+/** Modip grid interpolation with its derivatives with respect to
+ * the latitude and the longitude (degree), see #modip_grid_interpolate.
+ *
+ * @param[in] pGrid modip grid context
+ * @param[in] pPosition location at which the modip is required
+ * @param[out] pModip_degree modip in degrees
+ */
+extern void modip_grid_interpolate_dual(
+  const modip_grid_t* const pGrid,
+  const position_t* const pPosition,
+  NeQuickG_dual_t* const pModip_degree);
+
 #endif // NEQUICK_G_JRC_MODIP_GRID_H
@@ -0,0 +1,54 @@
+/** NeQuickG partial derivatives of the Slant Total Electron Content (STEC).
+ *
+ * The STEC is integrated once, keeping the final sub-intervals of the
+ * Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> recursion. The electron density is
+ * then evaluated once more at the K<SUB>15</SUB> nodes of those
+ * sub-intervals (#Gauss_Kronrod_get_fixed_nodes) with its derivatives with
+ * respect to Az and to the position of the node (#NeQuickG_dual_t).<br>
+ * For the ray X(t) = R + t(S - R) from the receiver R to the satellite S:
+ *  - d(STEC)/d(Az) is the sum of the node derivatives, chained to the
+ *    coefficients ai<SUB>0</SUB>, ai<SUB>1</SUB> and ai<SUB>2</SUB>
+ *  - d(STEC)/d(R) = -u STEC/|S - R| + &Sigma; w (1 - t) grad(Ne),
+ *    u being the direction of the ray, chained to the receiver coordinates
+ *    with the change of Az with the receiver MODIP.
+ *    A receiver below the ground adds the move of the start of the path
+ *    at height 0.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_TEC_GRADIENT_H
+#define NEQUICK_G_JRC_TEC_GRADIENT_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_context.h"
+
+/** Gets the Slant Total Electron Content and its partial derivatives for the
+ * receiver and satellite positions in the context,
+ * see #NeQuickG_library.get_total_electron_content_gradient.<br>
+ * The integration method is #NEQUICKG_INTEGRATION_RECURSIVE whatever the
+ * settings, without the semi-analytic vertical integration. If there are
+ * too many sub-intervals to keep (#NEQUICK_G_JRC_MESH_INTERVAL_COUNT_MAX),
+ * the nodes are on a uniform partition of the ray.<br>
+ * The evaluation count of the context includes the derivative pass, the
+ * statistics of the session count a single integration.
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[out] pTEC total electron content in TECU
+ * @param[out] pGradient partial derivatives of the total electron content
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_TEC_gradient_get(
+  NeQuickG_context_t* const pContext,
+  double_t* const pTEC,
+  NeQuickG_TEC_gradient_t* const pGradient);
+
+#endif // NEQUICK_G_JRC_TEC_GRADIENT_H
@@ -31,7 +31,32 @@
  * The STEC integration routine used in this implementation is the method based on
  * Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> adaptive quadrature with the default tolerances defined in the specification.
  * See section F.2.6.<br>
- * The maximum recursion level for the integration routine is #NEQUICK_G_JRC_RECURSION_LIMIT_MAX<br>
+ * The breakpoints, tolerances and maximum recursion level are taken from the
+ * integration settings of the context, by default
+ * #NEQUICKG_INTEGRATION_PRESET_SPECIFICATION.<br>
+ * With NeQuickG_integration_settings_t.split_at_layer_peaks the path below the
+ * first breakpoint is also split at the E, F1 and F2 layer peaks, where the
+ * Epstein layers bend sharply; a slant ray takes the peak heights from the
+ * profile where it crosses 300 km (it counts as one evaluation).<br>
+ * With NeQuickG_integration_settings_t.semi_analytic_vertical a vertical ray
+ * is integrated by #ray_vertical_get_integral instead.<br>
+ * With #NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE each segment is integrated by
+ * #Gauss_Kronrod_integrate_global, with #NEQUICKG_INTEGRATION_PATTERSON by
+ * #Gauss_Kronrod_Patterson_integrate, with the same tolerances.<br>
+ * When the context refers to the mesh of a link
+ * (NeQuickG_integration_t.pMesh) and the method is
+ * #NEQUICKG_INTEGRATION_RECURSIVE each segment is integrated by
+ * #Gauss_Kronrod_integrate_mesh from the previous epoch of the link,
+ * and the mesh is updated.<br>
+ * With NeQuickG_integration_settings_t.evaluation_max the first rule of
+ * every segment still to be integrated is set aside, and no sub-interval
+ * is refined beyond the evaluations left: the result is the best estimate
+ * within the budget (NeQuickG_integration_t.is_budget_exhausted).<br>
+ * When the context asks for partial integrals (NeQuickG_integration_t.pPartial)
+ * the path is also split at their points, and every part of the path is
+ * added to the integral below the points above it.<br>
+ * The electron density evaluations are counted in the context, with the
+ * error estimate of the result and the statistics of the session.
  *
  * @param[in, out] pContext Nequick context
  * @param[out] pTEC Total electron content in km/m<SUP>3</SUP>
@@ -41,4 +66,23 @@ extern int32_t NeQuickG_integrate(
   NeQuickG_context_t* const pContext,
   double_t* const pTEC);
 
+/** Gets the integration settings of a preset.<br>
+ * #NEQUICKG_INTEGRATION_PRESET_SPECIFICATION: breakpoints at 1000 and 2000 km,
+ * tolerances 0.001 below and 0.01 above the first breakpoint,
+ * 50 recursion levels (F.2.3.3).<br>
+ * #NEQUICKG_INTEGRATION_PRESET_NAVIGATION: tolerances 0.01 and 0.05,
+ * 10 recursion levels, path split at the layer peaks, semi-analytic
+ * vertical rays.<br>
+ * #NEQUICKG_INTEGRATION_PRESET_REFERENCE: tolerances 1e-5 and 1e-4.<br>
+ * All the presets use #NEQUICKG_INTEGRATION_RECURSIVE, without
+ * evaluation budget.
+ *
+ * @param[in] preset preset
+ * @param[out] pSettings integration settings
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_integration_get_preset(
+  const uint8_t preset,
+  NeQuickG_integration_settings_t* const pSettings);
+
 #endif // NEQUICK_G_JRC_TEC_INTEGRATION_H
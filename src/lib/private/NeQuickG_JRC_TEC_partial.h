@@ -0,0 +1,42 @@
+/** NeQuickG partial Slant Total Electron Content (STEC): per height shell
+ * and cumulative along the ray.
+ *
+ * The integration of the STEC splits the path at the shell boundaries and at
+ * the points of the cumulative profile as well, and adds every part of the
+ * path to the integral below the points above it
+ * (NeQuickG_integration_t.pPartial). The shells and the cumulative profile
+ * are differences of those integrals: a single integration gives them all.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_TEC_PARTIAL_H
+#define NEQUICK_G_JRC_TEC_PARTIAL_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_context.h"
+
+/** Gets the Slant Total Electron Content per height shell and its cumulative
+ * profile along the ray for the receiver and satellite positions in the
+ * context, see #NeQuickG_library.get_total_electron_content_partial.<br>
+ * The solar activity is the one at the receiver.
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in, out] pPartial shells and cumulative profile
+ * @param[out] pTEC total electron content in TECU
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_TEC_partial_get(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_TEC_partial_t* const pPartial,
+  double_t* const pTEC);
+
+#endif // NEQUICK_G_JRC_TEC_PARTIAL_H
@@ -0,0 +1,126 @@
+/** NeQuickG batch of receiver-satellite links.
+ *
+ * The links are evaluated in order on a single context.
+ * The receiver-side state (MODIP, Effective Ionisation Level) is
+ * computed only when the receiver changes from one link to the next,
+ * the Fourier coefficients of the CCIR maps only when the epoch changes.<br>
+ * The epoch variant evaluates one receiver against many satellites,
+ * the receiver-side state is computed once.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_BATCH_H
+#define NEQUICK_G_JRC_BATCH_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_context.h"
+
+/** Checks the batch pointers
+ *
+ * @param[in] pLinks batch of links
+ * @param[in] pTEC total electron content per link
+ * @param[in] pStatus status per link
+ * @return NEQUICK_OK if none of the pointers used by the batch is NULL
+ */
+extern int32_t NeQuickG_batch_check_links(
+  const NeQuickG_links_t* const pLinks,
+  const double_t* const pTEC,
+  const int32_t* const pStatus);
+
+/** Gets the Slant Total Electron Content for a batch of links,
+ * see #NeQuickG_library.get_total_electron_content_batch
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pLinks batch of links
+ * @param[out] pTEC total electron content per link in TECU
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+ * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+ *  that failed, its error code is recorded as the last error
+ */
+extern int32_t NeQuickG_batch_get_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus);
+
+/** Gets the Slant Total Electron Content for a batch of links in ECEF coordinates,
+ * see #NeQuickG_library.get_total_electron_content_batch_ECEF
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pLinks batch of links
+ * @param[out] pTEC total electron content per link in TECU
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+ * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+ *  that failed, its error code is recorded as the last error
+ */
+extern int32_t NeQuickG_batch_get_total_electron_content_ECEF(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_ECEF_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus);
+
+/** Gets the group delay of a batch of links at several frequencies,
+ * see #NeQuickG_library.get_group_delay_batch
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pLinks batch of links
+ * @param[in] pFrequencies carrier frequencies
+ * @param[out] pDelay group delay per link and frequency in meters
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+ * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+ *  that failed, its error code is recorded as the last error
+ */
+extern int32_t NeQuickG_batch_get_group_delay(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_links_t* const pLinks,
+  const NeQuickG_frequencies_t* const pFrequencies,
+  double_t* const pDelay,
+  int32_t* const pStatus);
+
+/** Gets the Slant Total Electron Content from the context receiver
+ * to a set of satellites,
+ * see #NeQuickG_library.get_total_electron_content_epoch
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pSatellites satellite positions
+ * @param[out] pTEC total electron content per satellite in TECU
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per satellite
+ * @return NEQUICK_OK if every satellite succeeded, otherwise the error source of the first satellite
+ *  that failed, its error code is recorded as the last error
+ */
+extern int32_t NeQuickG_batch_get_total_electron_content_epoch(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_satellites_t* const pSatellites,
+  double_t* const pTEC,
+  int32_t* const pStatus);
+
+/** Gets the Vertical Total Electron Content above many locations,
+ * see #NeQuickG_library.get_vertical_total_electron_content_batch
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pLocations locations
+ * @param[in] bottom_height_meters height of the bottom of the rays (m)
+ * @param[in] top_height_meters height of the top of the rays (m)
+ * @param[out] pTEC total electron content per location in TECU
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per location
+ * @return NEQUICK_OK if every location succeeded, otherwise the error source of the first location
+ *  that failed, its error code is recorded as the last error
+ */
+extern int32_t NeQuickG_batch_get_vertical_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_locations_t* const pLocations,
+  const double_t bottom_height_meters,
+  const double_t top_height_meters,
+  double_t* const pTEC,
+  int32_t* const pStatus);
+
+#endif // NEQUICK_G_JRC_BATCH_H
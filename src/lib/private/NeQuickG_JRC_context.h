@@ -12,16 +12,104 @@
 #ifndef NEQUICK_G_JRC_CONTEXT_H
 #define NEQUICK_G_JRC_CONTEXT_H
 
+#include "NeQuickG_JRC.h"
 #include "NeQuickG_JRC_input_data.h"
+#include "NeQuickG_JRC_integration_mesh.h"
 #include "NeQuickG_JRC_iono_profile.h"
 #include "NeQuickG_JRC_MODIP.h"
+#include "NeQuickG_JRC_model.h"
+#include "NeQuickG_JRC_profile_anchors.h"
+#include "NeQuickG_JRC_profile_cache.h"
 #include "NeQuickG_JRC_solar_activity.h"
 #include "NeQuickG_JRC_ray.h"
 
+/** Layers with a peak: E, F1 and F2 */
+#define NEQUICK_G_JRC_LAYER_PEAK_COUNT (3)
+
+/** Points the path is split at for the partial integrals:
+ * the shell boundaries, then the points of the cumulative profile
+ */
+#define NEQUICK_G_JRC_PARTIAL_POINT_COUNT_MAX \
+  (NEQUICKG_TEC_SHELL_BOUNDARY_COUNT_MAX + \
+   NEQUICKG_TEC_CUMULATIVE_POINT_COUNT_MAX)
+
+/** Partial integrals of a ray, see #NeQuickG_TEC_partial_get */
+typedef struct NeQuickG_integration_partial_st {
+  /** number of shell boundaries */
+  size_t height_count;
+  /** shell boundary heights in km */
+  double_t height_km[NEQUICKG_TEC_SHELL_BOUNDARY_COUNT_MAX];
+  /** number of points of the cumulative profile */
+  size_t distance_count;
+  /** distances along the ray from the receiver in km */
+  double_t distance_km[NEQUICKG_TEC_CUMULATIVE_POINT_COUNT_MAX];
+  /** the shell boundaries and the points of the cumulative profile
+   * (height or slant distance) in km, -HUGE_VAL for a height the ray does
+   * not go down to
+   */
+  double_t point_km[NEQUICK_G_JRC_PARTIAL_POINT_COUNT_MAX];
+  /** integral of the path below each point */
+  double_t TEC_below[NEQUICK_G_JRC_PARTIAL_POINT_COUNT_MAX];
+} NeQuickG_integration_partial_t;
+
+/** Integration settings and statistics of a session */
+typedef struct NeQuickG_integration_st {
+  /** method, breakpoints, tolerances and recursion limit */
+  NeQuickG_integration_settings_t settings;
+  /** electron density evaluations of the last integration */
+  size_t evaluation_count;
+  /** evaluations set aside for the sub-intervals and segments still to be
+   * integrated, see NeQuickG_integration_settings_t.evaluation_max
+   */
+  size_t evaluation_reserved;
+  /** the evaluation budget stopped the last integration? */
+  bool is_budget_exhausted;
+  /** error estimate of the last integration,
+   * to get TECU divide by 10<SUP>13</SUP>
+   */
+  double_t error_estimate;
+  /** integrations since the session was initialized or reset */
+  NeQuickG_integration_statistics_t statistics;
+  /** layer peak points (height or slant distance) of the ray being
+   * integrated, in ascending order, see
+   * NeQuickG_integration_settings_t.split_at_layer_peaks
+   */
+  double_t layer_peak_point_km[NEQUICK_G_JRC_LAYER_PEAK_COUNT];
+  /** number of valid layer peak points */
+  size_t layer_peak_point_count;
+  /** integration meshes of the links,
+   * see #NeQuickG_library.get_total_electron_content_link,
+   * allocated at the first link, NULL until then
+   */
+  integration_mesh_cache_t* pMesh_cache;
+  /** mesh in the cache of the link being integrated,
+   * NULL if the ray is not a link with an ID
+   */
+  integration_mesh_t* pMesh;
+  /** mesh of the integration in progress of the link */
+  integration_mesh_t next_mesh;
+  /** partial integrals of the integration in progress,
+   * NULL if only the total is needed
+   */
+  NeQuickG_integration_partial_t* pPartial;
+} NeQuickG_integration_t;
+
 /** This structure contains the internal context
- * of the library.
+ * of the library: a session.<br>
+ * A session holds the per-query mutable state and
+ * refers to a read-only shared model.<br>
+ * Every query writes the session, including its lazy caches
+ * (Fourier coefficients, E layer solar declination, F2 layer peak
+ * after the exosphere adjustment), so a session must not be used
+ * by two threads at the same time.
  */
 typedef struct NeQuickG_context_st {
+  /** shared model the session refers to.*/
+  const NeQuickG_model_t* pModel;
+  /** model owned by the session (NULL if it is shared).*/
+  NeQuickG_model_t* pOwned_model;
+  /** the session belongs to a pool, it must not be closed with NeQuickG.close.*/
+  bool is_pooled;
   /** modip contex.*/
   modip_context_t modip;
   /** solar activity contex.*/
@@ -32,6 +120,166 @@ typedef struct NeQuickG_context_st {
   ray_context_t ray;
   /** input data contex.*/
   input_data_t input_data;
+  /** integration contex.*/
+  NeQuickG_integration_t integration;
+  /** layer peaks of the slant ray nodes.*/
+  profile_cache_t profile_cache;
+  /** layer peaks at the anchors of the slant ray being integrated.*/
+  profile_anchors_t profile_anchors;
 } NeQuickG_context_t;
 
+/** Initializes a session on a shared model
+ *
+ * @param[out] pContext NeQuick context
+ * @param[in] pModel shared model, it must outlive the context
+ */
+extern void NeQuickG_context_init(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_model_t* const pModel);
+
+/** Clears the per-query state of a session: time, positions,
+ * solar activity coefficients and ray.
+ * The integration settings are set back to
+ * #NEQUICKG_INTEGRATION_PRESET_SPECIFICATION, the link meshes are
+ * forgotten and the profile and Fourier coefficient caches are disabled.<br>
+ * The session keeps its model and its lazy caches, which are keyed on
+ * their inputs, so the next queries start warm. Nothing is allocated.
+ *
+ * @param[in, out] pContext NeQuick context
+ */
+extern void NeQuickG_context_reset(
+  NeQuickG_context_t* const pContext);
+
+/** Frees the resources allocated by the queries of a session,
+ * the session can be used again after a new #NeQuickG_context_init.
+ *
+ * @param[in, out] pContext NeQuick context
+ */
+extern void NeQuickG_context_close(
+  NeQuickG_context_t* const pContext);
+
+/** Sets the time of the next queries
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] month [#NEQUICK_G_JRC_MONTH_JANUARY-#NEQUICK_G_JRC_MONTH_DECEMBER]
+ * @param[in] UTC UT in hours
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_context_set_time(
+  NeQuickG_context_t* const pContext,
+  const uint8_t month,
+  const double_t UTC);
+
+/** Sets the integration method of the next queries
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] method #NEQUICKG_INTEGRATION_RECURSIVE,
+ *  #NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE or #NEQUICKG_INTEGRATION_PATTERSON
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_context_set_integration_method(
+  NeQuickG_context_t* const pContext,
+  const uint8_t method);
+
+/** Sets the integration settings of the next queries.
+ * The method must be supported, the breakpoints positive and ordered,
+ * the tolerances positive, the evaluation budget 0 or at least
+ * #NEQUICKG_INTEGRATION_EVALUATION_BUDGET_MIN. The link meshes are forgotten.
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pSettings integration settings
+ * @return on success NEQUICK_OK, the context is left unchanged otherwise
+ */
+extern int32_t NeQuickG_context_set_integration_settings(
+  NeQuickG_context_t* const pContext,
+  const NeQuickG_integration_settings_t* const pSettings);
+
+/** Sets the receiver modip in the context
+ *
+ * input data is converted to km if necessary
+ *
+ * @param[in, out] pContext NeQuick context
+ */
+extern void NeQuickG_context_get_modip(
+  NeQuickG_context_t* const pContext);
+
+/** Sets the solar activity at the receiver in the context
+ * @see {@link NeQuickG_context_get_modip}
+ * @see {@link solar_activity_get}
+ *
+ * @param[in, out] pContext NeQuick context
+ */
+extern void NeQuickG_context_get_solar_activity(
+  NeQuickG_context_t* const pContext);
+
+/** Gets the Slant Total Electron Content in TECU for the receiver and
+ *  satellite positions in the context.
+ *  Needs the solar activity at the receiver,
+ *  see {@link NeQuickG_context_get_solar_activity}
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[out] pTEC total electron content in TECU
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_context_get_slant_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  double_t* const pTEC);
+
+/** Gets the Slant Total Electron Content in TECU of a link,
+ * see #NeQuickG_library.get_total_electron_content_link<br>
+ * Same as #NeQuickG_context_get_slant_total_electron_content, the
+ * integration starts from the mesh of the previous epoch of the link.
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] link_id link ID
+ * @param[out] pTEC total electron content in TECU
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_context_get_slant_total_electron_content_link(
+  NeQuickG_context_t* const pContext,
+  const uint32_t link_id,
+  double_t* const pTEC);
+
+/** Gets the Vertical Total Electron Content above a location,
+ * see #NeQuickG_library.get_vertical_total_electron_content<br>
+ * The receiver is set at the bottom of the ray, the satellite at the top,
+ * the ray is vertical by construction (no #ray_get).
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] longitude_degree geodetic longitude (degrees)
+ * @param[in] latitude_degree geodetic latitude (degrees)
+ * @param[in] bottom_height_meters geodetic height of the bottom of the ray (m)
+ * @param[in] top_height_meters geodetic height of the top of the ray (m)
+ * @param[out] pTEC total electron content in TECU
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_context_get_vertical_total_electron_content(
+  NeQuickG_context_t* const pContext,
+  const double_t longitude_degree,
+  const double_t latitude_degree,
+  const double_t bottom_height_meters,
+  const double_t top_height_meters,
+  double_t* const pTEC);
+
+/** Gets the electron density profile above a location,
+ * see #NeQuickG_library.get_electron_density_profile<br>
+ * The profile is built once (#iono_profile_get) and then sampled
+ * at every height (#electron_density_get).
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] longitude_degree geodetic longitude (degrees)
+ * @param[in] latitude_degree geodetic latitude (degrees)
+ * @param[in] pHeight_meters heights (m), height_count elements
+ * @param[in] height_count number of heights
+ * @param[out] pElectron_density electron density per height in m<SUP>-3</SUP>
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_context_get_electron_density_profile(
+  NeQuickG_context_t* const pContext,
+  const double_t longitude_degree,
+  const double_t latitude_degree,
+  const double_t* const pHeight_meters,
+  const size_t height_count,
+  double_t* const pElectron_density);
+
 #endif // NEQUICK_G_JRC_CONTEXT_H
@@ -18,6 +18,7 @@
 
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "NeQuickG_JRC_geometry.h"
@@ -80,6 +81,31 @@ extern int32_t position_set(
   double_t latitude_degree,
   double_t height, uint_fast8_t height_units);
 
+/** Sets the positions from WGS-84 Earth-Centred Earth-Fixed coordinates.<br>
+ * The geodetic latitude, longitude and ellipsoidal height are obtained with
+ * the closed form of Heikkinen (1982), the sinus and cosinus of the angles
+ * come out of the conversion and are stored without calling the trigonometric
+ * functions again.<br>
+ * A position with non-finite coordinates or below the Earth surface
+ * is rejected with NEQUICK_ERROR_SRC_INPUT_DATA and
+ * NEQUICK_ERROR_CODE_BAD_POSITION.
+ *
+ * @param[out] pPositions count positions, height in meters
+ * @param[in] pX_meters ECEF x coordinate (m)
+ * @param[in] pY_meters ECEF y coordinate (m)
+ * @param[in] pZ_meters ECEF z coordinate (m)
+ * @param[in] count number of positions
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per position
+ * @return NEQUICK_OK if every position is valid, otherwise the error source of the first position rejected
+ */
+extern int32_t positions_set_from_ECEF(
+  position_t* const pPositions,
+  const double_t* const pX_meters,
+  const double_t* const pY_meters,
+  const double_t* const pZ_meters,
+  size_t count,
+  int32_t* const pStatus);
+
 /** Sets the position in kilometers
  * @param[in, out] pPosition position coordinates
  */
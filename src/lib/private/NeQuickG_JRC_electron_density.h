@@ -12,6 +12,7 @@
 #define NEQUICK_G_JRC_ELECTRON_DENSITY_H
 
 #include <math.h>
+#include <stddef.h>
 
 #include "NeQuickG_JRC_iono_profile.h"
 
@@ -33,4 +34,38 @@ extern double_t electron_density_get(
   iono_profile_t* const pProfile,
   const double_t height_km);
 
+/** Returns the electron density with its derivatives with respect to Az
+ * and the location, see #electron_density_get
+ *
+ * @param[in, out] pProfile ionospheric profile with its derivatives
+ * @param[in] pHeight_km height in km,
+ *  its derivatives are those of the location (usually 1 for the height)
+ * @return electron density in m<SUP>-3</SUP>
+ */
+extern NeQuickG_dual_t electron_density_get_dual(
+  iono_profile_dual_t* const pProfile,
+  const NeQuickG_dual_t* const pHeight_km);
+
+/** Returns the integral of the electron density between two heights
+ * using the calculated ionospheric profile, i.e. along a vertical ray.<br>
+ * The integral is semi-analytic:
+ *  - the F2 Epstein layer of the bottomside is integrated in closed form
+ *  - the E and F1 layers, corrected around the F2 peak, and the bottomside
+ *    below 100 km, with a Gauss-Legendre rule on panels split at the layer peaks
+ *  - the topside with a Gauss-Legendre rule in its Epstein argument,
+ *    where the integrand is closed form<br>
+ * The number of evaluations does not depend on the profile shape (at most 96).
+ *
+ * @param[in, out] pProfile ionospheric profile
+ * @param[in] height_1_km bottom height in km
+ * @param[in] height_2_km top height in km
+ * @param[out] pEvaluation_count number of integrand evaluations
+ * @return integral of the electron density in km/m<SUP>3</SUP>
+ */
+extern double_t electron_density_get_integral(
+  iono_profile_t* const pProfile,
+  const double_t height_1_km,
+  const double_t height_2_km,
+  size_t* const pEvaluation_count);
+
 #endif // NEQUICK_G_JRC_ELECTRON_DENSITY_H
@@ -11,6 +11,8 @@
 #ifndef NEQUICK_G_JRC_ERROR_H
 #define NEQUICK_G_JRC_ERROR_H
 
+#include <stdint.h>
+
 /** The source of the error code is the memory. */
 #define NEQUICK_ERROR_SRC_MEMORY (-1)
 /** The source of the error code is the input data. */
@@ -61,12 +63,76 @@
 /** Error code: invalid Nequick handle */
 #define NEQUICK_HANDLE_NULL (11)
 
-/** Log an error in the standard error.
+/** Error code: null pointer in the input data */
+#define NEQUICK_ERROR_CODE_NULL_POINTER (12)
+
+/** Error code: the executor needs at least one thread */
+#define NEQUICK_ERROR_CODE_BAD_THREAD_COUNT (13)
+
+/** Error code: the top height of a vertical ray must be above its bottom height */
+#define NEQUICK_ERROR_CODE_BAD_HEIGHTS (14)
+
+/** Error code: carrier frequencies must be positive */
+#define NEQUICK_ERROR_CODE_BAD_FREQUENCY (15)
+
+/** Error code: no free session left in the pool */
+#define NEQUICK_ERROR_CODE_POOL_EXHAUSTED (16)
+
+/** Error code: the session was not acquired from the pool */
+#define NEQUICK_ERROR_CODE_BAD_SESSION (17)
+
+/** Error code: unknown integration method */
+#define NEQUICK_ERROR_CODE_BAD_INTEGRATION_METHOD (18)
+
+/** Error code: unknown integration preset or inconsistent integration settings */
+#define NEQUICK_ERROR_CODE_BAD_INTEGRATION_SETTINGS (19)
+
+/** Error code: too many shell boundaries or cumulative points, or not in ascending order */
+#define NEQUICK_ERROR_CODE_BAD_TEC_PARTIAL (20)
+
+/** Error code: the profile cache quantum is out of range */
+#define NEQUICK_ERROR_CODE_BAD_PROFILE_CACHE (21)
+
+/** Error code: the Fourier coefficient cache is too large */
+#define NEQUICK_ERROR_CODE_BAD_FOURIER_CACHE (22)
+
+/** Error code: the feature is not available on this platform */
+#define NEQUICK_ERROR_CODE_NOT_SUPPORTED (23)
+
+/** Error code: the pool needs at least one session */
+#define NEQUICK_ERROR_CODE_BAD_SESSION_COUNT (24)
+
+/** Error code: ECEF coordinates not finite or below the Earth surface */
+#define NEQUICK_ERROR_CODE_BAD_POSITION (25)
+
+/** Records the last error of the calling thread.
+ * The error state is thread-local: an error raised while evaluating
+ * a handle in one thread is never visible from another thread.
+ *
+ * @param[in] error_src error source
+ * @param[in] error_code error code
+ */
+extern void NeQuickG_error_set_last(
+  int32_t error_src,
+  int32_t error_code);
+
+/** Gets the last error recorded in the calling thread,
+ * see #NeQuickG_library.get_last_error
+ *
+ * @param[out] pError_code error code, NEQUICK_OK if no error was recorded
+ * @return error source, NEQUICK_OK if no error was recorded
+ */
+extern int32_t NeQuickG_error_get_last(
+  int32_t* const pError_code);
+
+/** Log an error in the standard error and records it as the last error
+ * of the calling thread.
  * @param[in] error_src error source
  * @param[in] error_code error code
  * @param[in] ... printf format string + additional arguments
  */
 #define NEQUICK_ERROR_LOG(error_src, error_code, ...) \
+  NeQuickG_error_set_last((error_src), (error_code)); \
   fprintf(stderr, "Nequick error. File = %s, line = %i\n", __FILE__, __LINE__); \
   fprintf(stderr, __VA_ARGS__); \
   fprintf(stderr, "\n"); \
@@ -0,0 +1,135 @@
+/** NeQuickG parallel executor for batches of links.
+ *
+ * A pool of POSIX threads, each one owning a session opened on
+ * the same shared model (see NeQuickG_JRC_model.h).<br>
+ * A batch is split in chunks of consecutive links. The chunks are
+ * first dealt evenly to the workers, then a worker that has emptied its
+ * own queue steals half of the chunks left in the queue of another worker.
+ * The cost of a link is very uneven (a low elevation ray needs many more
+ * integration points than a zenith ray), stealing keeps all the threads
+ * busy until the end of the batch.<br>
+ * Each chunk writes its own slice of the output arrays, so the
+ * results are in the input order whatever thread evaluated them.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_EXECUTOR_H
+#define NEQUICK_G_JRC_EXECUTOR_H
+
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_context.h"
+
+/** Chunks of a worker, [begin, end) */
+typedef struct NeQuickG_executor_queue_st {
+  /** protects begin and end */
+  pthread_mutex_t lock;
+  /** next chunk to be evaluated by the owner */
+  size_t begin;
+  /** one past the last chunk, thieves take the chunks from the end */
+  size_t end;
+} NeQuickG_executor_queue_t;
+
+struct NeQuickG_executor_st;
+
+/** Executor worker */
+typedef struct NeQuickG_executor_worker_st {
+  /** worker thread */
+  pthread_t thread;
+  /** the executor the worker belongs to */
+  struct NeQuickG_executor_st* pExecutor;
+  /** the worker session */
+  NeQuickG_context_t context;
+  /** the worker queue */
+  NeQuickG_executor_queue_t queue;
+  /** last job evaluated */
+  uint64_t job_id;
+  /** first link of the first chunk of the job that failed in the worker,
+   * the number of links if none failed
+   */
+  size_t error_link;
+  /** error source of that chunk */
+  int32_t error_source;
+  /** error code of that chunk, the last error of the worker thread */
+  int32_t error_code;
+} NeQuickG_executor_worker_t;
+
+/** Executor */
+typedef struct NeQuickG_executor_st {
+  /** protects the job fields and the counters below */
+  pthread_mutex_t lock;
+  /** signaled when a new job is ready or when closing */
+  pthread_cond_t job_ready;
+  /** signaled when the last worker is done with the job */
+  pthread_cond_t job_done;
+  /** current job, incremented for every batch */
+  uint64_t job_id;
+  /** workers still evaluating the current job */
+  size_t workers_busy;
+  /** the workers must exit */
+  bool is_closing;
+  /** number of workers */
+  size_t thread_count;
+  /** the workers */
+  NeQuickG_executor_worker_t* pWorkers;
+  /** current job: solar activity coefficients */
+  double_t az[NEQUICKG_AZ_COEFFICIENTS_COUNT];
+  /** current job: links */
+  const NeQuickG_links_t* pLinks;
+  /** current job: STEC per link */
+  double_t* pTEC;
+  /** current job: status per link */
+  int32_t* pStatus;
+  /** current job: links per chunk */
+  size_t chunk_size;
+} NeQuickG_executor_t;
+
+/** Creates the pool of threads, see #NeQuickG_library.executor_init
+ *
+ * @param[out] pExecutor executor
+ * @param[in] pModel shared model, it must outlive the executor
+ * @param[in] thread_count number of threads, at least 1
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_executor_init(
+  NeQuickG_executor_t* const pExecutor,
+  const NeQuickG_model_t* const pModel,
+  size_t thread_count);
+
+/** Stops and joins the threads
+ * @param[in, out] pExecutor executor
+ */
+extern void NeQuickG_executor_close(
+  NeQuickG_executor_t* const pExecutor);
+
+/** Gets the Slant Total Electron Content for a batch of links in parallel,
+ * see #NeQuickG_library.executor_get_total_electron_content_batch
+ *
+ * @param[in, out] pExecutor executor
+ * @param[in] pAz solar activity coefficients
+ * @param[in] az_size Size of array pAz
+ * @param[in] pLinks batch of links
+ * @param[out] pTEC total electron content per link in TECU
+ * @param[out] pStatus NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+ * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+ *  that failed, its error is recorded as the last error of the calling thread
+ */
+extern int32_t NeQuickG_executor_get_total_electron_content(
+  NeQuickG_executor_t* const pExecutor,
+  const double_t* const pAz,
+  size_t az_size,
+  const NeQuickG_links_t* const pLinks,
+  double_t* const pTEC,
+  int32_t* const pStatus);
+
+#endif // NEQUICK_G_JRC_EXECUTOR_H
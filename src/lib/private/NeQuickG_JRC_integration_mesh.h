@@ -0,0 +1,158 @@
+/** NeQuickG integration mesh of the links of a session.
+ *
+ * Consecutive epochs of the same receiver-satellite link (1 s to 30 s apart)
+ * have nearly the same geometry, hence nearly the same sub-interval partition
+ * at the end of the Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> recursion.
+ * The session remembers that partition per link ID, so that the next epoch
+ * starts from it instead of from a single interval per segment
+ * (see #Gauss_Kronrod_integrate_mesh).<br>
+ *
+ * The sub-intervals of a segment are the leaves of the recursion, in
+ * ascending order: a leaf at depth d is 2<SUP>-d</SUP> of its segment,
+ * so the partition scales with the segment when the geometry moves.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_INTEGRATION_MESH_H
+#define NEQUICK_G_JRC_INTEGRATION_MESH_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of links remembered by a session,
+ * the least recently used link is forgotten first
+ */
+#define NEQUICK_G_JRC_MESH_LINK_COUNT (32)
+/** Maximum number of segments of a link: up to three integration ranges,
+ * split at up to three layer peak points
+ */
+#define NEQUICK_G_JRC_MESH_SEGMENT_COUNT_MAX (8)
+/** Maximum number of sub-intervals of a link,
+ * a link with more sub-intervals is not remembered
+ */
+#define NEQUICK_G_JRC_MESH_INTERVAL_COUNT_MAX (96)
+
+/** Segment of a link mesh: a call to the recursion */
+typedef struct integration_mesh_segment_st {
+  /** start point (height or slant distance) in km */
+  double_t point_1_km;
+  /** end point (height or slant distance) in km */
+  double_t point_2_km;
+  /** index of the first sub-interval of the segment */
+  size_t first_interval;
+  /** number of sub-intervals of the segment */
+  size_t interval_count;
+} integration_mesh_segment_t;
+
+/** Sub-interval of a link mesh: a leaf of the recursion */
+typedef struct integration_mesh_interval_st {
+  /** error estimate over the tolerance when the leaf was accepted */
+  double_t error_ratio;
+  /** recursion level of the leaf */
+  size_t depth;
+} integration_mesh_interval_t;
+
+/** Integration mesh of a link */
+typedef struct integration_mesh_st {
+  /** link ID given by the caller */
+  uint32_t link_id;
+  /** mesh holds the last integration of the link? */
+  bool is_valid;
+  /** cache clock at the last use, see #integration_mesh_cache_get */
+  uint64_t last_use;
+  /** number of segments */
+  size_t segment_count;
+  /** segments in integration order */
+  integration_mesh_segment_t segment[NEQUICK_G_JRC_MESH_SEGMENT_COUNT_MAX];
+  /** number of sub-intervals */
+  size_t interval_count;
+  /** sub-intervals of all the segments */
+  integration_mesh_interval_t interval[NEQUICK_G_JRC_MESH_INTERVAL_COUNT_MAX];
+} integration_mesh_t;
+
+/** Integration meshes of the links of a session */
+typedef struct integration_mesh_cache_st {
+  /** one mesh per link */
+  integration_mesh_t mesh[NEQUICK_G_JRC_MESH_LINK_COUNT];
+  /** incremented at each use */
+  uint64_t clock;
+} integration_mesh_cache_t;
+
+/** Forgets every link
+ *
+ * @param[out] pCache link meshes
+ */
+extern void integration_mesh_cache_init(
+  integration_mesh_cache_t* const pCache);
+
+/** Gets the mesh of a link. A link not in the cache takes the place of the
+ * least recently used one, its mesh is not valid.
+ *
+ * @param[in, out] pCache link meshes
+ * @param[in] link_id link ID
+ * @return the mesh of the link
+ */
+extern integration_mesh_t* integration_mesh_cache_get(
+  integration_mesh_cache_t* const pCache,
+  const uint32_t link_id);
+
+/** Empties the mesh of an integration in progress, it becomes valid.
+ * It is copied over the mesh of the link once the integration succeeds.
+ *
+ * @param[out] pNext_mesh mesh of the integration in progress
+ * @param[in] pMesh mesh of the link in the cache
+ */
+extern void integration_mesh_begin(
+  integration_mesh_t* const pNext_mesh,
+  const integration_mesh_t* const pMesh);
+
+/** Appends a segment, the next sub-intervals belong to it.
+ * The mesh is no longer valid if there are too many segments.
+ *
+ * @param[in, out] pMesh mesh
+ * @param[in] point_1_km start point in km
+ * @param[in] point_2_km end point in km
+ */
+extern void integration_mesh_add_segment(
+  integration_mesh_t* const pMesh,
+  const double_t point_1_km,
+  const double_t point_2_km);
+
+/** Appends a sub-interval to the last segment.
+ * The mesh is no longer valid if there are too many sub-intervals.
+ *
+ * @param[in, out] pMesh mesh
+ * @param[in] depth recursion level of the sub-interval
+ * @param[in] error_ratio error estimate over the tolerance
+ */
+extern void integration_mesh_add_interval(
+  integration_mesh_t* const pMesh,
+  const size_t depth,
+  const double_t error_ratio);
+
+/** Gets a segment of the previous integration of a link to start
+ * a segment from. There is no such segment if the mesh is not valid,
+ * has fewer segments or if the geometry jumped: the end points moved by more
+ * than #NEQUICK_G_JRC_MESH_JUMP_FRACTION of the segment length.
+ *
+ * @param[in] pMesh mesh of the previous integration
+ * @param[in] index segment index
+ * @param[in] point_1_km start point of the new segment in km
+ * @param[in] point_2_km end point of the new segment in km
+ * @return the segment, NULL if the segment must start from scratch
+ */
+extern const integration_mesh_segment_t* integration_mesh_get_segment(
+  const integration_mesh_t* const pMesh,
+  const size_t index,
+  const double_t point_1_km,
+  const double_t point_2_km);
+
+#endif // NEQUICK_G_JRC_INTEGRATION_MESH_H
@@ -44,3 +44,15 @@
 extern double_t interpolation_third_order(
   const double_t interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT],
   double_t offset);
+
+/** Derivative of #interpolation_third_order with respect to the position x:<br><CENTER>
+ *  dz<SUB>x</SUB>/dx = (2/16) * (a<SUB>1</SUB> + 2a<SUB>2</SUB>&delta; + 3a<SUB>3</SUB>&delta;<SUP>2</SUP>)
+ * </CENTER>
+ *
+ * @param[in] interpol_points 4 interpolation points: z<SUB>1</SUB>, z<SUB>2</SUB>, z<SUB>3</SUB> and z<SUB>4</SUB>
+ * @param[in] offset position x where x&isin;[0,1]
+ * @return derivative dz<SUB>x</SUB>/dx
+ */
+extern double_t interpolation_third_order_derivative(
+  const double_t interpol_points[NEQUICK_G_JRC_INTERPOLATE_POINT_COUNT],
+  double_t offset);
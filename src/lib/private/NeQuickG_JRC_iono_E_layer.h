@@ -65,11 +65,32 @@ extern void E_layer_get_critical_freq_MHz(
   const solar_activity_t* const pSolar_activity,
   const position_t* const pPosition);
 
+/** Get E layer critical frequency f0E in MHz with its derivatives,
+ * see #E_layer_get_critical_freq_MHz
+ *
+ * @param[in, out] pE E layer profile context, for the solar declination
+ * @param[in] pTime indication of the time at which the f0E is required
+ * @param[in] pSolar_activity solar activity with its derivatives
+ * @param[in] pPosition location at which the f0E is required
+ * @param[out] pLayer E layer critical frequency and peak electron density
+ */
+extern void E_layer_get_critical_freq_MHz_dual(
+  E_layer_t* const pE,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_dual_t* const pSolar_activity,
+  const position_t* const pPosition,
+  layer_dual_t* const pLayer);
+
 /** Get E layer maximum density height hmE [km] see 2.5.5.4.
  * @param[in, out] pE E layer profile context
  */
 extern void E_layer_get_peak_height(E_layer_t* const pE);
 
+/** Get E layer maximum density height hmE [km] with its derivatives
+ * @param[in, out] pE E layer profile
+ */
+extern void E_layer_get_peak_height_dual(layer_dual_t* const pE);
+
 /** Get E layer peak thickness see 2.5.5.7, Eq 88 and Eq. 89
  * @param[in, out] pE E layer profile context
  * @param[in] F1_peak_thickness_bottom_km F1 layer thickness bottom parameter
@@ -78,4 +99,13 @@ extern void E_layer_get_peak_thickness(
   E_layer_t* const pE,
   const double_t F1_peak_thickness_bottom_km);
 
+/** Get E layer peak thickness with its derivatives,
+ * see #E_layer_get_peak_thickness
+ * @param[in, out] pE E layer profile
+ * @param[in] pF1_peak_thickness_bottom_km F1 layer thickness bottom parameter
+ */
+extern void E_layer_get_peak_thickness_dual(
+  layer_dual_t* const pE,
+  const NeQuickG_dual_t* const pF1_peak_thickness_bottom_km);
+
 #endif // NEQUICK_G_JRC_IONO_E_LAYER_H
@@ -18,13 +18,16 @@
 /** Constant used to calculate F1 layer amplitude. Eq 95 */
 #define NEQUICK_G_JRC_IONO_F1_LAYER_AMPLITUDE_CONSTANT (0.8)
 
+/** Minimum F1 layer critical frequency for the F1 peak to be present (MHz) */
+#define NEQUICK_G_JRC_IONO_F1_LAYER_PEAK_PRESENT_MHZ (0.5)
+
 /** F1 peak is present, see Eq. 01
  * See F.2.9.5. NeQuick internal function NeqCalcF2PeakHeight
  *
  *@param[in] _F1 F1 layer profile context
  */
 #define NEQUICK_G_F1_LAYER_IS_PEAK_PRESENT(_F1) \
- (_F1.critical_frequency_MHz >= 0.5)
+ (_F1.critical_frequency_MHz >= NEQUICK_G_JRC_IONO_F1_LAYER_PEAK_PRESENT_MHZ)
 
 /**  Get F1 layer critical frequency f0F1 in MHz, see 2.5.5.1 and F.2.9.1
  *
@@ -64,6 +67,18 @@ extern void F1_layer_get_critical_freq_MHz(
   const double_t critical_freq_E_layer_MHz,
   const double_t critical_freq_F2_layer_MHz);
 
+/** Get F1 layer critical frequency f0F1 in MHz with its derivatives,
+ * see #F1_layer_get_critical_freq_MHz
+ *
+ * @param[in, out] pF1 F1 layer profile
+ * @param[in] pCritical_freq_E_layer_MHz E layer critical frequency foE (MHz)
+ * @param[in] pCritical_freq_F2_layer_MHz F2 layer critical frequency foF2 (MHz)
+ */
+extern void F1_layer_get_critical_freq_MHz_dual(
+  layer_dual_t* const pF1,
+  const NeQuickG_dual_t* const pCritical_freq_E_layer_MHz,
+  const NeQuickG_dual_t* const pCritical_freq_F2_layer_MHz);
+
 /** Get F1 layer maximum density height hmF1 [km] see 2.5.5.5.
  *
  * @param[in, out] pF1 F1 layer profile context
@@ -75,6 +90,17 @@ extern void F1_layer_get_peak_height(
   const double_t E_peak_height_km,
   const double_t F2_peak_height_km);
 
+/** Get F1 layer maximum density height hmF1 [km] with its derivatives
+ *
+ * @param[in, out] pF1 F1 layer profile
+ * @param[in] pE_peak_height_km E layer maximum density height
+ * @param[in] pF2_peak_height_km F2 layer maximum density height
+ */
+extern void F1_layer_get_peak_height_dual(
+  layer_dual_t* const pF1,
+  const NeQuickG_dual_t* const pE_peak_height_km,
+  const NeQuickG_dual_t* const pF2_peak_height_km);
+
 /** Get F1 layer peak thickness see 2.5.5.7, Eq 86 and Eq. 87
  *
  * @param[in, out] pF1 F1 layer profile context
@@ -86,4 +112,15 @@ extern void F1_layer_get_peak_thickness(
   const double_t E_peak_height_km,
   const double_t F2_peak_height_km);
 
+/** Get F1 layer peak thickness with its derivatives
+ *
+ * @param[in, out] pF1 F1 layer profile
+ * @param[in] pE_peak_height_km E layer maximum density height
+ * @param[in] pF2_peak_height_km F2 layer maximum density height
+ */
+extern void F1_layer_get_peak_thickness_dual(
+  layer_dual_t* const pF1,
+  const NeQuickG_dual_t* const pE_peak_height_km,
+  const NeQuickG_dual_t* const pF2_peak_height_km);
+
 #endif // NEQUICK_G_JRC_IONO_F1_LAYER_H
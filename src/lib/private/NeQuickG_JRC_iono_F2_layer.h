@@ -32,28 +32,35 @@ typedef struct F2_layer_st {
   double_t trans_factor;
 } F2_layer_t;
 
+/** F2 layer profile with its derivatives, see #F2_layer_t */
+typedef struct F2_layer_dual_st {
+  /** generic ionospheric layer profile */
+  layer_dual_t layer;
+  /** Transmission factor M(3000)F2 */
+  NeQuickG_dual_t trans_factor;
+} F2_layer_dual_t;
+
 #if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
-#define F2_layer_init(pContext, pCCIR_folder) \
+#define F2_layer_init(pContext, pCCIR_folder, pCCIR_months) \
   F2_layer_init(pContext)
 #endif
 
 /** Initialize F2 layer profile context
  * @param[out] pContext F2 layer profile context
- * @param[in] pCCIR_folder CCIR folder
+ * @param[in] pCCIR_folder CCIR folder, it must outlive the context
+ * @param[in] pCCIR_months coefficients of the 12 months, they must outlive
+ *  the context; NULL to load the coefficients of a month from the CCIR folder
  */
-extern int32_t F2_layer_init(
+extern void F2_layer_init(
   F2_layer_t* const pContext,
-  const char* const pCCIR_folder);
+  const char* const pCCIR_folder,
+  const F2_layer_ionosonde_coefficients_t* const pCCIR_months);
 
-#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
-#define F2_layer_close(pContext)
-#else
 /** Free resources allocated by the F2 layer profile context
  * @param[in, out] pContext F2 layer profile context
  */
 extern void F2_layer_close(
   F2_layer_t* const pContext);
-#endif
 
 /** Get F2 layer critical frequency f0F2 in MHz and Transmission factor M(3000)F2, see 2.5.5.3.
  * For the calculation of foF2 and M(3000)F2, the CCIR maps are used.
@@ -71,6 +78,27 @@ extern int32_t F2_layer_get_critical_freq_MHz(
   const solar_activity_t* const pSolar_activity,
   const position_t* const pCurrent_position);
 
+/** Get F2 layer critical frequency f0F2 in MHz and Transmission factor
+ * M(3000)F2 with their derivatives, see #F2_layer_get_critical_freq_MHz.
+ * The CCIR maps are linear in the effective sun spot count.
+ *
+ * @param[in, out] pContext F2 layer profile context, for the Fourier coefficients
+ * @param[in] pTime indication of the time at which the f0F2 is required
+ * @param[in] pModip_degree MODIP at the location
+ * @param[in] pSolar_activity solar activity
+ * @param[in] pSolar_activity_dual solar activity with its derivatives
+ * @param[in] pCurrent_position location at which the f0F2 is required
+ * @param[out] pLayer F2 layer profile
+ */
+extern int32_t F2_layer_get_critical_freq_MHz_dual(
+  F2_layer_t* const pContext,
+  const NeQuickG_time_t* const pTime,
+  const NeQuickG_dual_t* const pModip_degree,
+  const solar_activity_t* const pSolar_activity,
+  const solar_activity_dual_t* const pSolar_activity_dual,
+  const position_t* const pCurrent_position,
+  F2_layer_dual_t* const pLayer);
+
 /** Get F2 layer maximum density height hmF2 [km] from
  * foE, foF2 and M3000. It is based on the method of
  * Dudeney, 1983, J. Atmos. Terr.Phys., 45, 629-640.
@@ -90,18 +118,39 @@ extern void F2_layer_get_peak_height(
   F2_layer_t* const pContext,
   const double_t critical_freq_E_layer_MHz);
 
+/** Get F2 layer maximum density height hmF2 [km] with its derivatives
+ *
+ * @param[in, out] pLayer F2 layer profile
+ * @param[in] pCritical_freq_E_layer_MHz E layer critical frequency
+ */
+extern void F2_layer_get_peak_height_dual(
+  F2_layer_dual_t* const pLayer,
+  const NeQuickG_dual_t* const pCritical_freq_E_layer_MHz);
+
 /** Get F2 layer peak thickness see 2.5.5.7, Eq 85
  *
  * @param[in, out] pContext F2 layer profile context
  */
 extern void F2_layer_get_peak_thickness(F2_layer_t* const pContext);
 
+/** Get F2 layer peak thickness with its derivatives
+ *
+ * @param[in, out] pLayer F2 layer profile
+ */
+extern void F2_layer_get_peak_thickness_dual(F2_layer_dual_t* const pLayer);
+
 /** Get F2 layer peak amplitude see 2.5.5.8, Eq 90
  *
  * @param[in, out] pContext F2 layer profile context
  */
 extern void F2_layer_get_peak_amplitude(F2_layer_t* const pContext);
 
+/** Get F2 layer peak amplitude with its derivatives
+ *
+ * @param[in, out] pLayer F2 layer profile
+ */
+extern void F2_layer_get_peak_amplitude_dual(F2_layer_dual_t* const pLayer);
+
 /** Compute the topside thickness parameter H0 [km] see 2.5.5.11
  *
  * The topside of NeQuick is a semi-Epstein layer with a height dependent
@@ -118,4 +167,16 @@ extern void F2_layer_exosphere_adjust(
   const NeQuickG_time_t* const pTime,
   const solar_activity_t* const pSolar_activity);
 
+/** Compute the topside thickness parameter H0 [km] with its derivatives,
+ * see #F2_layer_exosphere_adjust
+ *
+ * @param[in, out] pLayer F2 layer profile
+ * @param[in] pTime indication of the time at which the profile is required
+ * @param[in] pSolar_activity solar activity with its derivatives
+ */
+extern void F2_layer_exosphere_adjust_dual(
+  F2_layer_dual_t* const pLayer,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_dual_t* const pSolar_activity);
+
 #endif // NEQUICK_G_JRC_IONO_F2_LAYER_H
@@ -67,8 +67,10 @@
 
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "NeQuickG_JRC.h"
 #include "NeQuickG_JRC_solar_activity.h"
 #include "NeQuickG_JRC_time.h"
 
@@ -112,8 +114,6 @@ typedef double_t Fm3_fourier_coefficient_array_t
  *  activity conditions.
  */
 typedef struct F2_layer_ionosonde_coefficients_st {
-  /** CCIR folder */
-  char* pFolder;
   /** Spherical harmonic coefficients for F2 loaded from the CCIR maps*/
   F2_coefficient_array_t F2
     [ITU_F2_LAYER_SOLAR_ACTIVITY_CONDITIONS_COUNT];
@@ -121,20 +121,41 @@ typedef struct F2_layer_ionosonde_coefficients_st {
   Fm3_coefficient_array_t Fm3
     [ITU_F2_LAYER_SOLAR_ACTIVITY_CONDITIONS_COUNT];
 } F2_layer_ionosonde_coefficients_t;
+
+/** CCIR maps used by a session */
+typedef struct F2_layer_ionosonde_context_st {
+  /** CCIR folder, owned by the shared model */
+  const char* pFolder;
+  /** coefficients of the 12 months, from January, owned by the shared
+   * model; NULL if they are loaded on a change of month
+   */
+  const F2_layer_ionosonde_coefficients_t* pMonths;
+  /** month of the coefficients in pLoaded, 0 if none */
+  uint8_t month;
+  /** coefficients of the month loaded from the CCIR folder,
+   * allocated by the first load, so never with pMonths
+   */
+  F2_layer_ionosonde_coefficients_t* pLoaded;
+} F2_layer_ionosonde_context_t;
 #endif // !FTR_MODIP_CCIR_AS_CONSTANTS
 
-/** Interpolated/extrapolated coefficients for the foF2 and M(3000)F2
- * for the solar activity.
+/** Fourier coefficients for the foF2 and M(3000)F2 of the low and high
+ * solar activity conditions.<br>
+ * The interpolation (or extrapolation) of the CCIR coefficients for the solar
+ * activity and the Fourier series in UT are both linear, so the series is
+ * summed once per month and UT for each condition, and the interpolation is
+ * done on the Fourier coefficients.
  */
-typedef struct F2_layer_interpolated_coefficients_st {
-  /** Interpolated/extrapolated coefficients for foF2 */
-  F2_coefficient_array_t F2;
-  /** Interpolated/extrapolated coefficients for M(3000)F2 */
-  Fm3_coefficient_array_t Fm3;
-  /** Effective sun spot number */
-  double_t effective_sun_spot_count;
+typedef struct F2_layer_projected_coefficients_st {
+  /** Fourier coefficients for foF2 */
+  F2_fourier_coefficient_array_t CF2
+    [ITU_F2_LAYER_SOLAR_ACTIVITY_CONDITIONS_COUNT];
+  /** Fourier coefficients for M(3000)F2 */
+  Fm3_fourier_coefficient_array_t Cm3
+    [ITU_F2_LAYER_SOLAR_ACTIVITY_CONDITIONS_COUNT];
+  /** Are the coefficients valid or must be recalculated? */
   bool valid;
-} F2_layer_interpolated_coefficients_t;
+} F2_layer_projected_coefficients_t;
 
 /** Fourier coefficients for the foF2 and M(3000)F2 */
 typedef struct F2_fourier_coefficients_st {
@@ -142,66 +163,138 @@ typedef struct F2_fourier_coefficients_st {
   F2_fourier_coefficient_array_t CF2;
   /** Fourier coefficients for M(3000)F2 */
   Fm3_fourier_coefficient_array_t Cm3;
+  /** Effective sun spot number */
+  double_t effective_sun_spot_count;
   /** Are the Fourier coefficients valid or must be recalculated? */
   bool valid;
 } F2_fourier_coefficients_t;
 
+/** Fourier coefficients for the foF2 and M(3000)F2 of a month and UT */
+typedef struct F2_fourier_cache_entry_st {
+  /** entry holds the coefficients of its key? */
+  bool is_valid;
+  /** cache clock at the last use */
+  uint64_t last_use;
+  /** month and UT */
+  NeQuickG_time_t time;
+  /** coefficients of the low and high solar activity conditions */
+  F2_layer_projected_coefficients_t projected;
+} F2_fourier_cache_entry_t;
+
+/** Fully associative cache of the Fourier coefficients,
+ * the least recently used entry is replaced first
+ */
+typedef struct F2_fourier_cache_st {
+  /** number of entries in use, 0 if the cache is disabled */
+  size_t entry_count;
+  /** incremented at each lookup */
+  uint64_t clock;
+  /** hits, misses and evictions since the cache was set */
+  NeQuickG_fourier_cache_statistics_t statistics;
+  /** entry_count entries allocated by
+   * #F2_layer_fourier_coefficients_set_cache, NULL if the cache is disabled
+   */
+  F2_fourier_cache_entry_t* pEntry;
+} F2_fourier_cache_t;
+
 /** F2 Fourier coefficients context */
 typedef struct F2_layer_fourier_coeff_context_st {
   /** indication of the time at which the Fourier coefficients are required */
   NeQuickG_time_t time;
 #ifndef FTR_MODIP_CCIR_AS_CONSTANTS
   /** Spherical harmonic coefficients from the CCIR maps */
-  F2_layer_ionosonde_coefficients_t ionosonde;
+  F2_layer_ionosonde_context_t ionosonde;
 #endif
-  /** Interpolated/extrapolated coefficients for the foF2 and M(3000)F2
-   * taking inti account the solar activity
+  /** Fourier coefficients for the foF2 and M(3000)F2 of the low and high
+   * solar activity conditions at the time
+   */
+  F2_layer_projected_coefficients_t projected;
+  /** F2 Fourier coefficients for the foF2 and M(3000)F2
+   * interpolated/extrapolated for the solar activity
    */
-  F2_layer_interpolated_coefficients_t interpolated;
-  /** F2 Fourier coefficients for the foF2 and M(3000)F2*/
   F2_fourier_coefficients_t fourier;
+  /** Fourier coefficients of the previous months and UTs */
+  F2_fourier_cache_t cache;
 } F2_layer_fourier_coeff_context_t;
 
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+/** Loads the coefficients of a month from the CCIR folder
+ *
+ * @param[in] pCCIR_folder CCIR folder
+ * @param[in] month [#NEQUICK_G_JRC_MONTH_JANUARY-#NEQUICK_G_JRC_MONTH_DECEMBER]
+ * @param[out] pCoeff coefficients of the month
+ * @return on success NEQUICK_OK
+ */
+extern int32_t F2_layer_fourier_coefficients_load(
+  const char* const pCCIR_folder,
+  const uint8_t month,
+  F2_layer_ionosonde_coefficients_t* const pCoeff);
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+
 #if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
-#define F2_layer_fourier_coefficients_init(pContext, pCCIR_folder) \
+#define F2_layer_fourier_coefficients_init( \
+  pContext, pCCIR_folder, pCCIR_months) \
   F2_layer_fourier_coefficients_init(pContext)
 #endif
 
 /** Initialize the Coefficients for the foF2 and M(3000)F2.
  *
  * @param[out] pContext F2 Fourier coefficients context
- * @param[in] pCCIR_folder CCIR folder
+ * @param[in] pCCIR_folder CCIR folder, it is not copied
+ *  so it must outlive the context
+ * @param[in] pCCIR_months coefficients of the 12 months, from January,
+ *  they are not copied so they must outlive the context;
+ *  NULL to load the coefficients of a month from the CCIR folder
  */
-extern int32_t F2_layer_fourier_coefficients_init(
+extern void F2_layer_fourier_coefficients_init(
   F2_layer_fourier_coeff_context_t* const pContext,
-  const char* const pCCIR_folder);
+  const char* const pCCIR_folder,
+  const F2_layer_ionosonde_coefficients_t* const pCCIR_months);
 
-#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
-#define F2_layer_fourier_coefficients_close(pContext)
-#else
-/** Free resources allocated bt the F2 Fourier coefficients context
+/** Free resources allocated by the F2 Fourier coefficients context
  * @param[in, out] pContext F2 Fourier coefficients context
  */
 extern void F2_layer_fourier_coefficients_close(
   F2_layer_fourier_coeff_context_t* const pContext);
-#endif
+
+/** Sets the number of entries of the Fourier coefficient cache,
+ * it is emptied and its statistics cleared.
+ * The entries are allocated on the heap, unless the number of entries is
+ * unchanged, 0 frees them.
+ *
+ * @param[in, out] pContext F2 Fourier coefficients context
+ * @param[in] entry_count number of entries, 0 to disable the cache,
+ *  at most #NEQUICKG_FOURIER_CACHE_ENTRY_COUNT_MAX
+ * @return on success NEQUICK_OK, the cache is left unchanged otherwise
+ */
+extern int32_t F2_layer_fourier_coefficients_set_cache(
+  F2_layer_fourier_coeff_context_t* const pContext,
+  const size_t entry_count);
 
 #ifdef FTR_UNIT_TEST
-/** Unit test for CF2 and Cm3
+/** Unit test for the CCIR coefficients interpolated/extrapolated for the
+ * solar activity (AF2 and Am3), the same interpolation as for CF2 and Cm3.
  * @param[in, out] pContext F2 Fourier coefficients context
  * @param[in] pTime time context
  * @param[in] Azr Effective sun spot number
+ * @param[out] AF2 interpolated/extrapolated coefficients for foF2
+ * @param[out] Am3 interpolated/extrapolated coefficients for M(3000)F2
  */
 extern int32_t F2_layer_fourier_coefficients_interpolate(
   F2_layer_fourier_coeff_context_t* const pContext,
   const NeQuickG_time_t * const pTime,
-  const double_t Azr);
+  const double_t Azr,
+  F2_coefficient_array_t AF2,
+  Fm3_coefficient_array_t Am3);
 #endif // FTR_UNIT_TEST
 
 /** Compute CF2, the array of interpolated coefficients for
  * foF2 and Cm3, the array of interpolated coefficients for
  * M(3000)F2.
- * See 2.5.5.3.2.
+ * See 2.5.5.3.2.<br>
+ * A change of solar activity only interpolates the Fourier coefficients of
+ * the low and high conditions. With the cache enabled, a change of month or
+ * UT looks up the cache first.
  *
  * @param[in, out] pContext F2 Fourier coefficients context
  * @param[in] pTime time context
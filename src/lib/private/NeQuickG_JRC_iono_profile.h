@@ -73,27 +73,39 @@ typedef struct iono_profile_st {
   F2_layer_t F2;
 } iono_profile_t;
 
+/** NeQuickG ionospheric profile with its derivatives with respect to
+ * Az and the location, see #NEQUICKG_DUAL_PARTIAL_AZ
+ */
+typedef struct iono_profile_dual_st {
+  /** E layer */
+  layer_dual_t E;
+  /** F1 layer */
+  layer_dual_t F1;
+  /** F2 layer */
+  F2_layer_dual_t F2;
+} iono_profile_dual_t;
+
 #if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
-#define iono_profile_init(pContext, pCCIR_folder) \
+#define iono_profile_init(pContext, pCCIR_folder, pCCIR_months) \
   iono_profile_init(pContext)
 #endif
 
 /** Initializes the ionospheric profile context
  * @param[out] pContext ionospheric profile context
- * @param[in] pCCIR_folder CCIR folder
+ * @param[in] pCCIR_folder CCIR folder, it must outlive the context
+ * @param[in] pCCIR_months coefficients of the 12 months, they must outlive
+ *  the context; NULL to load the coefficients of a month from the CCIR folder
  */
-extern int32_t iono_profile_init(
+extern void iono_profile_init(
   iono_profile_t* const pContext,
-  const char* const pCCIR_folder);
+  const char* const pCCIR_folder,
+  const F2_layer_ionosonde_coefficients_t* const pCCIR_months);
 
-#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
-#define iono_profile_close(pContext)
-#else
 /** Free resources allocated by the ionospheric profile context
  * @param[in, out] pContext ionospheric profile context
  */
-extern void iono_profile_close(iono_profile_t* const pContext);
-#endif
+extern void iono_profile_close(
+  iono_profile_t* const pContext);
 
 /** Get the ionospheric profile
  *
@@ -110,6 +122,42 @@ extern int32_t iono_profile_get(
   const solar_activity_t* const pSolar_activity,
   const position_t * const pCurrent_position);
 
+/** Get the ionospheric profile at a location whose MODIP is already
+ * in the MODIP context, i.e. #iono_profile_get without #modip_get
+ *
+ * @param[out] pContext ionospheric profile context
+ * @param[in] pTime indication of the time at which the profile is required
+ * @param[in] pModip MODIP context, holds the MODIP of the location
+ * @param[in] pSolar_activity solar activity
+ * @param[in] pCurrent_position location at which the profile is required
+ */
+extern int32_t iono_profile_get_at_modip(
+  iono_profile_t* const pContext,
+  const NeQuickG_time_t* const pTime,
+  const modip_context_t* const pModip,
+  const solar_activity_t* const pSolar_activity,
+  const position_t * const pCurrent_position);
+
+/** Get the ionospheric profile with its derivatives with respect to Az
+ * and the location (latitude, longitude), i.e. #iono_profile_get_at_modip
+ * propagating the derivatives (forward mode).
+ *
+ * @param[in, out] pContext ionospheric profile context, for the solar
+ *  declination and the Fourier coefficients
+ * @param[in] pTime indication of the time at which the profile is required
+ * @param[in] pModip_degree MODIP of the location, see #modip_get_dual
+ * @param[in] pSolar_activity solar activity
+ * @param[in] pCurrent_position location at which the profile is required
+ * @param[out] pProfile ionospheric profile with its derivatives
+ */
+extern int32_t iono_profile_get_dual(
+  iono_profile_t* const pContext,
+  const NeQuickG_time_t* const pTime,
+  const NeQuickG_dual_t* const pModip_degree,
+  const solar_activity_t* const pSolar_activity,
+  const position_t * const pCurrent_position,
+  iono_profile_dual_t* const pProfile);
+
 #ifdef FTR_UNIT_TEST
 /** Unit test for ionospheric profile
  * @param[in, out] pContext ionospheric profile context
@@ -15,6 +15,7 @@
 #include <stdbool.h>
 
 #include "NeQuickG_JRC_coordinates.h"
+#include "NeQuickG_JRC_math_utils.h"
 
 /** Thickness parameters: top and bottom */
 typedef struct thickness_st {
@@ -44,4 +45,32 @@ typedef struct layer_st {
   peak_t peak;
 } layer_t;
 
+/** Thickness parameters with their derivatives, see #thickness_t */
+typedef struct thickness_dual_st {
+  /** top [km] */
+  NeQuickG_dual_t top_km;
+  /** bottom [km] */
+  NeQuickG_dual_t bottom_km;
+} thickness_dual_t;
+
+/** Peak layer with its derivatives, see #peak_t */
+typedef struct peak_dual_st {
+  /** Amplitude for the Epstein function [in 10<SUP>11</SUP> m<SUP>-3</SUP>] */
+  NeQuickG_dual_t amplitude;
+  /** Height of the electron density peak [km]*/
+  NeQuickG_dual_t height_km;
+  /** Thickness parameters */
+  thickness_dual_t thickness;
+  /** electron density [in 10<SUP>11</SUP> m<SUP>-3</SUP>] */
+  NeQuickG_dual_t electron_density;
+} peak_dual_t;
+
+/** Generic ionospheric layer profile with its derivatives, see #layer_t */
+typedef struct layer_dual_st {
+  /** Critical frequency [MHz] */
+  NeQuickG_dual_t critical_frequency_MHz;
+  /** Peak layer */
+  peak_dual_t peak;
+} layer_dual_t;
+
 #endif // NEQUICK_G_JRC_IONO_PROFILE_TYPES_H
@@ -38,6 +38,13 @@
 #endif
 #endif
 
+/** Storage class of the per-thread state (see #NeQuickG_error_get_last) */
+#if defined(_MSC_VER)
+#define NEQUICK_G_THREAD_LOCAL __declspec(thread)
+#else
+#define NEQUICK_G_THREAD_LOCAL _Thread_local
+#endif
+
 #ifdef FTR_UNIT_TEST
 /** Print error message to stderr optionally preceding it with the custom message specified in _text.
  * @param[in] _text C string containing a custom message to be printed before the error message itself.
@@ -20,6 +20,28 @@
  */
 #define IS_ODD(_i) ((_i % 2) == 1)
 
+/** Number of partial derivatives of a #NeQuickG_dual_t */
+#define NEQUICKG_DUAL_PARTIAL_COUNT (4)
+
+/** Index of the partial derivatives in NeQuickG_dual_t.d:
+ * Effective Ionisation Level Az (sfu), latitude (degree),
+ * longitude (degree) and height (km) of the point the model is evaluated at
+ */
+#define NEQUICKG_DUAL_PARTIAL_AZ (0)
+#define NEQUICKG_DUAL_PARTIAL_LATITUDE (1)
+#define NEQUICKG_DUAL_PARTIAL_LONGITUDE (2)
+#define NEQUICKG_DUAL_PARTIAL_HEIGHT (3)
+
+/** Dual number: a value with its partial derivatives (forward mode),
+ * the operations below propagate the derivatives through the model
+ */
+typedef struct NeQuickG_dual_st {
+  /** value */
+  double_t value;
+  /** partial derivatives, see #NEQUICKG_DUAL_PARTIAL_AZ */
+  double_t d[NEQUICKG_DUAL_PARTIAL_COUNT];
+} NeQuickG_dual_t;
+
 /** A clipped exponential function always returns valid output.
  *  See F.2.12.2.
  *
@@ -83,4 +105,80 @@ extern double_t get_cos_from_sin(const double_t sin);
  */
 extern double_t get_sin_from_cos(const double_t cos);
 
+/** Dual number of a constant: all its derivatives are zero
+ *
+ * @param[in] value value
+ * @return dual number
+ */
+extern NeQuickG_dual_t NeQuickG_dual_constant(double_t value);
+
+/** Dual number of a variable: its derivative with respect to itself is one
+ *
+ * @param[in] value value
+ * @param[in] partial index of the variable, see #NEQUICKG_DUAL_PARTIAL_AZ
+ * @return dual number
+ */
+extern NeQuickG_dual_t NeQuickG_dual_variable(
+  double_t value,
+  size_t partial);
+
+/** @return a + b */
+extern NeQuickG_dual_t NeQuickG_dual_add(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b);
+
+/** @return a - b */
+extern NeQuickG_dual_t NeQuickG_dual_sub(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b);
+
+/** @return a * b */
+extern NeQuickG_dual_t NeQuickG_dual_mul(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b);
+
+/** @return a / b */
+extern NeQuickG_dual_t NeQuickG_dual_div(
+  const NeQuickG_dual_t a,
+  const NeQuickG_dual_t b);
+
+/** @return factor * a + offset */
+extern NeQuickG_dual_t NeQuickG_dual_linear(
+  const NeQuickG_dual_t a,
+  double_t factor,
+  double_t offset);
+
+/** @return a * a, see #NeQuickG_square */
+extern NeQuickG_dual_t NeQuickG_dual_square(const NeQuickG_dual_t a);
+
+/** @return square root of a */
+extern NeQuickG_dual_t NeQuickG_dual_sqrt(const NeQuickG_dual_t a);
+
+/** @return natural logarithm of a */
+extern NeQuickG_dual_t NeQuickG_dual_log(const NeQuickG_dual_t a);
+
+/** @return cosinus of a (radians) */
+extern NeQuickG_dual_t NeQuickG_dual_cos(const NeQuickG_dual_t a);
+
+/** Clipped exponential, see #NeQuickG_exp.
+ * The derivatives of a clipped value are zero.
+ *
+ * @param[in] power Power for exponential function
+ * @return Clipped exponential value
+ */
+extern NeQuickG_dual_t NeQuickG_dual_exp(const NeQuickG_dual_t power);
+
+/** Joins two functions, see #NeQuickG_func_join
+ *
+ * @param[in] func1 Input term for NeqJoin computation
+ * @param[in] func2 Input term for NeqJoin computation
+ * @param[in] alpha Input term for NeqJoin computation
+ * @param[in] x Input term for NeqJoin computation
+ */
+extern NeQuickG_dual_t NeQuickG_dual_func_join(
+  const NeQuickG_dual_t func1,
+  const NeQuickG_dual_t func2,
+  double_t alpha,
+  const NeQuickG_dual_t x);
+
 #endif // !NEQUICK_G_JRC_MATH_UTILS_H
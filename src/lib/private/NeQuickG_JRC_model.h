@@ -0,0 +1,80 @@
+/** NeQuick G shared model.
+ *
+ * The model holds the data tables that do not change once loaded:
+ *  - the MODIP grid (2.5.4.3)
+ *  - the location of the CCIR maps (2.5.5.3), and the maps of the 12 months
+ *    for a model shared by sessions (#NeQuickG_model_load_CCIR_months)<br>
+ *
+ * A model is read-only after #NeQuickG_model_init succeeds, therefore it can
+ * be shared by any number of sessions (see NeQuickG_JRC_context.h),
+ * including sessions running concurrently in different threads.
+ * The model must outlive every session that refers to it.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_MODEL_H
+#define NEQUICK_G_JRC_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC_iono_F2_layer_fourier_coefficients.h"
+#include "NeQuickG_JRC_MODIP_grid.h"
+
+/** NeQuick G shared model */
+typedef struct NeQuickG_model_st {
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+  /** modip grid loaded from file */
+  modip_grid_t modip_grid;
+  /** CCIR folder */
+  char* pCCIR_folder;
+  /** CCIR maps of the 12 months, from January,
+   * NULL if the sessions load the maps of a month on a change of month
+   */
+  F2_layer_ionosonde_coefficients_t* pCCIR_months;
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+  /** model data loaded i.e. is valid? */
+  bool is_loaded;
+} NeQuickG_model_t;
+
+#if defined(FTR_MODIP_CCIR_AS_CONSTANTS) && !defined(_doxygen)
+#define NeQuickG_model_init(pModel, pModip_file, pCCIR_folder) \
+  NeQuickG_model_init(pModel)
+#endif
+
+/** Loads the model data
+ *
+ * @param[out] pModel model
+ * @param[in] pModip_file modip grid file
+ * @param[in] pCCIR_folder CCIR folder
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_model_init(
+  NeQuickG_model_t* const pModel,
+  const char* const pModip_file,
+  const char* const pCCIR_folder);
+
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+/** Loads the CCIR maps of the 12 months in the model,
+ * before any session is opened on it
+ *
+ * @param[in, out] pModel model, loaded by #NeQuickG_model_init
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_model_load_CCIR_months(
+  NeQuickG_model_t* const pModel);
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+
+/** Free resources allocated by the model
+ * @param[in, out] pModel model
+ */
+extern void NeQuickG_model_close(
+  NeQuickG_model_t* const pModel);
+
+#endif // NEQUICK_G_JRC_MODEL_H
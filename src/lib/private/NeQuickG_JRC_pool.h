@@ -0,0 +1,82 @@
+/** NeQuickG pool of sessions.
+ *
+ * A fixed number of sessions opened on the same shared model
+ * (see NeQuickG_JRC_model.h), allocated once when the pool is created.<br>
+ * A long running service acquires a session per request and releases it
+ * when done: acquire and release only move an index on a free stack under
+ * a lock, nothing is allocated on the request path.
+ * A released session is reset (#NeQuickG_context_reset) and keeps its
+ * warm caches for the next request.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_POOL_H
+#define NEQUICK_G_JRC_POOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC_context.h"
+
+/** Pool of sessions */
+typedef struct NeQuickG_pool_st {
+  /** protects the free stack and the acquired flags */
+  pthread_mutex_t lock;
+  /** number of sessions */
+  size_t session_count;
+  /** the sessions */
+  NeQuickG_context_t* pSessions;
+  /** session is acquired? one flag per session */
+  bool* pIs_acquired;
+  /** indexes of the free sessions */
+  size_t* pFree;
+  /** number of free sessions */
+  size_t free_count;
+} NeQuickG_pool_t;
+
+/** Creates the sessions, see #NeQuickG_library.pool_init
+ *
+ * @param[out] pPool pool
+ * @param[in] pModel shared model, it must outlive the pool
+ * @param[in] session_count number of sessions, at least 1
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_pool_init(
+  NeQuickG_pool_t* const pPool,
+  const NeQuickG_model_t* const pModel,
+  size_t session_count);
+
+/** Frees the sessions
+ * @param[in, out] pPool pool
+ */
+extern void NeQuickG_pool_close(
+  NeQuickG_pool_t* const pPool);
+
+/** Takes a free session, see #NeQuickG_library.pool_acquire
+ *
+ * @param[in, out] pPool pool
+ * @param[out] ppContext the session
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_pool_acquire(
+  NeQuickG_pool_t* const pPool,
+  NeQuickG_context_t** const ppContext);
+
+/** Resets a session and gives it back, see #NeQuickG_library.pool_release
+ *
+ * @param[in, out] pPool pool
+ * @param[in, out] pContext a session acquired from the pool
+ * @return on success NEQUICK_OK
+ */
+extern int32_t NeQuickG_pool_release(
+  NeQuickG_pool_t* const pPool,
+  NeQuickG_context_t* const pContext);
+
+#endif // NEQUICK_G_JRC_POOL_H
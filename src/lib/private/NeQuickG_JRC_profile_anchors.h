@@ -0,0 +1,116 @@
+/** NeQuickG layer peaks interpolated along a slant ray.
+ *
+ * The layer peaks (heights, thicknesses and amplitudes of the E, F1 and F2
+ * layers) follow the foF2, M(3000)F2 and foE maps along the horizontal
+ * track of the ray, which change slowly between the integration nodes.
+ * With NeQuickG_integration_settings_t.profile_anchor_count anchors, the
+ * ionospheric profile is computed only at the anchors and the peaks of a
+ * node are the interpolating polynomial of the anchors (barycentric
+ * formula), kept between the extremes of the anchors.<br>
+ * The anchors are the Chebyshev-Gauss-Lobatto points of the integrated part
+ * of the ray in the logarithm of the slant distance from its start: the
+ * interpolation is well conditioned, and most anchors are in the first few
+ * thousand km, where the electron density is.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_PROFILE_ANCHORS_H
+#define NEQUICK_G_JRC_PROFILE_ANCHORS_H
+
+#include <math.h>
+#include <stddef.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_iono_profile_types.h"
+
+/** Layers with a peak: E, F1 and F2 */
+#define NEQUICK_G_JRC_PROFILE_ANCHORS_LAYER_COUNT (3)
+
+/** Layer peaks at the anchors of a slant ray */
+typedef struct profile_anchors_st {
+  /** number of anchors, 0 if the peaks are not interpolated */
+  size_t count;
+  /** slant distance of the start of the integrated part of the ray (km) */
+  double_t start_km;
+  /** slant distance of the end of the integrated part of the ray (km) */
+  double_t end_km;
+  /** slant distance of the anchors (km) */
+  double_t point_km[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  /** interpolation coordinate of the anchors */
+  double_t coordinate[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  /** barycentric weights of the anchors */
+  double_t weight[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  /** E layer peak at the anchors */
+  peak_t E_peak[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  /** F1 layer peak at the anchors */
+  peak_t F1_peak[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  /** F2 layer peak at the anchors, after the exosphere adjustment */
+  peak_t F2_peak[NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX];
+  /** smallest parameters of the E, F1 and F2 peaks of the anchors */
+  peak_t peak_min[NEQUICK_G_JRC_PROFILE_ANCHORS_LAYER_COUNT];
+  /** largest parameters of the E, F1 and F2 peaks of the anchors */
+  peak_t peak_max[NEQUICK_G_JRC_PROFILE_ANCHORS_LAYER_COUNT];
+} profile_anchors_t;
+
+/** The peaks are not interpolated
+ *
+ * @param[out] pAnchors anchors
+ */
+extern void profile_anchors_init(
+  profile_anchors_t* const pAnchors);
+
+/** Sets the anchor points of a part of a ray,
+ * the caller sets the peaks of every anchor (#profile_anchors_set_peaks)
+ *
+ * @param[out] pAnchors anchors
+ * @param[in] count number of anchors, between
+ *  #NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN and
+ *  #NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX
+ * @param[in] start_km slant distance of the start of the part (km)
+ * @param[in] end_km slant distance of the end of the part (km),
+ *  above start_km
+ */
+extern void profile_anchors_set_points(
+  profile_anchors_t* const pAnchors,
+  const size_t count,
+  const double_t start_km,
+  const double_t end_km);
+
+/** Sets the peaks of an anchor
+ *
+ * @param[in, out] pAnchors anchors
+ * @param[in] index anchor, the anchors are set in ascending order from 0
+ * @param[in] pE_peak E layer peak
+ * @param[in] pF1_peak F1 layer peak
+ * @param[in] pF2_peak F2 layer peak
+ */
+extern void profile_anchors_set_peaks(
+  profile_anchors_t* const pAnchors,
+  const size_t index,
+  const peak_t* const pE_peak,
+  const peak_t* const pF1_peak,
+  const peak_t* const pF2_peak);
+
+/** Interpolates the peaks of the anchors at a point of the ray,
+ * a point outside of the anchors gets the peaks of the nearest end
+ *
+ * @param[in] pAnchors anchors
+ * @param[in] point_km slant distance of the point (km)
+ * @param[out] pE_peak E layer peak
+ * @param[out] pF1_peak F1 layer peak
+ * @param[out] pF2_peak F2 layer peak
+ */
+extern void profile_anchors_get_peaks(
+  const profile_anchors_t* const pAnchors,
+  const double_t point_km,
+  peak_t* const pE_peak,
+  peak_t* const pF1_peak,
+  peak_t* const pF2_peak);
+
+#endif // NEQUICK_G_JRC_PROFILE_ANCHORS_H
@@ -0,0 +1,208 @@
+/** NeQuickG profile cache of a session.
+ *
+ * Along a slant ray every node of the Kronrod G<SUB>7</SUB>-K<SUB>15</SUB>
+ * integration needs the ionospheric profile at its location (MODIP,
+ * critical frequencies, Legendre expansion, peak heights, thicknesses and
+ * amplitudes), while only the E, F1 and F2 layer peaks are used for the
+ * electron density. The nodes of neighbouring sub-intervals, and of the
+ * rays of neighbouring satellites, are often a few km apart.<br>
+ *
+ * The cache keeps the layer peaks per location, for the time and the
+ * Effective Ionisation Level they were computed with:
+ *  - with a quantum of 0 the location is the exact node position, a node
+ *    at the same position gets the same peaks bit for bit,
+ *  - otherwise the locations are the corners of a grid of quantum x quantum
+ *    degrees, and the peaks of a node are interpolated bilinearly between
+ *    the four corners of its cell. The peaks are continuous along the ray,
+ *    so the adaptive integration does not refine at the cell edges, and
+ *    they do not depend on the nodes that filled the cache.<br>
+ *
+ * The cache is set-associative: a location always goes to the same set of
+ * #NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT entries, the least recently used
+ * entry of the set is replaced first. The sets are allocated on the heap
+ * when the cache is enabled and freed when it is disabled.
+ *
+ * @author Angela Aragon-Angel (maria-angeles.aragon@ec.europa.eu)
+ * @ingroup NeQuickG_JRC
+ * @copyright Joint Research Centre (JRC), 2019<br>
+ *  This software has been released as free and open source software
+ *  under the terms of the European Union Public Licence (EUPL), version 1.<br>
+ *  Questions? Submit your query at https://www.gsc-europa.eu/contact-us/helpdesk
+ * @file
+ */
+#ifndef NEQUICK_G_JRC_PROFILE_CACHE_H
+#define NEQUICK_G_JRC_PROFILE_CACHE_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_coordinates.h"
+#include "NeQuickG_JRC_iono_profile_types.h"
+#include "NeQuickG_JRC_solar_activity.h"
+#include "NeQuickG_JRC_time.h"
+
+/** Number of entries per set of the profile cache */
+#define NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT (4)
+/** Number of corners of a cell */
+#define NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT (4)
+
+/** Key of a profile cache entry */
+typedef struct profile_cache_key_st {
+  /** latitude grid index, or bits of the sinus of the latitude
+   * with a quantum of 0
+   */
+  uint64_t latitude;
+  /** longitude grid index, or bits of the longitude in radians
+   * with a quantum of 0
+   */
+  uint64_t longitude;
+  /** UT in hours */
+  double_t UTC;
+  /** Effective Ionisation Level (Az) in sfu */
+  double_t Az_sfu;
+  /** month */
+  uint8_t month;
+} profile_cache_key_t;
+
+/** Profile cache entry: the layer peaks at a location */
+typedef struct profile_cache_entry_st {
+  /** entry holds the peaks of its key? */
+  bool is_valid;
+  /** cache clock at the last use */
+  uint64_t last_use;
+  /** location, time and solar activity of the peaks */
+  profile_cache_key_t key;
+  /** E layer peak */
+  peak_t E_peak;
+  /** F1 layer peak */
+  peak_t F1_peak;
+  /** F2 layer peak, after the exosphere adjustment */
+  peak_t F2_peak;
+} profile_cache_entry_t;
+
+/** Locations of the cache a node needs */
+typedef struct profile_cache_cell_st {
+  /** keys of the corners of the cell: south-west, north-west, south-east,
+   * north-east; with a quantum of 0 only the first one, the node position
+   */
+  profile_cache_key_t key[NEQUICK_G_JRC_PROFILE_CACHE_CORNER_COUNT];
+  /** number of keys */
+  size_t key_count;
+  /** position of the node in the cell from south (0) to north (1) */
+  double_t latitude_fraction;
+  /** position of the node in the cell from west (0) to east (1) */
+  double_t longitude_fraction;
+} profile_cache_cell_t;
+
+/** Profile cache of a session */
+typedef struct profile_cache_st {
+  /** the nodes of the slant rays use the cache? */
+  bool is_enabled;
+  /** cell size in degrees, 0 for exact positions */
+  double_t quantum_degree;
+  /** incremented at each lookup */
+  uint64_t clock;
+  /** hits, misses and evictions since the cache was set */
+  NeQuickG_profile_cache_statistics_t statistics;
+  /** number of sets, 0 if the cache is disabled */
+  size_t set_count;
+  /** set_count x #NEQUICK_G_JRC_PROFILE_CACHE_WAY_COUNT entries,
+   * NULL if the cache is disabled
+   */
+  profile_cache_entry_t* pEntry;
+} profile_cache_t;
+
+/** Disables the cache, nothing is allocated
+ *
+ * @param[out] pCache profile cache
+ */
+extern void profile_cache_init(
+  profile_cache_t* const pCache);
+
+/** Enables or disables the cache, it is emptied and its statistics cleared.
+ * Enabling allocates the entries, unless the set count is unchanged,
+ * disabling frees them.
+ *
+ * @param[in, out] pCache profile cache
+ * @param[in] is_enabled enable the cache?
+ * @param[in] quantum_degree cell size in degrees, 0 for exact positions,
+ *  at most #NEQUICKG_PROFILE_CACHE_QUANTUM_MAX_DEGREE
+ * @param[in] set_count number of sets, between 1 and
+ *  #NEQUICKG_PROFILE_CACHE_SET_COUNT_MAX; ignored to disable the cache
+ * @return on success NEQUICK_OK, the cache is left unchanged otherwise
+ */
+extern int32_t profile_cache_set(
+  profile_cache_t* const pCache,
+  const bool is_enabled,
+  const double_t quantum_degree,
+  const size_t set_count);
+
+/** Gets the locations of the cache a node needs
+ *
+ * @param[in] pCache profile cache
+ * @param[in] pPosition node position
+ * @param[in] pTime time
+ * @param[in] pSolar_activity solar activity
+ * @param[out] pCell corners of the cell of the node
+ */
+extern void profile_cache_get_cell(
+  const profile_cache_t* const pCache,
+  const position_t* const pPosition,
+  const NeQuickG_time_t* const pTime,
+  const solar_activity_t* const pSolar_activity,
+  profile_cache_cell_t* const pCell);
+
+/** Gets the position the peaks of a key are computed at:
+ * the corner of the grid, or the node itself with a quantum of 0
+ *
+ * @param[in] pCache profile cache
+ * @param[in] pKey key
+ * @param[in] pPosition node position
+ * @param[out] pKey_position position of the peaks
+ */
+extern void profile_cache_get_position(
+  const profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey,
+  const position_t* const pPosition,
+  position_t* const pKey_position);
+
+/** Looks up a key, the lookup is counted as a hit or a miss
+ *
+ * @param[in, out] pCache profile cache
+ * @param[in] pKey key
+ * @return the entry of the key, NULL if it is not in the cache
+ */
+extern const profile_cache_entry_t* profile_cache_find(
+  profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey);
+
+/** Adds a key in place of the least recently used entry of its set,
+ * the caller fills the peaks
+ *
+ * @param[in, out] pCache profile cache
+ * @param[in] pKey key
+ * @return the entry of the key
+ */
+extern profile_cache_entry_t* profile_cache_add(
+  profile_cache_t* const pCache,
+  const profile_cache_key_t* const pKey);
+
+/** Gets the peaks of a node from the entries of the corners of its cell
+ *
+ * @param[in] pCell corners of the cell of the node
+ * @param[in] pCorner entries of the pCell->key_count corners
+ * @param[out] pE_peak E layer peak
+ * @param[out] pF1_peak F1 layer peak
+ * @param[out] pF2_peak F2 layer peak
+ */
+extern void profile_cache_get_peaks(
+  const profile_cache_cell_t* const pCell,
+  const profile_cache_entry_t* const * const pCorner,
+  peak_t* const pE_peak,
+  peak_t* const pF1_peak,
+  peak_t* const pF2_peak);
+
+#endif // NEQUICK_G_JRC_PROFILE_CACHE_H
@@ -67,6 +67,19 @@ extern int32_t ray_get(
   const position_t * const pStation_position,
   const position_t * const pSatellite_position);
 
+/** Sets a vertical ray without checking the positions,
+ * the satellite is assumed to be above the receiver.
+ *
+ * @param[in, out] pContext ray context
+ * @param[in] pStation_position Positional information for receiver
+ * @param[in] pSatellite_position Positional information for satellite,
+ *  only the height is used
+ */
+extern void ray_get_vertical(
+  ray_context_t* const pContext,
+  const position_t * const pStation_position,
+  const position_t * const pSatellite_position);
+
 /** Retusn slant distance from a point to the perigee radius.
  * See F.2.3.1.
  *
@@ -15,6 +15,12 @@
 
 #include "NeQuickG_JRC_context.h"
 
+/** Maximum number of nodes evaluated at once,
+ * the nodes added by the 63 points Patterson rule
+ * (see #Gauss_Kronrod_Patterson_integrate)
+ */
+#define NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX (32)
+
 /** This function returns electron density at the specified point along a slanted ray.
  * See F.2.8.1.<br>
  * - Adjusts position information for current position along ray
@@ -32,4 +38,79 @@ extern int32_t ray_slant_get_electron_density(
   const double_t height_km,
   double_t* const pElectron_density);
 
+/** Electron density at several points along a slanted ray,
+ * e.g. the nodes of a Kronrod segment.
+ * Same result as #ray_slant_get_electron_density for every point, but the
+ * work is staged over all the points before moving to the next step:
+ * - positions along the ray
+ * - MODIP (#modip_get)
+ * - ionosphere information (#iono_profile_get_at_modip), or the layer peaks
+ *   from the profile cache or interpolated between the profile anchors
+ * - electron density (#electron_density_get)
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] pHeight_km Distance of the points along the ray in km, count elements
+ * @param[in] count Number of points, up to #NEQUICK_G_JRC_RAY_SLANT_NODE_COUNT_MAX
+ * @param[out] pElectron_density N<SUB>e</SUB> per point in electrons/m<SUP>3</SUP>
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t ray_slant_get_electron_densities(
+  NeQuickG_context_t* const pContext,
+  const double_t* const pHeight_km,
+  const size_t count,
+  double_t* const pElectron_density);
+
+/** Electron density at a point along a slanted ray with its derivatives
+ * with respect to Az and the latitude, longitude and height of the point
+ * (#iono_profile_get_dual and #electron_density_get_dual).
+ * The model is always evaluated at the point, neither the profile cache
+ * nor the profile anchors are used.
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] height_km Distance of the point along the ray in km
+ * @param[out] pPosition position of the point
+ * @param[out] pElectron_density N<SUB>e</SUB> in electrons/m<SUP>3</SUP>
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t ray_slant_get_electron_density_dual(
+  NeQuickG_context_t* const pContext,
+  const double_t height_km,
+  position_t* const pPosition,
+  NeQuickG_dual_t* const pElectron_density);
+
+/** Computes the layer peaks at the anchors of a part of a slanted ray,
+ * the peaks of the nodes are then interpolated between them
+ * (see #profile_anchors_get_peaks) until NeQuickG_context_t.profile_anchors
+ * is cleared
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] count Number of anchors, between
+ *  #NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN and
+ *  #NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX
+ * @param[in] start_km Distance of the start of the part along the ray in km
+ * @param[in] end_km Distance of the end of the part along the ray in km
+ *
+ * @return on success NEQUICK_OK, the peaks of the nodes are not interpolated
+ *  otherwise
+ */
+extern int32_t ray_slant_set_profile_anchors(
+  NeQuickG_context_t* const pContext,
+  const size_t count,
+  const double_t start_km,
+  const double_t end_km);
+
+/** Recalculates ionosphere information at a point along a slanted ray,
+ * e.g. to get the layer peak heights there (#iono_profile_get)
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] height_km Distance of the point along the ray in km
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t ray_slant_get_profile(
+  NeQuickG_context_t* const pContext,
+  const double_t height_km);
+
 #endif // NEQUICK_G_JRC_RAY_SLANT_H
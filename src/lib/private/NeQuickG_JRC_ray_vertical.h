@@ -25,6 +25,19 @@
  */
 extern int32_t ray_vertical_get_profile(NeQuickG_context_t* const pContext);
 
+/** Ionosphere information for a vertical ray with its derivatives with
+ * respect to Az and the latitude and longitude of the ray
+ * (#iono_profile_get_dual)
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[out] pProfile ionospheric profile with its derivatives
+ *
+ * @return on success NEQUICK_OK
+ */
+extern int32_t ray_vertical_get_profile_dual(
+  NeQuickG_context_t* const pContext,
+  iono_profile_dual_t* const pProfile);
+
 /** This function returns electron density at a specified point along a vertical ray.
  * See F.2.7.1.<br>
  * - Gets the electron density with a call to #electron_density_get
@@ -38,4 +51,19 @@ extern double_t ray_vertical_get_electron_density(
   NeQuickG_context_t* const pContext,
   const double_t height_km);
 
+/** This function returns the electron density integrated along a vertical
+ * ray between two heights, with the semi-analytic #electron_density_get_integral
+ * (no adaptive quadrature).
+ *
+ * @param[in, out] pContext NeQuick context
+ * @param[in] height_1_km bottom height in km
+ * @param[in] height_2_km top height in km
+ *
+ * @return integral of N<SUB>e</SUB> in km/m<SUP>3</SUP>
+ */
+extern double_t ray_vertical_get_integral(
+  NeQuickG_context_t* const pContext,
+  const double_t height_1_km,
+  const double_t height_2_km);
+
 #endif // NEQUICK_G_JRC_RAY_VERTICAL_H
@@ -15,6 +15,7 @@
 
 #include "NeQuickG_JRC_coordinates.h"
 #include "NeQuickG_JRC_geometry.h"
+#include "NeQuickG_JRC_math_utils.h"
 #include "NeQuickG_JRC_time.h"
 
 /** Get solar declination &delta;<SUB>sun</SUB>, see 2.5.4.6.
@@ -40,6 +41,20 @@ extern double_t solar_get_effective_zenith_angle(
   const NeQuickG_time_t * const pTime,
   const angle_restricted_t* const pSolar_declination);
 
+/** Get solar effective zenith angle in degrees with its derivatives
+ * with respect to the latitude and the longitude (degree),
+ * see #solar_get_effective_zenith_angle
+ *
+ * @param[in] pPosition latitude and longitude in degrees
+ * @param[in] pTime Universal Time
+ * @param[in] pSolar_declination sin(&delta;<SUB>sun</SUB>), cos(&delta;<SUB>sun</SUB>)
+ * @return solar effective zenith angle &chi;<SUB>eff</SUB> in degrees
+ */
+extern NeQuickG_dual_t solar_get_effective_zenith_angle_dual(
+  const position_t* const pPosition,
+  const NeQuickG_time_t * const pTime,
+  const angle_restricted_t* const pSolar_declination);
+
 /** Get solar longitude in radians Eq. 49
  * @param[in] pTime Universal Time
  * @return solar longitude in radians
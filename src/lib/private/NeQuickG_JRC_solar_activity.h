@@ -31,6 +31,7 @@
 
 #include "ITU_R_P_371_8.h"
 #include "NeQuickG_JRC.h"
+#include "NeQuickG_JRC_math_utils.h"
 #include "NeQuickG_JRC_MODIP.h"
 
 /** 3.3 The operational range for the Effective Ionisation Parameter is between 0
@@ -59,6 +60,14 @@ typedef struct solar_activity_st {
   double_t effective_sun_spot_count;
 } solar_activity_t;
 
+/** solar activity with its derivatives with respect to Az */
+typedef struct solar_activity_dual_st {
+  /** Effective Ionisation Level (Az) in sfu */
+  NeQuickG_dual_t effective_ionisation_level_sfu;
+  /** Effective sun spot count */
+  NeQuickG_dual_t effective_sun_spot_count;
+} solar_activity_dual_t;
+
 /** Set the AZ coefficients in the context
  *
  * @param[in, out] pSolar_activity solar activity context
@@ -85,6 +94,46 @@ extern void solar_activity_get(
   solar_activity_t* const pContext,
   double_t modip_degrees);
 
+/** Gets the Effective Ionisation Level Az, already computed by
+ * #solar_activity_get, as the variable of the #NEQUICKG_DUAL_PARTIAL_AZ
+ * partial derivatives, and the effective sun spot count with its derivative.
+ *
+ * @param[in] pContext solar activity context
+ * @param[out] pDual solar activity with its derivatives
+ */
+extern void solar_activity_get_dual(
+  const solar_activity_t* const pContext,
+  solar_activity_dual_t* const pDual);
+
+/** Gets the partial derivatives of the Effective Ionisation Level Az with
+ * respect to the coefficients (a<SUB>0</SUB>, a<SUB>1</SUB>, a<SUB>2</SUB>):
+ * (1, MODIP, MODIP<SUP>2</SUP>).<br>
+ * They are zero when the coefficients are not used (default Az)
+ * or Az is out of the operational range.
+ *
+ * @param[in] pContext solar activity context with ionospheric coefficients
+ * @param[in] modip_degrees MODIP in degrees
+ * @param[out] pGradient #NEQUICKG_AZ_COEFFICIENTS_COUNT derivatives,
+ *  units: 1, deg, deg<SUP>2</SUP>
+ */
+extern void solar_activity_get_effective_ionisation_level_gradient(
+  const solar_activity_t* const pContext,
+  double_t modip_degrees,
+  double_t* const pGradient);
+
+/** Gets the derivative of the Effective Ionisation Level Az with
+ * respect to MODIP: ai<SUB>1</SUB> + 2ai<SUB>2</SUB>*MODIP.<br>
+ * It is zero when the coefficients are not used (default Az)
+ * or Az is out of the operational range.
+ *
+ * @param[in] pContext solar activity context with ionospheric coefficients
+ * @param[in] modip_degrees MODIP in degrees
+ * @return derivative in sfu/deg
+ */
+extern double_t solar_activity_get_effective_ionisation_level_modip_derivative(
+  const solar_activity_t* const pContext,
+  double_t modip_degrees);
+
 /** Compares two values of the effective Ionisation Level Az using a threshold based comparison approach
  * Threshold used is #NEQUICK_G_AZ_EQUALITY_EPSILON
  *
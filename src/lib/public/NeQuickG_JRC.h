@@ -20,9 +20,55 @@
  *       - satellite position (#NeQuickG_library.set_satellite_position)<br>
  *
  *    - Get the Slant Total Electron Content (STEC) in TECU (#NeQuickG_library.get_total_electron_content)
+ *      or, for all the satellites tracked by the receiver at the epoch,
+ *      (#NeQuickG_library.get_total_electron_content_epoch)
+ *      or, for a link tracked over consecutive epochs,
+ *      (#NeQuickG_library.get_total_electron_content_link)
+ *      or per height shell (#NeQuickG_library.get_total_electron_content_partial)
+ *
+ *    - Get the Vertical Total Electron Content (VTEC) in TECU above a location
+ *      (#NeQuickG_library.get_vertical_total_electron_content)
+ *
+ *    - Get the electron density at many heights above a location
+ *      (#NeQuickG_library.get_electron_density_profile)
  *
  *    - Free resources (#NeQuickG_library.close)
  *
+ *  <h3>Shared model and sessions:</h3>
+ *    A handle returned by #NeQuickG_library.init owns its own copy of the model data.
+ *    When many handles are needed (e.g. one per worker thread), load the model once
+ *    (#NeQuickG_library.model_init) and open as many sessions as required on it
+ *    (#NeQuickG_library.session_init). A session is a regular NequickG JRC handle.<br>
+ *    The model is read-only once loaded and can be shared by sessions used
+ *    concurrently from different threads. A session holds the per-query state and
+ *    must not be used by more than one thread at a time.
+ *    Close every session (#NeQuickG_library.close) before the model
+ *    (#NeQuickG_library.model_close).<br>
+ *    The model also holds the CCIR maps of the 12 months, so its sessions carry
+ *    no copy of them and never read the CCIR files.<br>
+ *    A long running service can keep a pool of warm sessions
+ *    (#NeQuickG_library.pool_init) and acquire one per request
+ *    (#NeQuickG_library.pool_acquire, #NeQuickG_library.pool_release)
+ *    without any allocation on the request path.
+ *
+ *  <h3>Thread safety:</h3>
+ *    The library is reentrant: it has no mutable global state other than the
+ *    last error, which is thread-local (#NeQuickG_library.get_last_error).
+ *    - the #NeQuickG interface is constant and can be used from any thread.<br>
+ *    - a shared model is immutable once #NeQuickG_library.model_init returns:
+ *      any number of threads can open sessions on it and evaluate them
+ *      concurrently.<br>
+ *    - a handle (session) caches the per-query state (MODIP, Fourier coefficients,
+ *      solar declination, layer profile) and is modified by every call, including
+ *      the getters: it must be used by one thread at a time. A handle can move
+ *      from one thread to another if the caller serializes the calls.<br>
+ *    - an executor (#NeQuickG_library.executor_init) evaluates one batch at a time,
+ *      its threads own their sessions.<br>
+ *    - a pool of sessions (#NeQuickG_library.pool_init) can be shared by any number
+ *      of threads: a session acquired from it belongs to the caller until released.<br>
+ *    - the errors are logged to the standard error with one fprintf per line,
+ *      lines from concurrent threads may interleave.
+ *
  * The STEC integration routine used in this implementation is the method based on
  * Kronrod G<SUB>7</SUB>-K<SUB>15</SUB> adaptive quadrature with the default tolerances defined in the specification.
  * See section F.2.6.<br>
@@ -70,6 +116,84 @@
  */
 #define NEQUICKG_TIME_PARAMETERS_COUNT (2)
 
+/** Galileo E1 carrier frequency (Hz) */
+#define NEQUICKG_FREQUENCY_E1_HZ (1575.42e6)
+/** Galileo E5a carrier frequency (Hz) */
+#define NEQUICKG_FREQUENCY_E5A_HZ (1176.45e6)
+/** Galileo E5b carrier frequency (Hz) */
+#define NEQUICKG_FREQUENCY_E5B_HZ (1207.14e6)
+/** Galileo E6 carrier frequency (Hz) */
+#define NEQUICKG_FREQUENCY_E6_HZ (1278.75e6)
+
+/** Integration method: recursive Kronrod G<SUB>7</SUB>-K<SUB>15</SUB>
+ * adaptive quadrature of the specification (F.2.6.1), the default
+ */
+#define NEQUICKG_INTEGRATION_RECURSIVE (0)
+/** Integration method: global adaptive Kronrod G<SUB>7</SUB>-K<SUB>15</SUB>
+ * quadrature, the sub-interval with the largest error is split first
+ */
+#define NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE (1)
+/** Integration method: recursive Kronrod G<SUB>7</SUB>-K<SUB>15</SUB>
+ * quadrature extended with the nested Patterson rules (31 and 63 points)
+ * before a segment is split
+ */
+#define NEQUICKG_INTEGRATION_PATTERSON (2)
+
+/** Integration preset: the breakpoints, tolerances and recursion limit
+ * of the specification (F.2.3.3), the default
+ */
+#define NEQUICKG_INTEGRATION_PRESET_SPECIFICATION (0)
+/** Integration preset: looser tolerances and a shallower recursion
+ * for real-time positioning
+ */
+#define NEQUICKG_INTEGRATION_PRESET_NAVIGATION (1)
+/** Integration preset: tighter tolerances for validation */
+#define NEQUICKG_INTEGRATION_PRESET_REFERENCE (2)
+
+/** Smallest evaluation budget, see
+ * NeQuickG_integration_settings_t.evaluation_max: enough for the first
+ * G<SUB>7</SUB>-K<SUB>15</SUB> rule of every segment of a ray
+ */
+#define NEQUICKG_INTEGRATION_EVALUATION_BUDGET_MIN (96)
+
+/** Smallest and largest number of anchors of the layer peaks along a slant
+ * ray, see NeQuickG_integration_settings_t.profile_anchor_count
+ */
+#define NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN (3)
+#define NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX (32)
+
+/** Kronrod G7-K15 integration maximum recursion level,
+ * see NeQuickG_integration_settings_t.recursion_max
+ */
+#define NEQUICK_G_JRC_RECURSION_LIMIT_MAX (50)
+
+/** Maximum number of shell boundaries, see NeQuickG_TEC_partial_t */
+#define NEQUICKG_TEC_SHELL_BOUNDARY_COUNT_MAX (8)
+/** Maximum number of points of the cumulative profile,
+ * see NeQuickG_TEC_partial_t
+ */
+#define NEQUICKG_TEC_CUMULATIVE_POINT_COUNT_MAX (32)
+
+/** Largest cell of the profile cache (degrees),
+ * see #NeQuickG_library.set_profile_cache
+ */
+#define NEQUICKG_PROFILE_CACHE_QUANTUM_MAX_DEGREE (1.0)
+
+/** Number of sets of the profile cache for a few rays (1024 locations,
+ * about 180 KB), see #NeQuickG_library.set_profile_cache
+ */
+#define NEQUICKG_PROFILE_CACHE_SET_COUNT_DEFAULT (256)
+
+/** Largest number of sets of the profile cache,
+ * see #NeQuickG_library.set_profile_cache
+ */
+#define NEQUICKG_PROFILE_CACHE_SET_COUNT_MAX (16384)
+
+/** Largest number of entries of the Fourier coefficient cache,
+ * see #NeQuickG_library.set_fourier_cache
+ */
+#define NEQUICKG_FOURIER_CACHE_ENTRY_COUNT_MAX (32)
+
 /** NeQuick success */
 #define NEQUICK_OK 0
 
@@ -79,12 +203,284 @@ typedef void* NeQuickG_handle;
 /** NequickG JRC constant handle */
 typedef const void* const NeQuickG_chandle;
 
+/** NequickG JRC shared model handle */
+typedef void* NeQuickG_model_handle;
+
+/** NequickG JRC constant shared model handle */
+typedef const void* const NeQuickG_model_chandle;
+
+/** NequickG JRC parallel executor handle */
+typedef void* NeQuickG_executor_handle;
+
+/** NequickG JRC pool of sessions handle */
+typedef void* NeQuickG_pool_handle;
+
+/** Batch of receiver-satellite links given as a structure of arrays.
+ * Each array has #NeQuickG_links_t.count elements, the i-th link is
+ * made of the i-th element of every array.<br>
+ * Time and positions follow the units and ranges of
+ * #NeQuickG_library.set_time, #NeQuickG_library.set_receiver_position and
+ * #NeQuickG_library.set_satellite_position.
+ */
+typedef struct NeQuickG_links_st {
+  /** Number of links */
+  size_t count;
+  /** Month, January = 1, ..., December = 12 */
+  const uint8_t* pMonth;
+  /** UT time (hours) */
+  const double_t* pUTC;
+  /** Receiver geodetic longitude (degrees) */
+  const double_t* pReceiver_longitude_degree;
+  /** Receiver geodetic latitude (degrees) */
+  const double_t* pReceiver_latitude_degree;
+  /** Receiver geodetic height (m) */
+  const double_t* pReceiver_height_meters;
+  /** Satellite geodetic longitude (degrees) */
+  const double_t* pSatellite_longitude_degree;
+  /** Satellite geodetic latitude (degrees) */
+  const double_t* pSatellite_latitude_degree;
+  /** Satellite geodetic height (m) */
+  const double_t* pSatellite_height_meters;
+} NeQuickG_links_t;
+
+/** Batch of receiver-satellite links with the positions given as
+ * WGS-84 Earth-Centred Earth-Fixed (ECEF) coordinates,
+ * see #NeQuickG_links_t.
+ */
+typedef struct NeQuickG_links_ECEF_st {
+  /** Number of links */
+  size_t count;
+  /** Month, January = 1, ..., December = 12 */
+  const uint8_t* pMonth;
+  /** UT time (hours) */
+  const double_t* pUTC;
+  /** Receiver ECEF x coordinate (m) */
+  const double_t* pReceiver_x_meters;
+  /** Receiver ECEF y coordinate (m) */
+  const double_t* pReceiver_y_meters;
+  /** Receiver ECEF z coordinate (m) */
+  const double_t* pReceiver_z_meters;
+  /** Satellite ECEF x coordinate (m) */
+  const double_t* pSatellite_x_meters;
+  /** Satellite ECEF y coordinate (m) */
+  const double_t* pSatellite_y_meters;
+  /** Satellite ECEF z coordinate (m) */
+  const double_t* pSatellite_z_meters;
+} NeQuickG_links_ECEF_t;
+
+/** Satellite positions seen by one receiver at one epoch,
+ * given as a structure of arrays.
+ * Each array has #NeQuickG_satellites_t.count elements, the i-th satellite
+ * position is made of the i-th element of every array.<br>
+ * Positions follow the units and ranges of
+ * #NeQuickG_library.set_satellite_position.
+ */
+typedef struct NeQuickG_satellites_st {
+  /** Number of satellites */
+  size_t count;
+  /** Satellite geodetic longitude (degrees) */
+  const double_t* pLongitude_degree;
+  /** Satellite geodetic latitude (degrees) */
+  const double_t* pLatitude_degree;
+  /** Satellite geodetic height (m) */
+  const double_t* pHeight_meters;
+} NeQuickG_satellites_t;
+
+/** Locations given as a structure of arrays, e.g. the points of a grid.
+ * Each array has #NeQuickG_locations_t.count elements.<br>
+ * Coordinates follow the units and ranges of
+ * #NeQuickG_library.set_receiver_position.
+ */
+typedef struct NeQuickG_locations_st {
+  /** Number of locations */
+  size_t count;
+  /** Geodetic longitude (degrees) */
+  const double_t* pLongitude_degree;
+  /** Geodetic latitude (degrees) */
+  const double_t* pLatitude_degree;
+} NeQuickG_locations_t;
+
+/** Partial derivatives of the Slant Total Electron Content of a link,
+ * see #NeQuickG_library.get_total_electron_content_gradient
+ */
+typedef struct NeQuickG_TEC_gradient_st {
+  /** d(STEC)/d(receiver latitude, longitude, height):
+   * TECU/degree, TECU/degree, TECU/m
+   */
+  double_t receiver[NEQUICKG_WGS_84_ELLIPSOIDAL_COORDINATES_COUNT];
+  /** d(STEC)/d(ai<SUB>0</SUB>, ai<SUB>1</SUB>, ai<SUB>2</SUB>):
+   * TECU/sfu, TECU/(sfu/degree), TECU/(sfu/degree<SUP>2</SUP>)
+   */
+  double_t Az_coefficients[NEQUICKG_AZ_COEFFICIENTS_COUNT];
+} NeQuickG_TEC_gradient_t;
+
+/** Partial Slant Total Electron Content of a link: per height shell and
+ * along the ray, see #NeQuickG_library.get_total_electron_content_partial.<br>
+ * With n shell boundaries h<SUB>0</SUB> < ... < h<SUB>n-1</SUB> there are
+ * n + 1 shells: below h<SUB>0</SUB>, between h<SUB>0</SUB> and
+ * h<SUB>1</SUB>, ..., above h<SUB>n-1</SUB>.
+ */
+typedef struct NeQuickG_TEC_partial_st {
+  /** Number of shell boundaries,
+   * at most #NEQUICKG_TEC_SHELL_BOUNDARY_COUNT_MAX
+   */
+  size_t shell_boundary_count;
+  /** Geodetic heights of the shell boundaries (m), in ascending order */
+  const double_t* pShell_boundary_height_meters;
+  /** Output: shell_boundary_count + 1 elements,
+   * total electron content per shell in TECU
+   */
+  double_t* pShell_TEC;
+  /** Number of points of the cumulative profile, 0 for none,
+   * at most #NEQUICKG_TEC_CUMULATIVE_POINT_COUNT_MAX
+   */
+  size_t cumulative_point_count;
+  /** Distances along the ray from the receiver towards the satellite (m),
+   * in ascending order
+   */
+  const double_t* pCumulative_distance_meters;
+  /** Output: cumulative_point_count elements, total electron content in
+   * TECU between the receiver and each distance
+   */
+  double_t* pCumulative_TEC;
+} NeQuickG_TEC_partial_t;
+
+/** Carrier frequencies, e.g. #NEQUICKG_FREQUENCY_E1_HZ */
+typedef struct NeQuickG_frequencies_st {
+  /** Number of frequencies */
+  size_t count;
+  /** Carrier frequency (Hz) */
+  const double_t* pFrequency_Hz;
+} NeQuickG_frequencies_t;
+
+/** Settings of the integration of the electron density along the rays.
+ * The path is split at the two breakpoints (see F.2.3.3), each part is
+ * integrated with the tolerance of the height range it lies in.
+ */
+typedef struct NeQuickG_integration_settings_st {
+  /** #NEQUICKG_INTEGRATION_RECURSIVE, #NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE
+   * or #NEQUICKG_INTEGRATION_PATTERSON
+   */
+  uint8_t method;
+  /** First breakpoint height (km) */
+  double_t first_point_height_km;
+  /** Second breakpoint height (km), above the first one */
+  double_t second_point_height_km;
+  /** Tolerance below the first breakpoint */
+  double_t tolerance_below_first_point;
+  /** Tolerance above the first breakpoint */
+  double_t tolerance_above_first_point;
+  /** Maximum recursion level of the recursive methods,
+   * at most #NEQUICK_G_JRC_RECURSION_LIMIT_MAX */
+  size_t recursion_max;
+  /** Split the path below the first breakpoint at the E, F1 and F2
+   * layer peaks too, so that each part is smooth
+   */
+  bool split_at_layer_peaks;
+  /** Integrate the vertical rays semi-analytically with a fixed number of
+   * evaluations: closed form F2 bottomside, low order quadrature elsewhere.
+   * The breakpoints, tolerances and method are not used for those rays.
+   */
+  bool semi_analytic_vertical;
+  /** Budget of electron density evaluations per ray, 0 for no budget.
+   * A sub-interval is not refined if that would exceed the budget: its
+   * current estimate is kept, so the integration never goes over the
+   * budget and returns its best estimate, see
+   * #NeQuickG_library.get_integration_status.<br>
+   * Otherwise at least #NEQUICKG_INTEGRATION_EVALUATION_BUDGET_MIN.
+   */
+  size_t evaluation_max;
+  /** Number of anchors of the layer peaks along the slant rays, 0 to get the
+   * ionospheric profile at every node (the default).<br>
+   * Otherwise between #NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MIN and
+   * #NEQUICKG_INTEGRATION_PROFILE_ANCHOR_COUNT_MAX: the profile is computed
+   * only at the anchors, Chebyshev spaced along the integrated part of the
+   * ray, and the E, F1 and F2 peaks of each node are interpolated between
+   * them. The profile cache is not used then.<br>
+   * STEC relative error versus the exact profile, maximum / mean
+   * (the ionospheric profile is computed about 7 times less with 16 anchors).<br>
+   * On the links of the benchmark files only:
+   *  - 8 anchors: 2.2e-1 / 6.5e-3
+   *  - 16 anchors: 1.4e-2 / 6.6e-4
+   *  - 24 anchors: 9.7e-3 / 2.9e-4
+   *  - 32 anchors: 4.5e-3 / 1.2e-4
+   *
+   * On 8680 random rays above the horizon (any month, UT and Az,
+   * receivers up to 3 km, satellites between 19500 and 23500 km), the
+   * worst rays being the low elevation ones:
+   *  - 8 anchors: 1.3e+0 / 1.5e-2
+   *  - 16 anchors: 3.1e-1 / 1.5e-3
+   *  - 24 anchors: 9.3e-2 / 3.8e-4
+   *  - 32 anchors: 5.2e-2 / 1.7e-4
+   *
+   * The same rays above 10 degrees of elevation (7766 rays):
+   *  - 8 anchors: 7.2e-1 / 8.8e-3
+   *  - 16 anchors: 1.1e-1 / 8.3e-4
+   *  - 24 anchors: 9.3e-2 / 2.4e-4
+   *  - 32 anchors: 1.6e-2 / 1.1e-4
+   */
+  size_t profile_anchor_count;
+} NeQuickG_integration_settings_t;
+
+/** Status of the last Total Electron Content integration of a handle */
+typedef struct NeQuickG_integration_status_st {
+  /** Number of electron density evaluations */
+  size_t evaluation_count;
+  /** The evaluation budget stopped the refinement of at least one
+   * sub-interval, the result may not meet the tolerances
+   */
+  bool is_budget_exhausted;
+  /** Sum of the error estimates of the accepted sub-intervals (TECU),
+   * 0 for a semi-analytic vertical integration
+   */
+  double_t error_estimate_TECU;
+} NeQuickG_integration_status_t;
+
+/** Statistics of the Total Electron Content integrations of a handle
+ * since it was initialized or reset, batches included
+ */
+typedef struct NeQuickG_integration_statistics_st {
+  /** Number of integrations */
+  size_t integration_count;
+  /** Number of integrations stopped by the evaluation budget */
+  size_t budget_exhausted_count;
+  /** Total number of electron density evaluations */
+  size_t evaluation_count;
+  /** Largest number of electron density evaluations of an integration */
+  size_t evaluation_count_max;
+} NeQuickG_integration_statistics_t;
+
+/** Statistics of the profile cache of a handle since it was set,
+ * see #NeQuickG_library.set_profile_cache
+ */
+typedef struct NeQuickG_profile_cache_statistics_st {
+  /** Number of nodes whose layer peaks were in the cache */
+  size_t hit_count;
+  /** Number of nodes whose layer peaks were computed */
+  size_t miss_count;
+  /** Number of entries replaced */
+  size_t eviction_count;
+} NeQuickG_profile_cache_statistics_t;
+
+/** Statistics of the Fourier coefficient cache of a handle since it was set,
+ * see #NeQuickG_library.set_fourier_cache
+ */
+typedef struct NeQuickG_fourier_cache_statistics_st {
+  /** Number of changes of month or UT served by the cache */
+  size_t hit_count;
+  /** Number of changes of month or UT computed */
+  size_t miss_count;
+  /** Number of entries replaced */
+  size_t eviction_count;
+} NeQuickG_fourier_cache_statistics_t;
+
 /** NequickG JRC API */
 struct NeQuickG_library {
   /** NequickG JRC library initialization
    *
    * the library context is allocated in the heap<br>
-   * the modip file is loaded in the library context
+   * the modip file is loaded in the library context, the CCIR file of a month
+   * on the first query of that month
    *
    * @param[in] pModip_file a file with the table grid of MODIP values
    *  versus geographical location provided together with the NeQuick G.
@@ -134,12 +530,78 @@ struct NeQuickG_library {
     NeQuickG_handle* const pHandle);
 
   /** NequickG JRC library uninitialization.
-   *  Free resources allocated by init.
+   *  Free resources allocated by init.<br>
+   *  A session acquired from a pool is not freed: the call records
+   *  NEQUICK_ERROR_CODE_BAD_SESSION, see #NeQuickG_library.pool_release.
    *
    * @param[in] NeQuickG_handle NequickG JRC handle
    */
   void (*close)(const NeQuickG_handle);
 
+  /** NequickG JRC shared model initialization
+   *
+   * the model is allocated in the heap<br>
+   * the modip file and the CCIR files of the 12 months are loaded in the model
+   * (about 270 KB), the sessions opened on it refer to them and switch months
+   * without file I/O
+   *
+   * @param[in] pModip_file see #NeQuickG_library.init
+   * @param[in] pCCIR_directory see #NeQuickG_library.init
+   * @param[out] pModel on success contains a valid shared model handle,
+   *  on error is set to NEQUICKG_INVALID_HANDLE
+   *
+   * @return on success NEQUICK_OK
+   */
+#ifdef FTR_MODIP_CCIR_AS_CONSTANTS
+#define model_init(pModip_file, pCCIR_directory, pModel) \
+  model_init(pModel)
+#endif
+
+  int32_t (*model_init)(
+#ifndef FTR_MODIP_CCIR_AS_CONSTANTS
+    const char* const pModip_file,
+    const char* const pCCIR_directory,
+#endif // !FTR_MODIP_CCIR_AS_CONSTANTS
+    NeQuickG_model_handle* const pModel);
+
+  /** NequickG JRC shared model uninitialization.
+   *  Free resources allocated by model_init.
+   *  All the sessions opened on the model must be closed before.
+   *
+   * @param[in] NeQuickG_model_handle shared model handle
+   */
+  void (*model_close)(const NeQuickG_model_handle);
+
+  /** Opens a session on a shared model
+   *
+   * the session context is allocated in the heap,
+   * the model data are not copied.
+   *
+   * @param[in] NeQuickG_model_chandle shared model handle
+   * @param[out] pHandle on success contains a valid NequickG JRC handle,
+   *  on error is set to NEQUICKG_INVALID_HANDLE.
+   *  It must be freed using #NeQuickG_library.close
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*session_init)(
+    NeQuickG_model_chandle,
+    NeQuickG_handle* const pHandle);
+
+  /** Clears the per-query state of a handle: time, positions and
+   *  solar activity coefficients must be set again, the integration
+   *  method is set back to #NEQUICKG_INTEGRATION_RECURSIVE.<br>
+   *  The loaded model and the lazy caches are kept. The profile and
+   *  Fourier caches are emptied and their statistics cleared, they keep
+   *  their settings and their entries: nothing is allocated or freed,
+   *  resetting is much cheaper than closing and opening a handle.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*reset)(const NeQuickG_handle);
+
   /** Sets solar activity coefficients
    *  The three coefficients, ai<SUB>0</SUB>,  ai<SUB>1</SUB> and  ai<SUB>2</SUB> are transmitted to the users in
    *  the Galileo navigation broadcast message.
@@ -236,6 +698,569 @@ struct NeQuickG_library {
     const NeQuickG_handle,
     double_t* const TEC);
 
+  /** Gets the Slant Total Electron Content in TECU of a link tracked
+   *  over consecutive epochs, see #NeQuickG_library.get_total_electron_content.<br>
+   *  The session remembers the final sub-intervals of the Kronrod
+   *  G<SUB>7</SUB>-K<SUB>15</SUB> integration of the last
+   *  32 links, by link ID. The next epoch of the link starts from them,
+   *  scaled to the new geometry, merging the sub-intervals with a very small
+   *  error and splitting the ones above the tolerance, instead of starting
+   *  from the whole path. A segment whose end points moved by more than 10%
+   *  of its length starts from scratch.<br>
+   *  Every sub-interval meets the tolerance of the integration settings, so the
+   *  result is within the same tolerance as #NeQuickG_library.get_total_electron_content
+   *  but not bit for bit the same. The first epoch of a link is the same.<br>
+   *  Only #NEQUICKG_INTEGRATION_RECURSIVE uses the meshes; they are forgotten
+   *  when the integration settings change and on #NeQuickG_library.reset.
+   *  The meshes (about 58 KB) are allocated at the first call of the session.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] link_id any ID of the receiver-satellite link, e.g. receiver and satellite numbers
+   * @param[out] TEC ouput parameter total electron content in TECU (10<SUP>16</SUP> electrons/m<SUP>2</SUP>)
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_total_electron_content_link)(
+    const NeQuickG_handle,
+    const uint32_t link_id,
+    double_t* const TEC);
+
+  /** Gets the Slant Total Electron Content in TECU and its partial
+   *  derivatives with respect to the receiver position and the
+   *  solar activity coefficients, e.g. for a Kalman filter.<br>
+   *  The STEC is integrated once with #NEQUICKG_INTEGRATION_RECURSIVE and the
+   *  tolerances of the handle. The electron density is then evaluated once
+   *  more at the nodes of the final sub-intervals of that integration, with
+   *  its analytic derivatives with respect to Az and to the position of the
+   *  node, and the derivatives of the STEC are summed from them: about twice
+   *  the cost of an integration, counted as a single integration in the
+   *  statistics of the handle (#NeQuickG_library.get_integration_statistics).
+   *  The derivatives with respect to ai<SUB>0</SUB>, ai<SUB>1</SUB> and
+   *  ai<SUB>2</SUB> are the one in Az chained to them; they are zero when
+   *  Az does not depend on them (default Az, Az out of its range).<br>
+   *  The receiver derivatives include the change of Az with the receiver MODIP.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] TEC ouput parameter total electron content in TECU (10<SUP>16</SUP> electrons/m<SUP>2</SUP>)
+   * @param[out] pGradient partial derivatives of the total electron content
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_total_electron_content_gradient)(
+    const NeQuickG_handle,
+    double_t* const TEC,
+    NeQuickG_TEC_gradient_t* const pGradient);
+
+  /** Gets the Slant Total Electron Content in TECU split into height shells,
+   *  e.g. below 1000 km, between 1000 and 2000 km and above 2000 km for the
+   *  plasmasphere, and optionally its cumulative profile along the ray.<br>
+   *  All of them come from a single integration: the path is also split at
+   *  the shell boundaries and at the points of the cumulative profile, and
+   *  each part of the path is added to the shell and to the points above it.
+   *  The shells add up to the total. With shell boundaries at the
+   *  breakpoints of the integration settings (1000 and 2000 km by default)
+   *  and no cumulative profile the total is the same as
+   *  #NeQuickG_library.get_total_electron_content, otherwise it is within
+   *  the integration tolerances.<br>
+   *  Every extra part of the path costs at least one
+   *  G<SUB>7</SUB>-K<SUB>15</SUB> rule (15 evaluations), even beyond the
+   *  evaluation budget of the integration settings.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in, out] pPartial shells and cumulative profile
+   * @param[out] TEC ouput parameter total electron content in TECU (10<SUP>16</SUP> electrons/m<SUP>2</SUP>)
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_total_electron_content_partial)(
+    const NeQuickG_handle,
+    const NeQuickG_TEC_partial_t* const pPartial,
+    double_t* const TEC);
+
+  /** Gets the Slant Total Electron Content in TECU for a batch of links.
+   *  Uses the solar activity coefficients set in the handle
+   *  (#NeQuickG_library.set_solar_activity_coefficients).<br>
+   *  The receiver MODIP and Effective Ionisation Level are reused while
+   *  consecutive links share the same receiver, and the Fourier coefficients
+   *  while they share the same epoch, so sorting the links by epoch and
+   *  receiver amortizes the setup.<br>
+   *  The result is the same as calling #NeQuickG_library.get_total_electron_content
+   *  for each link.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] pLinks batch of links
+   * @param[out] pTEC array of pLinks->count elements, total electron content per link in TECU,
+   *  set to 0 for the links that failed
+   * @param[out] pStatus array of pLinks->count elements, NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+   *
+   * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+   *  that failed, its error code is the last error (#NeQuickG_library.get_last_error)
+   */
+  int32_t (*get_total_electron_content_batch)(
+    const NeQuickG_handle,
+    const NeQuickG_links_t* const pLinks,
+    double_t* const pTEC,
+    int32_t* const pStatus);
+
+  /** Gets the Slant Total Electron Content in TECU for a batch of links
+   *  given in ECEF coordinates, see #NeQuickG_library.get_total_electron_content_batch.<br>
+   *  The positions are converted to geodetic coordinates by the library,
+   *  the sinus and cosinus of the latitude and longitude come out of the
+   *  conversion instead of being recomputed from the angles.
+   *  The result matches the batch of the same links in geodetic coordinates
+   *  within the accuracy of the conversion.<br>
+   *  A link with non-finite coordinates or a position below the Earth
+   *  surface fails: its status is NEQUICK_ERROR_CODE_BAD_POSITION,
+   *  with the source NEQUICK_ERROR_SRC_INPUT_DATA.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] pLinks batch of links in ECEF coordinates
+   * @param[out] pTEC array of pLinks->count elements, total electron content per link in TECU,
+   *  set to 0 for the links that failed
+   * @param[out] pStatus array of pLinks->count elements, NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+   *
+   * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+   *  that failed, its error code is the last error (#NeQuickG_library.get_last_error)
+   */
+  int32_t (*get_total_electron_content_batch_ECEF)(
+    const NeQuickG_handle,
+    const NeQuickG_links_ECEF_t* const pLinks,
+    double_t* const pTEC,
+    int32_t* const pStatus);
+
+  /** Gets the ionospheric group delay in meters of a batch of links
+   *  at several carrier frequencies.
+   *  The Slant Total Electron Content of each link is computed as in
+   *  #NeQuickG_library.get_total_electron_content_batch and written
+   *  straight away as a group delay per frequency:<br>
+   *  delay = 40.3 * STEC / f<SUP>2</SUP>, with STEC in electrons/m<SUP>2</SUP> and f in Hz.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] pLinks batch of links
+   * @param[in] pFrequencies carrier frequencies
+   * @param[out] pDelay array of pLinks->count*pFrequencies->count elements,
+   *  group delay in meters, link after link:
+   *  pDelay[i*pFrequencies->count + j] is the delay of link i at frequency j.
+   *  Set to 0 for the links that failed
+   * @param[out] pStatus array of pLinks->count elements, NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+   *
+   * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link
+   *  that failed, its error code is the last error (#NeQuickG_library.get_last_error)
+   */
+  int32_t (*get_group_delay_batch)(
+    const NeQuickG_handle,
+    const NeQuickG_links_t* const pLinks,
+    const NeQuickG_frequencies_t* const pFrequencies,
+    double_t* const pDelay,
+    int32_t* const pStatus);
+
+  /** Gets the Slant Total Electron Content in TECU from one receiver
+   *  to every satellite tracked at one epoch.
+   *  Uses the solar activity coefficients, time and receiver position
+   *  set in the handle (#NeQuickG_library.set_solar_activity_coefficients,
+   *  #NeQuickG_library.set_time and #NeQuickG_library.set_receiver_position).<br>
+   *  The receiver MODIP, Effective Ionisation Level, Fourier coefficients
+   *  and solar declination are computed once for all the satellites.<br>
+   *  The result is the same as calling #NeQuickG_library.set_satellite_position
+   *  and #NeQuickG_library.get_total_electron_content for each satellite.
+   *  On return the satellite position of the handle is the last one evaluated.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] pSatellites satellite positions
+   * @param[out] pTEC array of pSatellites->count elements, total electron content per satellite in TECU,
+   *  set to 0 for the satellites that failed
+   * @param[out] pStatus array of pSatellites->count elements, NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per satellite
+   *
+   * @return NEQUICK_OK if every satellite succeeded, otherwise the error source of the first satellite
+   *  that failed, its error code is the last error (#NeQuickG_library.get_last_error)
+   */
+  int32_t (*get_total_electron_content_epoch)(
+    const NeQuickG_handle,
+    const NeQuickG_satellites_t* const pSatellites,
+    double_t* const pTEC,
+    int32_t* const pStatus);
+
+  /** Gets the Vertical Total Electron Content in TECU above a location.
+   *  Uses the solar activity coefficients and time set in the handle.
+   *  The Effective Ionisation Level is the one at the location.<br>
+   *  The vertical profile is integrated directly, without the ray geometry:
+   *  the result is the same as #NeQuickG_library.get_total_electron_content
+   *  with the receiver at the bottom height and the satellite at the top height
+   *  of the location.
+   *  On return the receiver and satellite positions of the handle are the
+   *  bottom and the top of the vertical ray.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] longitude_degree Geodetic longitude (degrees)
+   * @param[in] latitude_degree Geodetic latitude (degrees) range accepted [-90, +90]
+   * @param[in] bottom_height_meters Geodetic height of the bottom of the ray (m)
+   * @param[in] top_height_meters Geodetic height of the top of the ray (m), above the bottom height
+   * @param[out] pTEC total electron content in TECU
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_vertical_total_electron_content)(
+    const NeQuickG_handle,
+    const double_t longitude_degree,
+    const double_t latitude_degree,
+    const double_t bottom_height_meters,
+    const double_t top_height_meters,
+    double_t* const pTEC);
+
+  /** Gets the Vertical Total Electron Content in TECU above many locations,
+   *  see #NeQuickG_library.get_vertical_total_electron_content.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] pLocations locations
+   * @param[in] bottom_height_meters Geodetic height of the bottom of the rays (m)
+   * @param[in] top_height_meters Geodetic height of the top of the rays (m), above the bottom height
+   * @param[out] pTEC array of pLocations->count elements, total electron content per location in TECU,
+   *  set to 0 for the locations that failed
+   * @param[out] pStatus array of pLocations->count elements, NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per location
+   *
+   * @return NEQUICK_OK if every location succeeded, otherwise the error source of the first location
+   *  that failed, its error code is the last error (#NeQuickG_library.get_last_error)
+   */
+  int32_t (*get_vertical_total_electron_content_batch)(
+    const NeQuickG_handle,
+    const NeQuickG_locations_t* const pLocations,
+    const double_t bottom_height_meters,
+    const double_t top_height_meters,
+    double_t* const pTEC,
+    int32_t* const pStatus);
+
+  /** Gets the electron density profile N<SUB>e</SUB>(h) above a location.
+   *  Uses the solar activity coefficients and time set in the handle.
+   *  The Effective Ionisation Level is the one at the location.<br>
+   *  The ionospheric profile is computed once for the location and then
+   *  evaluated at every height, e.g. to compare with ionosonde profiles.
+   *  On return the receiver position of the handle is the location
+   *  at height 0.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] longitude_degree Geodetic longitude (degrees)
+   * @param[in] latitude_degree Geodetic latitude (degrees) range accepted [-90, +90]
+   * @param[in] pHeight_meters array of height_count elements, geodetic heights (m)
+   * @param[in] height_count number of heights
+   * @param[out] pElectron_density array of height_count elements,
+   *  electron density per height in electrons/m<SUP>3</SUP>
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_electron_density_profile)(
+    const NeQuickG_handle,
+    const double_t longitude_degree,
+    const double_t latitude_degree,
+    const double_t* const pHeight_meters,
+    const size_t height_count,
+    double_t* const pElectron_density);
+
+  /** Sets the method used to integrate the electron density along the rays
+   *  by every Total Electron Content query of the handle.<br>
+   *  #NEQUICKG_INTEGRATION_RECURSIVE (default) is the method of the specification.
+   *  #NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE refines the sub-interval with the
+   *  largest error estimate first and stops when the total error estimate meets
+   *  the tolerance: it needs fewer electron density evaluations, the results
+   *  agree with the default method within the tolerances of the specification
+   *  but not bit-for-bit.
+   *  #NEQUICKG_INTEGRATION_PATTERSON keeps the densities already evaluated in a
+   *  segment and adds nodes (15, 31, then 63 points) before splitting it.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] method #NEQUICKG_INTEGRATION_RECURSIVE, #NEQUICKG_INTEGRATION_GLOBAL_ADAPTIVE
+   *  or #NEQUICKG_INTEGRATION_PATTERSON
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*set_integration_method)(
+    const NeQuickG_handle,
+    const uint8_t method);
+
+  /** Gets the number of electron density evaluations of the last
+   *  Total Electron Content integration of the handle
+   *  (for a batch, the last link), e.g. to compare the integration methods.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] pEvaluation_count number of electron density evaluations
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_evaluation_count)(
+    const NeQuickG_handle,
+    size_t* const pEvaluation_count);
+
+  /** Gets the status of the last Total Electron Content integration
+   *  of the handle (for a batch, the last link): whether the evaluation
+   *  budget was hit and the error estimate of the result.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] pStatus integration status
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_integration_status)(
+    const NeQuickG_handle,
+    NeQuickG_integration_status_t* const pStatus);
+
+  /** Gets the integration statistics of the handle, e.g. how often the
+   *  evaluation budget stops the refinement. They are cleared by
+   *  #NeQuickG_library.reset.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] pStatistics integration statistics
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_integration_statistics)(
+    const NeQuickG_handle,
+    NeQuickG_integration_statistics_t* const pStatistics);
+
+  /** Gets the integration settings of a preset,
+   *  e.g. to adjust them before #NeQuickG_library.set_integration_settings.<br>
+   *  #NEQUICKG_INTEGRATION_PRESET_SPECIFICATION are the settings of a new or
+   *  reset handle.
+   *
+   * @param[in] preset #NEQUICKG_INTEGRATION_PRESET_SPECIFICATION,
+   *  #NEQUICKG_INTEGRATION_PRESET_NAVIGATION or #NEQUICKG_INTEGRATION_PRESET_REFERENCE
+   * @param[out] pSettings integration settings
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_integration_preset)(
+    const uint8_t preset,
+    NeQuickG_integration_settings_t* const pSettings);
+
+  /** Sets the integration settings used by every Total Electron Content
+   *  query of the handle. The settings are checked as a whole: on error
+   *  the handle keeps its previous settings.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] pSettings integration settings
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*set_integration_settings)(
+    const NeQuickG_handle,
+    const NeQuickG_integration_settings_t* const pSettings);
+
+  /** Gets the integration settings of the handle
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] pSettings integration settings
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_integration_settings)(
+    const NeQuickG_handle,
+    NeQuickG_integration_settings_t* const pSettings);
+
+  /** Enables or disables the profile cache of the handle (disabled by
+   *  default, #NeQuickG_library.reset empties it).<br>
+   *  Along a slant ray every integration node needs the ionospheric
+   *  profile at its location: MODIP, critical frequencies, Legendre
+   *  expansion, layer peak heights, thicknesses and amplitudes. The cache
+   *  keeps the layer peaks of 4 locations per set, for the time and the
+   *  Effective Ionisation Level they were computed with, and replaces the
+   *  least recently used ones of a set.
+   *  - with a quantum of 0 a location is an exact node position: only the
+   *    nodes of a ray queried again hit the cache, e.g. the same link for
+   *    another frequency, and the results are the same bit for bit.<br>
+   *  - otherwise a location is a corner of a grid of quantum x quantum
+   *    degrees and the layer peaks of a node are interpolated bilinearly
+   *    between the four corners of its cell.
+   *    The nodes of neighbouring sub-intervals and rays hit the cache; the
+   *    results depend on the quantum (0.01 degrees is about 1 km) but not on
+   *    the order of the queries.
+   *
+   *  The cache is emptied and its statistics cleared. Its entries (about
+   *  180 bytes per location) are allocated here, on the heap, unless the set
+   *  count is the same, and freed when it is disabled and by
+   *  #NeQuickG_library.close.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] is_enabled enable the cache?
+   * @param[in] quantum_degree cell size (degrees) between 0 and
+   *  #NEQUICKG_PROFILE_CACHE_QUANTUM_MAX_DEGREE
+   * @param[in] set_count number of sets between 1 and
+   *  #NEQUICKG_PROFILE_CACHE_SET_COUNT_MAX, e.g.
+   *  #NEQUICKG_PROFILE_CACHE_SET_COUNT_DEFAULT; ignored to disable the cache
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*set_profile_cache)(
+    const NeQuickG_handle,
+    const bool is_enabled,
+    const double_t quantum_degree,
+    const size_t set_count);
+
+  /** Gets the statistics of the profile cache of the handle
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] pStatistics profile cache statistics
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_profile_cache_statistics)(
+    const NeQuickG_handle,
+    NeQuickG_profile_cache_statistics_t* const pStatistics);
+
+  /** Sets the number of entries of the Fourier coefficient cache of the
+   *  handle, 0 to disable it (the default, #NeQuickG_library.reset
+   *  empties it).<br>
+   *  The foF2 and M(3000)F2 Fourier coefficients (CF2 and Cm3, see
+   *  2.5.5.3.2) are summed for the month and the UT, for the low and high
+   *  solar activity conditions, then interpolated for the Effective
+   *  Ionisation Level Az. The handle always keeps the ones of its last
+   *  query; when a batch interleaves epochs, each change of month or UT
+   *  redoes the Fourier series. The cache keeps the coefficients of the
+   *  last entry_count (month, UT), the least recently used are replaced.
+   *  The results are the same as without the cache.
+   *
+   *  The cache is emptied and its statistics cleared. Its entries are
+   *  allocated here, on the heap, unless the number of entries is the same,
+   *  and freed by 0 and #NeQuickG_library.close.
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[in] entry_count number of entries, at most
+   *  #NEQUICKG_FOURIER_CACHE_ENTRY_COUNT_MAX
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*set_fourier_cache)(
+    const NeQuickG_handle,
+    const size_t entry_count);
+
+  /** Gets the statistics of the Fourier coefficient cache of the handle
+   *
+   * @param[in] NeQuickG_handle NequickG JRC handle
+   * @param[out] pStatistics Fourier coefficient cache statistics
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*get_fourier_cache_statistics)(
+    const NeQuickG_handle,
+    NeQuickG_fourier_cache_statistics_t* const pStatistics);
+
+  /** Creates a parallel executor: a pool of threads, each one with its own
+   *  session opened on the shared model.
+   *  The threads wait for work until the executor is closed.<br>
+   *  The executor is based on POSIX threads, with MSVC it returns
+   *  NEQUICK_ERROR_CODE_NOT_SUPPORTED.
+   *
+   * @param[in] NeQuickG_model_chandle shared model handle, it must outlive the executor
+   * @param[in] thread_count number of threads, at least 1
+   * @param[out] pExecutor on success contains a valid executor handle,
+   *  on error is set to NEQUICKG_INVALID_HANDLE.
+   *  It must be freed using #NeQuickG_library.executor_close
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*executor_init)(
+    NeQuickG_model_chandle,
+    size_t thread_count,
+    NeQuickG_executor_handle* const pExecutor);
+
+  /** Stops the threads and frees the resources allocated by executor_init.
+   *
+   * @param[in] NeQuickG_executor_handle executor handle
+   */
+  void (*executor_close)(const NeQuickG_executor_handle);
+
+  /** Gets the Slant Total Electron Content in TECU for a batch of links,
+   *  evaluated in parallel by the executor threads.<br>
+   *  The batch is split in chunks of consecutive links that the threads
+   *  steal from each other, so that rays of very different cost keep
+   *  all the threads busy. The call returns when the whole batch
+   *  is evaluated, the results are in the input order and are the same as
+   *  #NeQuickG_library.get_total_electron_content_batch.<br>
+   *  An executor evaluates one batch at a time: it must not be called
+   *  concurrently from different threads.<br>
+   *  The errors are raised in the executor threads; the error of the first
+   *  link that failed is recorded again as the last error of the calling
+   *  thread (#NeQuickG_library.get_last_error).
+   *
+   * @param[in] NeQuickG_executor_handle executor handle
+   * @param[in] pAz solar activity coefficients,
+   *  see #NeQuickG_library.set_solar_activity_coefficients
+   * @param[in] az_size Size of array pAz
+   * @param[in] pLinks batch of links
+   * @param[out] pTEC array of pLinks->count elements, total electron content per link in TECU,
+   *  set to 0 for the links that failed
+   * @param[out] pStatus array of pLinks->count elements, NEQUICK_OK or error code (NEQUICK_ERROR_CODE_*) per link
+   *
+   * @return NEQUICK_OK if every link succeeded, otherwise the error source of the first link that failed
+   */
+  int32_t (*executor_get_total_electron_content_batch)(
+    const NeQuickG_executor_handle,
+    const double_t* const pAz,
+    size_t az_size,
+    const NeQuickG_links_t* const pLinks,
+    double_t* const pTEC,
+    int32_t* const pStatus);
+
+  /** Creates a pool of sessions opened on a shared model.
+   *  All the sessions are allocated here.<br>
+   *  The pool is based on POSIX threads, with MSVC it returns
+   *  NEQUICK_ERROR_CODE_NOT_SUPPORTED.
+   *
+   * @param[in] NeQuickG_model_chandle shared model handle, it must outlive the pool
+   * @param[in] session_count number of sessions, at least 1
+   * @param[out] pPool on success contains a valid pool handle,
+   *  on error is set to NEQUICKG_INVALID_HANDLE.
+   *  It must be freed using #NeQuickG_library.pool_close
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*pool_init)(
+    NeQuickG_model_chandle,
+    size_t session_count,
+    NeQuickG_pool_handle* const pPool);
+
+  /** Frees the resources allocated by pool_init.
+   *  Every session acquired from the pool must be released before.
+   *
+   * @param[in] NeQuickG_pool_handle pool handle
+   */
+  void (*pool_close)(const NeQuickG_pool_handle);
+
+  /** Takes a free session from the pool, it can be called from any thread.<br>
+   *  The session is a regular NequickG JRC handle that belongs to the caller
+   *  until it is released. #NeQuickG_library.close rejects it.
+   *
+   * @param[in] NeQuickG_pool_handle pool handle
+   * @param[out] pHandle on success contains a session of the pool,
+   *  on error is set to NEQUICKG_INVALID_HANDLE.
+   *
+   * @return on success NEQUICK_OK, an error if every session is acquired
+   */
+  int32_t (*pool_acquire)(
+    const NeQuickG_pool_handle,
+    NeQuickG_handle* const pHandle);
+
+  /** Resets a session (#NeQuickG_library.reset) and gives it back to the pool,
+   *  it can be called from any thread.
+   *
+   * @param[in] NeQuickG_pool_handle pool handle
+   * @param[in] NeQuickG_handle a session acquired from the pool
+   *
+   * @return on success NEQUICK_OK
+   */
+  int32_t (*pool_release)(
+    const NeQuickG_pool_handle,
+    const NeQuickG_handle);
+
+  /** Gets the last error raised by the library in the calling thread.
+   *  The error state is thread-local, it is not reset by successful calls.
+   *
+   * @param[out] pError_code if not NULL, set to the error code of the last error
+   *  (see NeQuickG_JRC_error.h) or to NEQUICK_OK if no error was raised
+   *
+   * @return the error source of the last error (the value returned by the failing call)
+   *  or NEQUICK_OK if no error was raised
+   */
+  int32_t (*get_last_error)(
+    int32_t* const pError_code);
+
   /** Input data set to std output
    *
    * @param[in] NeQuickG_chandle NequickG JRC handle
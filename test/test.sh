@@ -18,3 +18,28 @@ if [ $? != "0" ]
 fi
 echo "success"
 
+echo "Integration methods comparison (electron density evaluations)..."
+if [ -z "${FTR_MODIP_CCIR_AS_CONSTANTS}" ]
+  then
+  files_option="${modip_file} ${ccir_folder}"
+fi
+for benchmark_file in ${benchmark_folder}*
+do
+  echo -n "$(basename ${benchmark_file}): "
+  ${nequick_tool_path} ${files_option} -i ${benchmark_file} | tail -1
+  if [ ${PIPESTATUS[0]} != "0" ]
+    then
+    exit -1;
+  fi
+done
+
+echo -n "Thread stress test..."
+for benchmark_file in ${benchmark_folder}*
+do
+  ${nequick_tool_path} ${files_option} -t 4 ${benchmark_file} >/dev/null
+  if [ $? != "0" ]
+    then
+    exit -1;
+  fi
+done
+echo "success"